@@ -0,0 +1,134 @@
+"""
+Local stand-in for the server receiving the performance reports, for testing the uploads without
+the web service. Prints every received sample and can append them to a CSV file.
+
+    python3 perf_report_server.py [--port 8080] [--csv samples.csv]
+
+Then point the emulator at it in the [WebService] section of the config:
+
+    enable_perf_reports = 1
+    perf_report_url = http://localhost:8080
+
+Requires the zstandard module (pip install zstandard).
+"""
+
+import argparse
+import csv
+import json
+import struct
+import sys
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+
+try:
+    import zstandard
+except ImportError:
+    sys.exit("The zstandard module is required: pip install zstandard")
+
+REPORT_PATH = "/telemetry/performance"
+RECORD_MAGIC = b"CPRF"
+RECORD_VERSION = 1
+
+# Matches Core::PerfReporter::RecordHeader and Core::PerfReporter::Sample
+HEADER_FORMAT = struct.Struct("<4sIQQ40sII")
+SAMPLE_FORMAT = struct.Struct("<QIIffffffIII4x")
+SAMPLE_FIELDS = ("timestamp", "system_frames", "game_frames", "interval", "emulation_speed",
+                 "frametime_p50", "frametime_p90", "frametime_p99", "frametime_max",
+                 "shaders_compiled", "shader_cache_hits", "shader_cache_misses")
+
+
+def parse_record(data):
+    record = zstandard.ZstdDecompressor().decompress(data, max_output_size=16 * 1024 * 1024)
+    (magic, version, telemetry_id, title_id, revision, sample_count,
+     sample_size) = HEADER_FORMAT.unpack_from(record)
+    if magic != RECORD_MAGIC or version != RECORD_VERSION:
+        raise ValueError("unknown record {} version {}".format(magic, version))
+    if sample_size < SAMPLE_FORMAT.size:
+        raise ValueError("samples too small: {} bytes".format(sample_size))
+    if len(record) < HEADER_FORMAT.size + sample_count * sample_size:
+        raise ValueError("truncated record")
+
+    header = {
+        "telemetry_id": "{:016X}".format(telemetry_id),
+        "title_id": "{:016X}".format(title_id),
+        "git_revision": revision.rstrip(b"\0").decode("ascii", "replace"),
+    }
+    samples = []
+    for i in range(sample_count):
+        values = SAMPLE_FORMAT.unpack_from(record, HEADER_FORMAT.size + i * sample_size)
+        samples.append(dict(zip(SAMPLE_FIELDS, values)))
+    return header, samples
+
+
+class ReportHandler(BaseHTTPRequestHandler):
+    csv_file = None
+    csv_writer = None
+
+    def reply(self, status, body):
+        content = json.dumps(body).encode()
+        self.send_response(status)
+        self.send_header("Content-Type", "application/json")
+        self.send_header("Content-Length", str(len(content)))
+        self.end_headers()
+        self.wfile.write(content)
+
+    def do_POST(self):
+        if self.path != REPORT_PATH:
+            self.reply(404, {"error": "unknown path"})
+            return
+
+        data = self.rfile.read(int(self.headers.get("Content-Length", 0)))
+        try:
+            header, samples = parse_record(data)
+        except (ValueError, struct.error, zstandard.ZstdError) as error:
+            print("Rejected report: {}".format(error))
+            self.reply(400, {"error": str(error)})
+            return
+
+        print("Report from {telemetry_id} for title {title_id} at {git_revision}".format(**header))
+        for sample in samples:
+            print("  {:>6.1f}% speed {:>5} frames  frametime p50 {:>6.2f} p90 {:>6.2f} "
+                  "p99 {:>6.2f} max {:>6.2f} ms  shaders {:>4} compiled {:>7} hits {:>5} misses"
+                  .format(sample["emulation_speed"] * 100, sample["system_frames"],
+                          sample["frametime_p50"], sample["frametime_p90"],
+                          sample["frametime_p99"], sample["frametime_max"],
+                          sample["shaders_compiled"], sample["shader_cache_hits"],
+                          sample["shader_cache_misses"]))
+            if self.csv_writer is not None:
+                self.csv_writer.writerow({**header, **sample})
+        if self.csv_file is not None:
+            self.csv_file.flush()
+        self.reply(200, {"accepted": len(samples)})
+
+    def log_message(self, format, *args):
+        pass
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--port", type=int, default=8080)
+    parser.add_argument("--csv", help="file the received samples are appended to")
+    args = parser.parse_args()
+
+    csv_file = None
+    if args.csv:
+        csv_file = open(args.csv, "a", newline="")
+        ReportHandler.csv_file = csv_file
+        ReportHandler.csv_writer = csv.DictWriter(
+            csv_file, fieldnames=("telemetry_id", "title_id", "git_revision") + SAMPLE_FIELDS)
+        if csv_file.tell() == 0:
+            ReportHandler.csv_writer.writeheader()
+
+    server = ThreadingHTTPServer(("", args.port), ReportHandler)
+    print("Listening on port {}".format(args.port))
+    try:
+        server.serve_forever()
+    except KeyboardInterrupt:
+        pass
+    finally:
+        if csv_file is not None:
+            csv_file.close()
+
+
+if "__main__" == __name__:
+    main()
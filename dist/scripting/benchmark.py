@@ -0,0 +1,66 @@
+"""
+Measures the throughput and latency of the scripting RPC server. A game has to be running.
+
+    python3 benchmark.py [--address 0x100000] [--ranges 256] [--size 4] [--iterations 200]
+"""
+
+import argparse
+import time
+
+from citra import Citra, MAX_REQUEST_DATA_SIZE
+
+
+def report(name, latencies, total_bytes):
+    latencies = sorted(latencies)
+    elapsed = sum(latencies)
+    print("{:<24} {:>9.1f} req/s {:>9.2f} MiB/s  avg {:>7.3f} ms  p99 {:>7.3f} ms".format(
+        name, len(latencies) / elapsed, total_bytes / elapsed / (1024 * 1024),
+        elapsed / len(latencies) * 1000, latencies[int(len(latencies) * 0.99)] * 1000))
+
+
+def measure(function, iterations):
+    latencies = []
+    for _ in range(iterations):
+        start = time.perf_counter()
+        function()
+        latencies.append(time.perf_counter() - start)
+    return latencies
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--address", type=lambda x: int(x, 0), default=0x100000)
+    parser.add_argument("--ranges", type=int, default=256, help="number of addresses to poll")
+    parser.add_argument("--size", type=int, default=4, help="size of every polled range")
+    parser.add_argument("--iterations", type=int, default=200)
+    args = parser.parse_args()
+
+    c = Citra()
+    ranges = [(args.address + i * args.size, args.size) for i in range(args.ranges)]
+    polled_bytes = args.ranges * args.size
+
+    # One request per range, as with the original protocol
+    latencies = measure(lambda: [c.read_memory(address, size) for address, size in ranges],
+                        max(1, args.iterations // 10))
+    report("read_memory x{}".format(args.ranges), latencies, polled_bytes * len(latencies))
+
+    latencies = measure(lambda: c.read_memory_batch(ranges), args.iterations)
+    report("read_memory_batch", latencies, polled_bytes * len(latencies))
+
+    block_size = MAX_REQUEST_DATA_SIZE
+    latencies = measure(lambda: c.read_memory(args.address, block_size), args.iterations)
+    report("read_memory {} bytes".format(block_size), latencies, block_size * len(latencies))
+
+    # Time between updates is bounded by the frame rate, so only report the rate here
+    subscription_id = c.subscribe(ranges)
+    if subscription_id is None:
+        print("subscribe failed")
+        return
+    latencies = measure(lambda: c.wait_for_update(subscription_id), args.iterations)
+    c.unsubscribe(subscription_id)
+    report("subscription updates", latencies, polled_bytes * len(latencies))
+
+
+if "__main__" == __name__:
+    main()
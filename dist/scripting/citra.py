@@ -2,14 +2,22 @@ import struct
 import random
 import enum
 import socket
+import time
 
-CURRENT_REQUEST_VERSION = 1
-MAX_REQUEST_DATA_SIZE = 32
-MAX_PACKET_SIZE = 48
+CURRENT_REQUEST_VERSION = 2
+MAX_REQUEST_DATA_SIZE = 65491
+MAX_PACKET_SIZE = 65507
+# Subscriptions expire after 600 VBlanks unless they are renewed, which is about ten seconds at
+# full speed
+SUBSCRIPTION_RENEW_INTERVAL = 2.0
 
 class RequestType(enum.IntEnum):
     ReadMemory = 1,
-    WriteMemory = 2
+    WriteMemory = 2,
+    ReadMemoryBatch = 3,
+    WriteMemoryBatch = 4,
+    Subscribe = 5,
+    Unsubscribe = 6
 
 CITRA_PORT = 45987
 
@@ -17,12 +25,15 @@ class Citra:
     def __init__(self, address="127.0.0.1", port=CITRA_PORT):
         self.socket = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
         self.address = address
+        self.subscriptions = {}
+        self.subscription_renewals = {}
 
     def is_connected(self):
         return self.socket is not None
 
-    def _generate_header(self, request_type, data_size):
-        request_id = random.getrandbits(32)
+    def _generate_header(self, request_type, data_size, request_id=None):
+        if request_id is None:
+            request_id = random.getrandbits(32)
         return (struct.pack("IIII", CURRENT_REQUEST_VERSION, request_id, request_type, data_size), request_id)
 
     def _read_and_validate_header(self, raw_reply, expected_id, expected_type):
@@ -90,6 +101,94 @@ class Citra:
                 return False
         return True
 
+    def _send_request(self, request_type, request_data, request_id=None):
+        request, request_id = self._generate_header(request_type, len(request_data), request_id)
+        self.socket.sendto(request + request_data, (self.address, CITRA_PORT))
+        return request_id
+
+    def _receive_reply(self, request_id, request_type):
+        while True:
+            raw_reply = self.socket.recv(MAX_PACKET_SIZE)
+            reply_data = self._read_and_validate_header(raw_reply, request_id, request_type)
+            # Skip updates of subscriptions that were not waited on
+            if reply_data is not None or struct.unpack("I", raw_reply[4:8])[0] not in self.subscriptions:
+                return reply_data
+
+    def read_memory_batch(self, ranges):
+        """
+        Reads several (address, size) ranges with a single request. The total size must not exceed
+        MAX_REQUEST_DATA_SIZE.
+        >>> c.read_memory_batch([(0x100000, 4), (0x100000, 2)])
+        [b'\\x07\\x00\\x00\\xeb', b'\\x07\\x00']
+        """
+        request_data = b"".join(struct.pack("II", address, size) for address, size in ranges)
+        request_id = self._send_request(RequestType.ReadMemoryBatch, request_data)
+        reply_data = self._receive_reply(request_id, RequestType.ReadMemoryBatch)
+        if not reply_data:
+            return None
+        return self._split_ranges(reply_data, ranges)
+
+    def write_memory_batch(self, writes):
+        """
+        Writes several (address, contents) pairs with a single request.
+        >>> c.write_memory_batch([(0x100000, b"\\xff\\xff"), (0x100002, b"\\xff\\xff")])
+        True
+        >>> c.write_memory_batch([(0x100000, b"\\x07\\x00\\x00\\xeb")])
+        True
+        """
+        request_data = b"".join(struct.pack("II", address, len(contents)) + contents
+                                for address, contents in writes)
+        request_id = self._send_request(RequestType.WriteMemoryBatch, request_data)
+        return self._receive_reply(request_id, RequestType.WriteMemoryBatch) is not None
+
+    def subscribe(self, ranges):
+        """
+        Watches several (address, size) ranges. Their contents are sent at every VBlank until
+        unsubscribe is called, and can be received with wait_for_update. Returns the subscription
+        id, or None if the server rejected the subscription. The subscription expires if
+        wait_for_update is not called for about ten seconds.
+        """
+        request_data = b"".join(struct.pack("II", address, size) for address, size in ranges)
+        request_id = self._send_request(RequestType.Subscribe, request_data)
+        self.subscriptions[request_id] = ranges
+        # The server acknowledges the subscription with the current contents
+        if not self._receive_reply(request_id, RequestType.Subscribe):
+            del self.subscriptions[request_id]
+            return None
+        self.subscription_renewals[request_id] = time.monotonic()
+        return request_id
+
+    def _renew_subscription(self, subscription_id):
+        # Subscribing again with the same id renews the lease, the server replies with an update
+        ranges = self.subscriptions[subscription_id]
+        request_data = b"".join(struct.pack("II", address, size) for address, size in ranges)
+        self._send_request(RequestType.Subscribe, request_data, subscription_id)
+        self.subscription_renewals[subscription_id] = time.monotonic()
+
+    def wait_for_update(self, subscription_id):
+        """
+        Waits for the next update of the subscription and returns the contents of its ranges.
+        """
+        if time.monotonic() - self.subscription_renewals[subscription_id] > SUBSCRIPTION_RENEW_INTERVAL:
+            self._renew_subscription(subscription_id)
+        reply_data = self._receive_reply(subscription_id, RequestType.Subscribe)
+        return self._split_ranges(reply_data, self.subscriptions[subscription_id])
+
+    def unsubscribe(self, subscription_id):
+        request_id = self._send_request(RequestType.Unsubscribe, struct.pack("I", subscription_id))
+        result = self._receive_reply(request_id, RequestType.Unsubscribe) is not None
+        del self.subscriptions[subscription_id]
+        del self.subscription_renewals[subscription_id]
+        return result
+
+    @staticmethod
+    def _split_ranges(data, ranges):
+        result = []
+        for _, size in ranges:
+            result.append(data[:size])
+            data = data[size:]
+        return result
+
 if "__main__" == __name__:
     import doctest
     doctest.testmod(extraglobs={'c': Citra()})
@@ -42,7 +42,10 @@ void DspInterface::OutputFrame(StereoFrame16 frame) {
     if (!sink)
         return;
 
-    fifo.Push(frame.data(), frame.size());
+    // Turbo mode produces audio faster than it can be played, so it is dropped instead
+    if (!Settings::values.use_turbo_mode) {
+        fifo.Push(frame.data(), frame.size());
+    }
 
     if (Core::System::GetInstance().VideoDumper().IsDumping()) {
         Core::System::GetInstance().VideoDumper().AddAudioFrame(std::move(frame));
@@ -53,7 +56,9 @@ void DspInterface::OutputSample(std::array<s16, 2> sample) {
     if (!sink)
         return;
 
-    fifo.Push(&sample, 1);
+    if (!Settings::values.use_turbo_mode) {
+        fifo.Push(&sample, 1);
+    }
 
     if (Core::System::GetInstance().VideoDumper().IsDumping()) {
         Core::System::GetInstance().VideoDumper().AddAudioSample(std::move(sample));
@@ -2,6 +2,7 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <functional>
 #include <iostream>
 #include <memory>
 #include <regex>
@@ -20,6 +21,9 @@
 
 #include "citra/config.h"
 #include "citra/emu_window/emu_window_sdl2.h"
+#ifdef HAVE_EGL_HEADLESS
+#include "citra/emu_window/emu_window_egl.h"
+#endif
 #include "citra/lodepng_image_interface.h"
 #include "common/common_paths.h"
 #include "common/detached_tasks.h"
@@ -67,8 +71,12 @@ static void PrintHelp(const char* argv0) {
                  " Nickname, password, address and port for multiplayer\n"
                  "-r, --movie-record=[file]  Record a movie (game inputs) to the given file\n"
                  "-p, --movie-play=[file]    Playback the movie (game inputs) from the given file\n"
+                 "-s, --movie-seek=RECORD    Start the movie playback at the given input record\n"
                  "-d, --dump-video=[file]    Dumps audio and video to the given video file\n"
                  "-f, --fullscreen     Start in fullscreen mode\n"
+                 "-n, --headless       Render offscreen through EGL without opening a window\n"
+                 "-b, --benchmark=FRAMES  Run headless and unthrottled for FRAMES frames, then"
+                 " report the mean frametime\n"
                  "-h, --help           Display this help and exit\n"
                  "-v, --version        Output version information and exit\n";
 }
@@ -193,7 +201,10 @@ int main(int argc, char** argv) {
     u32 gdb_port = static_cast<u32>(Settings::values.gdbstub_port);
     std::string movie_record;
     std::string movie_play;
+    u64 movie_seek_record = 0;
     std::string dump_video;
+    bool headless = false;
+    u32 benchmark_frames = 0;
 
     InitializeLogging();
 
@@ -221,11 +232,13 @@ int main(int argc, char** argv) {
         {"multiplayer", required_argument, 0, 'm'}, {"movie-record", required_argument, 0, 'r'},
         {"movie-play", required_argument, 0, 'p'},  {"dump-video", required_argument, 0, 'd'},
         {"fullscreen", no_argument, 0, 'f'},        {"help", no_argument, 0, 'h'},
-        {"version", no_argument, 0, 'v'},           {0, 0, 0, 0},
+        {"version", no_argument, 0, 'v'},           {"headless", no_argument, 0, 'n'},
+        {"benchmark", required_argument, 0, 'b'},   {"movie-seek", required_argument, 0, 's'},
+        {0, 0, 0, 0},
     };
 
     while (optind < argc) {
-        int arg = getopt_long(argc, argv, "g:i:m:r:p:fhv", long_options, &option_index);
+        int arg = getopt_long(argc, argv, "g:i:m:r:p:s:fhvnb:", long_options, &option_index);
         if (arg != -1) {
             switch (static_cast<char>(arg)) {
             case 'g':
@@ -288,6 +301,16 @@ int main(int argc, char** argv) {
             case 'p':
                 movie_play = optarg;
                 break;
+            case 's':
+                errno = 0;
+                movie_seek_record = strtoull(optarg, &endarg, 0);
+                if (endarg == optarg)
+                    errno = EINVAL;
+                if (errno != 0) {
+                    perror("--movie-seek");
+                    exit(1);
+                }
+                break;
             case 'd':
                 dump_video = optarg;
                 break;
@@ -295,6 +318,20 @@ int main(int argc, char** argv) {
                 fullscreen = true;
                 LOG_INFO(Frontend, "Starting in fullscreen mode...");
                 break;
+            case 'n':
+                headless = true;
+                break;
+            case 'b':
+                errno = 0;
+                benchmark_frames = strtoul(optarg, &endarg, 0);
+                headless = true;
+                if (endarg == optarg || benchmark_frames == 0)
+                    errno = EINVAL;
+                if (errno != 0) {
+                    perror("--benchmark");
+                    exit(1);
+                }
+                break;
             case 'h':
                 PrintHelp(argv[0]);
                 return 0;
@@ -339,6 +376,9 @@ int main(int argc, char** argv) {
     // Apply the command line arguments
     Settings::values.gdbstub_port = gdb_port;
     Settings::values.use_gdbstub = use_gdbstub;
+    if (benchmark_frames != 0) {
+        Settings::values.use_frame_limit = false;
+    }
     Settings::Apply();
 
     // Register frontend applets
@@ -347,7 +387,27 @@ int main(int argc, char** argv) {
     // Register generic image interface
     Core::System::GetInstance().RegisterImageInterface(std::make_shared<LodePNGImageInterface>());
 
-    std::unique_ptr<EmuWindow_SDL2> emu_window{std::make_unique<EmuWindow_SDL2>(fullscreen)};
+#ifndef HAVE_EGL_HEADLESS
+    if (headless) {
+        LOG_CRITICAL(Frontend, "Headless rendering requires building with ENABLE_EGL_HEADLESS");
+        return -1;
+    }
+#endif
+
+    std::unique_ptr<Frontend::EmuWindow> emu_window;
+    std::function<bool()> is_open;
+#ifdef HAVE_EGL_HEADLESS
+    if (headless) {
+        auto egl_window = std::make_unique<EmuWindow_EGL>(benchmark_frames);
+        is_open = [window = egl_window.get()] { return window->IsOpen(); };
+        emu_window = std::move(egl_window);
+    } else
+#endif
+    {
+        auto sdl_window = std::make_unique<EmuWindow_SDL2>(fullscreen);
+        is_open = [window = sdl_window.get()] { return window->IsOpen(); };
+        emu_window = std::move(sdl_window);
+    }
     Frontend::ScopeAcquireContext scope(*emu_window);
     Core::System& system{Core::System::GetInstance()};
 
@@ -382,7 +442,8 @@ int main(int argc, char** argv) {
         break; // Expected case
     }
 
-    system.TelemetrySession().AddField(Telemetry::FieldType::App, "Frontend", "SDL");
+    system.TelemetrySession().AddField(Telemetry::FieldType::App, "Frontend",
+                                       headless ? "SDL (headless)" : "SDL");
 
     if (use_multiplayer) {
         if (auto member = Network::GetRoomMember().lock()) {
@@ -401,7 +462,13 @@ int main(int argc, char** argv) {
     }
 
     if (!movie_play.empty()) {
-        Core::Movie::GetInstance().StartPlayback(movie_play);
+        auto& movie = Core::Movie::GetInstance();
+        movie.StartPlayback(movie_play);
+        // Without savestates the emulation still starts from boot, so playback only stays in
+        // sync if the skipped input didn't change the emulated state
+        if (movie_seek_record != 0 && !movie.SeekToRecord(movie_seek_record)) {
+            LOG_ERROR(Frontend, "Movie has no input record {}", movie_seek_record);
+        }
     }
     if (!movie_record.empty()) {
         Core::Movie::GetInstance().StartRecording(movie_record);
@@ -412,7 +479,13 @@ int main(int argc, char** argv) {
         system.VideoDumper().StartDumping(dump_video, layout);
     }
 
-    std::thread render_thread([&emu_window] { emu_window->Present(); });
+    // There is nothing to present to in headless mode, frames are left in the mailbox
+    std::thread render_thread;
+    if (!headless) {
+        render_thread = std::thread([&emu_window] {
+            static_cast<EmuWindow_SDL2*>(emu_window.get())->Present();
+        });
+    }
 
     std::atomic_bool stop_run;
     Core::System::GetInstance().Renderer().Rasterizer()->LoadDiskResources(
@@ -421,10 +494,32 @@ int main(int argc, char** argv) {
                       total);
         });
 
-    while (emu_window->IsOpen()) {
+    bool draw_timing = false;
+    if (benchmark_frames != 0) {
+        draw_timing = system.Renderer().Rasterizer()->SetDrawTimingEnabled(true);
+    }
+
+    while (is_open()) {
         system.RunLoop();
     }
-    render_thread.join();
+    if (render_thread.joinable()) {
+        render_thread.join();
+    }
+
+    if (benchmark_frames != 0) {
+        std::cout << "Benchmark: " << benchmark_frames << " frames, mean frametime "
+                  << system.perf_stats->GetMeanFrametime() << " ms" << std::endl;
+        if (draw_timing) {
+            const auto stats = system.Renderer().Rasterizer()->GetDrawTimeStats();
+            const double mean_us =
+                stats.draw_count == 0 ? 0.0 : stats.total_ns / 1000.0 / stats.draw_count;
+            std::cout << "GPU draw time: " << stats.draw_count << " draws, total "
+                      << stats.total_ns / 1000000.0 << " ms, mean " << mean_us << " us, max "
+                      << stats.max_ns / 1000.0 << " us" << std::endl;
+        } else {
+            std::cout << "GPU draw time is not available on this renderer" << std::endl;
+        }
+    }
 
     Core::Movie::GetInstance().Shutdown();
     if (system.VideoDumper().IsDumping()) {
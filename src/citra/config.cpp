@@ -104,6 +104,7 @@ void Config::ReadValues() {
 
     // Core
     Settings::values.use_cpu_jit = sdl2_config->GetBoolean("Core", "use_cpu_jit", true);
+    Settings::values.use_multi_core = sdl2_config->GetBoolean("Core", "use_multi_core", false);
     Settings::values.cpu_clock_percentage =
         sdl2_config->GetInteger("Core", "cpu_clock_percentage", 100);
 
@@ -128,6 +129,9 @@ void Config::ReadValues() {
         sdl2_config->GetBoolean("Renderer", "use_disk_shader_cache", true);
     Settings::values.frame_limit =
         static_cast<u16>(sdl2_config->GetInteger("Renderer", "frame_limit", 100));
+    Settings::values.use_turbo_mode = sdl2_config->GetBoolean("Renderer", "use_turbo_mode", false);
+    Settings::values.turbo_present_interval =
+        static_cast<u16>(sdl2_config->GetInteger("Renderer", "turbo_present_interval", 10));
     Settings::values.use_vsync_new =
         static_cast<u16>(sdl2_config->GetInteger("Renderer", "use_vsync_new", 1));
     Settings::values.texture_filter_name =
@@ -266,6 +270,9 @@ void Config::ReadValues() {
     // Web Service
     Settings::values.enable_telemetry =
         sdl2_config->GetBoolean("WebService", "enable_telemetry", true);
+    Settings::values.enable_perf_reports =
+        sdl2_config->GetBoolean("WebService", "enable_perf_reports", false);
+    Settings::values.perf_report_url = sdl2_config->GetString("WebService", "perf_report_url", "");
     Settings::values.web_api_url =
         sdl2_config->GetString("WebService", "web_api_url", "https://api.citra-emu.org");
     Settings::values.citra_username = sdl2_config->GetString("WebService", "citra_username", "");
@@ -91,6 +91,10 @@ udp_pad_index=
 # 0: Interpreter (slow), 1 (default): JIT (fast)
 use_cpu_jit =
 
+# Whether to run each emulated CPU core on its own host thread. Requires the JIT. Experimental.
+# 0 (default): Off, 1: On
+use_multi_core =
+
 # Change the Clock Frequency of the emulated 3DS CPU.
 # Underclocking can increase the performance of the game at the risk of freezing.
 # Overclocking may fix lag that happens on console, but also comes with the risk of freezing.
@@ -144,6 +148,15 @@ use_frame_limit =
 # 1 - 9999: Speed limit as a percentage of target game speed. 100 (default)
 frame_limit =
 
+# Runs the game as fast as possible, without the frame limiter and without audio output.
+# Emulation itself is unaffected, so movies play back the same way.
+# 0: Off (default), 1: On
+use_turbo_mode =
+
+# In turbo mode, only present every Nth frame to the screen
+# 1 - 65535: 10 (default)
+turbo_present_interval =
+
 # The clear color for the renderer. What shows up on the sides of the bottom screen.
 # Must be in range of 0.0-1.0. Defaults to 0.0 for all.
 bg_red =
@@ -299,6 +312,12 @@ gdbstub_port=24689
 # Whether or not to enable telemetry
 # 0: No, 1 (default): Yes
 enable_telemetry =
+# Whether or not to periodically upload performance reports
+# 0 (default): No, 1: Yes
+enable_perf_reports =
+# URL of the server the performance reports are uploaded to
+# Empty (default): Only keep the reports in log/perf_reports
+perf_report_url =
 # URL for Web API
 web_api_url = https://api.citra-emu.org
 # Username and token for Citra Web Service
@@ -0,0 +1,217 @@
+// Copyright 2020 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <array>
+#include <cstdlib>
+#include <cstring>
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include <glad/glad.h>
+#include "citra/emu_window/emu_window_egl.h"
+#include "common/logging/log.h"
+#include "common/scm_rev.h"
+#include "core/3ds.h"
+#include "core/core.h"
+#include "core/settings.h"
+#include "input_common/main.h"
+#include "network/network.h"
+
+#ifndef EGL_PLATFORM_SURFACELESS_MESA
+#define EGL_PLATFORM_SURFACELESS_MESA 0x31DD
+#endif
+
+static bool HasExtension(EGLDisplay display, const char* name) {
+    const char* extensions = eglQueryString(display, EGL_EXTENSIONS);
+    if (extensions == nullptr) {
+        return false;
+    }
+    const std::size_t length = std::strlen(name);
+    for (const char* pos = std::strstr(extensions, name); pos != nullptr;
+         pos = std::strstr(pos + length, name)) {
+        if ((pos == extensions || pos[-1] == ' ') && (pos[length] == ' ' || pos[length] == '\0')) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static EGLDisplay OpenDisplay() {
+    // Prefer the Mesa surfaceless platform, which needs neither a display server nor a GPU
+    if (HasExtension(EGL_NO_DISPLAY, "EGL_MESA_platform_surfaceless")) {
+        const auto get_platform_display = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(
+            eglGetProcAddress("eglGetPlatformDisplayEXT"));
+        if (get_platform_display != nullptr) {
+            EGLDisplay display =
+                get_platform_display(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+            if (display != EGL_NO_DISPLAY) {
+                return display;
+            }
+        }
+    }
+    return eglGetDisplay(EGL_DEFAULT_DISPLAY);
+}
+
+SharedContext_EGL::SharedContext_EGL(EGLDisplay display, EGLConfig config,
+                                     EGLContext share_context)
+    : display(display), context(EGL_NO_CONTEXT), surface(EGL_NO_SURFACE) {
+    std::array<EGLint, 7> context_attribs;
+    if (Settings::values.use_gles) {
+        context_attribs = {EGL_CONTEXT_MAJOR_VERSION, 3, EGL_CONTEXT_MINOR_VERSION, 2, EGL_NONE};
+    } else {
+        context_attribs = {EGL_CONTEXT_MAJOR_VERSION,
+                           3,
+                           EGL_CONTEXT_MINOR_VERSION,
+                           3,
+                           EGL_CONTEXT_OPENGL_PROFILE_MASK,
+                           EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+                           EGL_NONE};
+    }
+    context = eglCreateContext(display, config, share_context, context_attribs.data());
+    if (context == EGL_NO_CONTEXT) {
+        return;
+    }
+
+    if (!HasExtension(display, "EGL_KHR_surfaceless_context")) {
+        static constexpr std::array<EGLint, 5> pbuffer_attribs{EGL_WIDTH, 1, EGL_HEIGHT, 1,
+                                                               EGL_NONE};
+        surface = eglCreatePbufferSurface(display, config, pbuffer_attribs.data());
+    }
+}
+
+SharedContext_EGL::~SharedContext_EGL() {
+    DoneCurrent();
+    if (surface != EGL_NO_SURFACE) {
+        eglDestroySurface(display, surface);
+    }
+    if (context != EGL_NO_CONTEXT) {
+        eglDestroyContext(display, context);
+    }
+}
+
+bool SharedContext_EGL::IsValid() const {
+    return context != EGL_NO_CONTEXT;
+}
+
+SharedContext_EGL::EGLContext SharedContext_EGL::GetHandle() const {
+    return context;
+}
+
+void SharedContext_EGL::MakeCurrent() {
+    eglMakeCurrent(display, surface, surface, context);
+}
+
+void SharedContext_EGL::DoneCurrent() {
+    eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+}
+
+EmuWindow_EGL::EmuWindow_EGL(u32 frame_limit) : frame_limit(frame_limit) {
+    InputCommon::Init();
+    Network::Init();
+
+    display = OpenDisplay();
+    if (display == EGL_NO_DISPLAY || !eglInitialize(display, nullptr, nullptr)) {
+        LOG_CRITICAL(Frontend, "Failed to initialize EGL display: 0x{:X}", eglGetError());
+        exit(1);
+    }
+
+    if (!eglBindAPI(Settings::values.use_gles ? EGL_OPENGL_ES_API : EGL_OPENGL_API)) {
+        LOG_CRITICAL(Frontend, "Failed to bind EGL API: 0x{:X}", eglGetError());
+        exit(1);
+    }
+
+    const std::array<EGLint, 13> config_attribs{
+        EGL_SURFACE_TYPE,
+        EGL_PBUFFER_BIT,
+        EGL_RENDERABLE_TYPE,
+        Settings::values.use_gles ? EGL_OPENGL_ES3_BIT : EGL_OPENGL_BIT,
+        EGL_RED_SIZE,
+        8,
+        EGL_GREEN_SIZE,
+        8,
+        EGL_BLUE_SIZE,
+        8,
+        EGL_ALPHA_SIZE,
+        0,
+        EGL_NONE};
+    EGLint num_configs = 0;
+    if (!eglChooseConfig(display, config_attribs.data(), &config, 1, &num_configs) ||
+        num_configs == 0) {
+        LOG_CRITICAL(Frontend, "No suitable EGL config found: 0x{:X}", eglGetError());
+        exit(1);
+    }
+
+    root_context = std::make_unique<SharedContext_EGL>(display, config, EGL_NO_CONTEXT);
+    if (!root_context->IsValid()) {
+        LOG_CRITICAL(Frontend, "Failed to create EGL context: 0x{:X}", eglGetError());
+        exit(1);
+    }
+    core_context = CreateSharedContext();
+    if (core_context == nullptr) {
+        LOG_CRITICAL(Frontend, "Failed to create shared EGL context: 0x{:X}", eglGetError());
+        exit(1);
+    }
+
+    root_context->MakeCurrent();
+    auto gl_load_func = Settings::values.use_gles ? gladLoadGLES2Loader : gladLoadGLLoader;
+    if (!gl_load_func(reinterpret_cast<GLADloadproc>(eglGetProcAddress))) {
+        LOG_CRITICAL(Frontend, "Failed to initialize GL functions");
+        exit(1);
+    }
+    LOG_INFO(Frontend, "EGL vendor: {} | GL renderer: {}", eglQueryString(display, EGL_VENDOR),
+             reinterpret_cast<const char*>(glGetString(GL_RENDERER)));
+    root_context->DoneCurrent();
+
+    UpdateCurrentFramebufferLayout(Core::kScreenTopWidth,
+                                   Core::kScreenTopHeight + Core::kScreenBottomHeight);
+    last_report_time = std::chrono::steady_clock::now();
+
+    LOG_INFO(Frontend, "Citra Version: {} | {}-{}", Common::g_build_fullname, Common::g_scm_branch,
+             Common::g_scm_desc);
+    Settings::LogSettings();
+}
+
+EmuWindow_EGL::~EmuWindow_EGL() {
+    core_context.reset();
+    root_context.reset();
+    Network::Shutdown();
+    InputCommon::Shutdown();
+    eglTerminate(display);
+    eglReleaseThread();
+}
+
+std::unique_ptr<Frontend::GraphicsContext> EmuWindow_EGL::CreateSharedContext() const {
+    auto context = std::make_unique<SharedContext_EGL>(display, config,
+                                                       root_context->GetHandle());
+    if (!context->IsValid()) {
+        return nullptr;
+    }
+    return context;
+}
+
+void EmuWindow_EGL::PollEvents() {
+    ++frame_count;
+    if (frame_limit != 0 && frame_count >= frame_limit) {
+        is_open = false;
+    }
+
+    const auto current_time = std::chrono::steady_clock::now();
+    if (current_time - last_report_time > std::chrono::seconds(2)) {
+        const auto results = Core::System::GetInstance().GetAndResetPerfStats();
+        LOG_INFO(Frontend, "Frame {} | FPS: {:.0f} ({:.0%}) | Frametime: {:.2f} ms", frame_count,
+                 results.game_fps, results.emulation_speed, results.frametime * 1000.0);
+        last_report_time = current_time;
+    }
+}
+
+void EmuWindow_EGL::MakeCurrent() {
+    core_context->MakeCurrent();
+}
+
+void EmuWindow_EGL::DoneCurrent() {
+    core_context->DoneCurrent();
+}
+
+bool EmuWindow_EGL::IsOpen() const {
+    return is_open;
+}
@@ -0,0 +1,93 @@
+// Copyright 2020 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include "core/frontend/emu_window.h"
+
+class SharedContext_EGL : public Frontend::GraphicsContext {
+public:
+    using EGLDisplay = void*;
+    using EGLConfig = void*;
+    using EGLContext = void*;
+    using EGLSurface = void*;
+
+    SharedContext_EGL(EGLDisplay display, EGLConfig config, EGLContext share_context);
+
+    ~SharedContext_EGL() override;
+
+    /// Whether the context was created successfully
+    bool IsValid() const;
+
+    /// Returns the native EGL context, used as the share context for new contexts
+    EGLContext GetHandle() const;
+
+    void MakeCurrent() override;
+
+    void DoneCurrent() override;
+
+private:
+    EGLDisplay display;
+    EGLContext context;
+    /// Dummy pbuffer, only used when the driver lacks EGL_KHR_surfaceless_context
+    EGLSurface surface;
+};
+
+/**
+ * Window-less EmuWindow that renders through an offscreen EGL context. Frames are still rendered
+ * into the mailbox, but nothing ever presents them, which makes this suitable for regression and
+ * benchmark runs on machines without a display (e.g. Mesa llvmpipe with the surfaceless platform).
+ */
+class EmuWindow_EGL : public Frontend::EmuWindow {
+public:
+    /**
+     * @param frame_limit Number of frames to emulate before the window reports itself as closed,
+     * or 0 to run until the process is terminated
+     */
+    explicit EmuWindow_EGL(u32 frame_limit);
+    ~EmuWindow_EGL();
+
+    /// Counts emulated frames and logs the performance statistics periodically
+    void PollEvents() override;
+
+    /// Makes the graphics context current for the caller thread
+    void MakeCurrent() override;
+
+    /// Releases the GL context from the caller thread
+    void DoneCurrent() override;
+
+    /// Whether the frame limit has not been reached yet
+    bool IsOpen() const;
+
+    /// Creates a new context that is shared with the current context
+    std::unique_ptr<GraphicsContext> CreateSharedContext() const override;
+
+private:
+    using EGLDisplay = void*;
+    using EGLConfig = void*;
+    using EGLContext = void*;
+
+    EGLDisplay display = nullptr;
+    EGLConfig config = nullptr;
+
+    /// Context used only as the share group root for the contexts created by CreateSharedContext
+    std::unique_ptr<SharedContext_EGL> root_context;
+
+    /// The OpenGL context associated with the core
+    std::unique_ptr<Frontend::GraphicsContext> core_context;
+
+    /// Frames emulated since the window was created
+    u32 frame_count = 0;
+
+    /// Number of frames to run before closing, 0 for no limit
+    const u32 frame_limit;
+
+    /// Keeps track of how often to log the performance statistics
+    std::chrono::steady_clock::time_point last_report_time;
+
+    std::atomic_bool is_open{true};
+};
@@ -173,12 +173,19 @@ static constexpr int V(int r, int g, int b) {
 
 std::vector<u16> Rgb2Yuv(const QImage& source, int width, int height) {
     auto buffer = std::vector<u16>(width * height);
+    // Reading whole scan lines of 32-bit pixels is much faster than calling QImage::pixel for
+    // every pixel, which has to look up the format each time
+    const bool is_rgb32 = source.format() == QImage::Format_RGB32 ||
+                          source.format() == QImage::Format_ARGB32 ||
+                          source.format() == QImage::Format_ARGB32_Premultiplied;
+    const QImage image = is_rgb32 ? source : source.convertToFormat(QImage::Format_RGB32);
     auto dest = buffer.begin();
     bool write = false;
     int py, pu, pv;
     for (int y = 0; y < height; ++y) {
+        const QRgb* line = reinterpret_cast<const QRgb*>(image.constScanLine(y));
         for (int x = 0; x < width; ++x) {
-            QRgb rgb = source.pixel(x, y);
+            const QRgb rgb = line[x];
             int r = qRed(rgb);
             int g = qGreen(rgb);
             int b = qBlue(rgb);
@@ -212,14 +219,26 @@ std::vector<u16> ProcessImage(const QImage& image, int width, int height, bool o
     if (image.isNull()) {
         return buffer;
     }
-    QImage scaled =
-        image.scaled(width, height, Qt::KeepAspectRatioByExpanding, Qt::SmoothTransformation);
-    QImage transformed =
-        scaled.copy((scaled.width() - width) / 2, (scaled.height() - height) / 2, width, height)
-            .mirrored(flip_horizontal, flip_vertical);
+
+    // Skip the steps that wouldn't change anything, as each of them copies the whole image
+    QImage transformed = image;
+    if (transformed.width() != width || transformed.height() != height) {
+        const QImage scaled =
+            image.scaled(width, height, Qt::KeepAspectRatioByExpanding, Qt::SmoothTransformation);
+        transformed = scaled.copy((scaled.width() - width) / 2, (scaled.height() - height) / 2,
+                                  width, height);
+    }
+    if (flip_horizontal || flip_vertical) {
+        transformed = transformed.mirrored(flip_horizontal, flip_vertical);
+    }
+
     if (output_rgb) {
-        QImage converted = transformed.convertToFormat(QImage::Format_RGB16);
-        std::memcpy(buffer.data(), converted.bits(), width * height * sizeof(u16));
+        const QImage converted = transformed.convertToFormat(QImage::Format_RGB16);
+        // Scan lines are padded to 4 bytes, so they have to be copied one by one
+        for (int y = 0; y < height; ++y) {
+            std::memcpy(buffer.data() + y * width, converted.constScanLine(y),
+                        width * sizeof(u16));
+        }
     } else {
         return CameraUtil::Rgb2Yuv(transformed, width, height);
     }
@@ -2,6 +2,7 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <QImage>
 #include <QMessageBox>
 #include "citra_qt/camera/camera_util.h"
 #include "citra_qt/camera/qt_camera_base.h"
@@ -35,9 +36,16 @@ void QtCameraInterface::SetEffect(Service::CAM::Effect effect) {
     }
 }
 
-std::vector<u16> QtCameraInterface::ReceiveFrame() {
-    return CameraUtil::ProcessImage(QtReceiveFrame(), width, height, output_rgb, flip_horizontal,
-                                    flip_vertical);
+std::shared_ptr<const std::vector<u16>> QtCameraInterface::ReceiveFrame() {
+    const QImage image = QtReceiveFrame();
+    const auto frame_key = std::make_tuple(image.cacheKey(), width, height, output_rgb,
+                                           flip_horizontal, flip_vertical);
+    if (!cached_frame || frame_key != cached_frame_key) {
+        cached_frame = std::make_shared<const std::vector<u16>>(CameraUtil::ProcessImage(
+            image, width, height, output_rgb, flip_horizontal, flip_vertical));
+        cached_frame_key = frame_key;
+    }
+    return cached_frame;
 }
 
 std::unique_ptr<CameraInterface> QtCameraFactory::CreatePreview(const std::string& config,
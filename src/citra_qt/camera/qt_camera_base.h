@@ -4,7 +4,10 @@
 
 #pragma once
 
+#include <memory>
 #include <string>
+#include <tuple>
+#include <QtGlobal>
 #include "core/frontend/camera/factory.h"
 
 namespace Camera {
@@ -17,7 +20,7 @@ public:
     void SetFlip(Service::CAM::Flip) override;
     void SetEffect(Service::CAM::Effect) override;
     void SetFormat(Service::CAM::OutputFormat) override;
-    std::vector<u16> ReceiveFrame() override;
+    std::shared_ptr<const std::vector<u16>> ReceiveFrame() override;
     virtual QImage QtReceiveFrame() = 0;
 
 private:
@@ -25,6 +28,11 @@ private:
     bool output_rgb;
     bool flip_horizontal, flip_vertical;
     bool basic_flip_horizontal, basic_flip_vertical;
+
+    // The last converted frame, along with the cache key of its source image and the parameters it
+    // was converted with. Still images and cameras that didn't deliver a new frame reuse it.
+    std::shared_ptr<const std::vector<u16>> cached_frame;
+    std::tuple<qint64, int, int, bool, bool, bool> cached_frame_key{};
 };
 
 // Base class for camera factories of citra_qt
@@ -228,7 +228,7 @@ void ConfigureCamera::timerEvent(QTimerEvent* event) {
         timer_id = 0;
         return;
     }
-    std::vector<u16> frame = previewing_camera->ReceiveFrame();
+    const auto frame = previewing_camera->ReceiveFrame();
     int width = ui->preview_box->size().width();
     int height = width * 0.75;
     if (width != preview_width || height != preview_height) {
@@ -236,7 +236,7 @@ void ConfigureCamera::timerEvent(QTimerEvent* event) {
         return;
     }
     QImage image(width, height, QImage::Format::Format_RGB16);
-    std::memcpy(image.bits(), frame.data(), width * height * sizeof(u16));
+    std::memcpy(image.bits(), frame->data(), width * height * sizeof(u16));
     ui->preview_box->setPixmap(QPixmap::fromImage(image));
 }
 
@@ -36,6 +36,8 @@ void ConfigureDebug::SetConfiguration() {
     ui->toggle_console->setChecked(UISettings::values.show_console);
     ui->log_filter_edit->setText(QString::fromStdString(Settings::values.log_filter));
     ui->toggle_cpu_jit->setChecked(Settings::values.use_cpu_jit);
+    ui->toggle_multi_core->setEnabled(!Core::System::GetInstance().IsPoweredOn());
+    ui->toggle_multi_core->setChecked(Settings::values.use_multi_core);
 }
 
 void ConfigureDebug::ApplyConfiguration() {
@@ -48,6 +50,7 @@ void ConfigureDebug::ApplyConfiguration() {
     filter.ParseFilterString(Settings::values.log_filter);
     Log::SetGlobalFilter(filter);
     Settings::values.use_cpu_jit = ui->toggle_cpu_jit->isChecked();
+    Settings::values.use_multi_core = ui->toggle_multi_core->isChecked();
 }
 
 void ConfigureDebug::RetranslateUI() {
@@ -460,6 +460,11 @@ void GMainWindow::InitializeHotkeys() {
     connect(hotkey_registry.GetHotkey(main_window, QStringLiteral("Toggle Texture Dumping"), this),
             &QShortcut::activated, this,
             [&] { Settings::values.dump_textures = !Settings::values.dump_textures; });
+    connect(hotkey_registry.GetHotkey(main_window, QStringLiteral("Toggle Turbo Mode"), this),
+            &QShortcut::activated, this, [&] {
+                Settings::values.use_turbo_mode = !Settings::values.use_turbo_mode;
+                UpdateStatusBar();
+            });
     // We use "static" here in order to avoid capturing by lambda due to a MSVC bug, which makes
     // the variable hold a garbage value after this function exits
     static constexpr u16 SPEED_LIMIT_STEP = 5;
@@ -1876,7 +1881,10 @@ void GMainWindow::UpdateStatusBar() {
 
     auto results = Core::System::GetInstance().GetAndResetPerfStats();
 
-    if (Settings::values.use_frame_limit) {
+    if (Settings::values.use_turbo_mode) {
+        emu_speed_label->setText(
+            tr("Speed: %1% (Turbo)").arg(results.emulation_speed * 100.0, 0, 'f', 0));
+    } else if (Settings::values.use_frame_limit) {
         emu_speed_label->setText(tr("Speed: %1% / %2%")
                                      .arg(results.emulation_speed * 100.0, 0, 'f', 0)
                                      .arg(Settings::values.frame_limit));
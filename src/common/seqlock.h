@@ -0,0 +1,89 @@
+// Copyright 2020 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <mutex>
+#include <type_traits>
+#include "common/common_types.h"
+
+namespace Common {
+
+/// Holds a value that readers can copy without ever taking a lock.
+/// Writers are serialized by a mutex. Readers retry if a write happened while they were copying,
+/// so they always get a consistent snapshot and never delay the writer.
+/// @tparam T  Value type, must be safely memcpy-able
+template <typename T>
+class SeqLock {
+    static_assert(std::is_trivially_copyable_v<T>);
+    static_assert(std::is_default_constructible_v<T>);
+    // Ensure lock-free.
+    static_assert(std::atomic<u64>::is_always_lock_free);
+
+public:
+    SeqLock() {
+        Store(T{});
+    }
+
+    /// Returns a consistent copy of the current value
+    T Read() const {
+        std::array<u64, word_count> words;
+        u32 sequence_before;
+        u32 sequence_after;
+        do {
+            sequence_before = sequence.load(std::memory_order_acquire);
+            for (std::size_t i = 0; i < word_count; ++i) {
+                words[i] = storage[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            sequence_after = sequence.load(std::memory_order_relaxed);
+        } while ((sequence_before & 1) != 0 || sequence_before != sequence_after);
+
+        T value;
+        std::memcpy(&value, words.data(), sizeof(T));
+        return value;
+    }
+
+    /// Replaces the value
+    void Write(const T& value) {
+        std::lock_guard lock{write_mutex};
+        Store(value);
+    }
+
+    /// Applies func to a copy of the value and publishes the result, atomically with respect to
+    /// other writers
+    template <typename Func>
+    void Modify(Func&& func) {
+        std::lock_guard lock{write_mutex};
+        T value = Read();
+        func(value);
+        Store(value);
+    }
+
+private:
+    static constexpr std::size_t word_count = (sizeof(T) + sizeof(u64) - 1) / sizeof(u64);
+
+    void Store(const T& value) {
+        std::array<u64, word_count> words{};
+        std::memcpy(words.data(), &value, sizeof(T));
+
+        const u32 sequence_before = sequence.load(std::memory_order_relaxed);
+        sequence.store(sequence_before + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (std::size_t i = 0; i < word_count; ++i) {
+            storage[i].store(words[i], std::memory_order_relaxed);
+        }
+        sequence.store(sequence_before + 2, std::memory_order_release);
+    }
+
+    std::atomic<u32> sequence{0};
+    std::array<std::atomic<u64>, word_count> storage;
+    std::mutex write_mutex;
+};
+
+} // namespace Common
@@ -0,0 +1,158 @@
+// Copyright 2020 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <fmt/format.h>
+#include "common/assert.h"
+#include "common/microprofile.h"
+#include "common/thread.h"
+#include "core/arm/arm_interface.h"
+#include "core/arm/arm_thread_pool.h"
+
+static thread_local ARM_ThreadPool* current_thread_pool = nullptr;
+
+ARM_ThreadPool::ARM_ThreadPool(std::size_t num_cores) : slots(num_cores) {
+    threads.reserve(num_cores);
+    for (std::size_t core_id = 0; core_id < num_cores; ++core_id) {
+        threads.emplace_back(&ARM_ThreadPool::WorkerLoop, this, core_id);
+    }
+}
+
+ARM_ThreadPool::~ARM_ThreadPool() {
+    {
+        std::lock_guard lock{mutex};
+        stop_requested = true;
+    }
+    slice_started.notify_all();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+void ARM_ThreadPool::RunSlice(const std::vector<std::shared_ptr<ARM_Interface>>& cores,
+                              const SwitchCoreCallback& switch_core) {
+    std::unique_lock lock{mutex};
+    for (const auto& core : cores) {
+        slots[core->GetID()] = {core};
+    }
+    running_cores = cores.size();
+    ++slice_id;
+    slice_started.notify_all();
+
+    while (true) {
+        request_pending.wait(lock, [this] { return !requests.empty() || running_cores == 0; });
+        if (requests.empty()) {
+            break;
+        }
+
+        serving_request = true;
+        HaltExecutingCores(lock);
+
+        Request* request = requests.front();
+        requests.pop_front();
+        CoreSlot& slot = slots[request->core_id];
+
+        lock.unlock();
+        switch_core(slot.core);
+        (*request->func)();
+        lock.lock();
+
+        // The requesting core returns to guest code right away, the others wait until no request
+        // is left
+        slot.executing = true;
+        request->done = true;
+        serving_request = !requests.empty();
+        request_done.notify_all();
+    }
+
+    std::fill(slots.begin(), slots.end(), CoreSlot{});
+}
+
+void ARM_ThreadPool::CallOnKernelThread(ARM_Interface& core, const std::function<void()>& func) {
+    ASSERT(current_thread_pool == this);
+
+    Request request{core.GetID(), &func};
+    std::unique_lock lock{mutex};
+    slots[request.core_id].executing = false;
+    requests.push_back(&request);
+    request_pending.notify_one();
+    core_stopped.notify_one();
+    request_done.wait(lock, [&request] { return request.done; });
+}
+
+void ARM_ThreadPool::NotifyReschedule(const ARM_Interface& core) {
+    std::lock_guard lock{mutex};
+    slots[core.GetID()].rescheduled = true;
+}
+
+ARM_ThreadPool* ARM_ThreadPool::GetCurrent() {
+    return current_thread_pool;
+}
+
+void ARM_ThreadPool::HaltExecutingCores(std::unique_lock<std::mutex>& lock) {
+    const auto is_executing = [](const CoreSlot& slot) { return slot.executing; };
+    while (std::any_of(slots.begin(), slots.end(), is_executing)) {
+        for (auto& slot : slots) {
+            if (slot.executing) {
+                slot.halted = true;
+                slot.core->PrepareReschedule();
+            }
+        }
+        // A core that is just about to enter the JIT can miss the halt, so it is repeated until
+        // every core has stopped
+        core_stopped.wait_for(lock, std::chrono::microseconds(100));
+    }
+}
+
+void ARM_ThreadPool::WorkerLoop(std::size_t core_id) {
+    const std::string name = fmt::format("CPUCore{}", core_id);
+    Common::SetCurrentThreadName(name.c_str());
+    MicroProfileOnThreadCreate(name.c_str());
+    current_thread_pool = this;
+
+    u64 last_slice_id = 0;
+    std::unique_lock lock{mutex};
+    while (true) {
+        slice_started.wait(lock, [&] { return stop_requested || slice_id != last_slice_id; });
+        if (stop_requested) {
+            break;
+        }
+        last_slice_id = slice_id;
+
+        const auto core = slots[core_id].core;
+        if (!core) {
+            continue;
+        }
+
+        while (true) {
+            request_done.wait(lock, [this] { return !serving_request; });
+            slots[core_id].executing = true;
+
+            lock.unlock();
+            core->Run();
+            lock.lock();
+
+            CoreSlot& slot = slots[core_id];
+            slot.executing = false;
+            core_stopped.notify_one();
+
+            // Only a halt for a request resumes the slice, not one for a reschedule or the end of
+            // the downcount
+            const bool resume = slot.halted && !slot.rescheduled &&
+                                core->GetTimer()->GetDowncount() > 0;
+            slot.halted = false;
+            if (!resume) {
+                break;
+            }
+        }
+
+        if (--running_cores == 0) {
+            request_pending.notify_one();
+        }
+    }
+
+    MicroProfileOnThreadExit();
+}
@@ -0,0 +1,101 @@
+// Copyright 2020 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "common/common_types.h"
+
+class ARM_Interface;
+
+/**
+ * Runs the emulated ARM11 cores on one host thread each for the duration of a slice.
+ *
+ * Only guest code executes in parallel. Everything that leaves JIT-compiled code (SVCs, memory
+ * accesses outside the page table fast path, interpreter fallbacks) is handed back to the thread
+ * that called RunSlice and executed there with the kernel switched to the requesting core. This
+ * keeps the kernel, the HLE services and the GPU single-threaded, and the cores never drift apart
+ * by more than one slice.
+ *
+ * A request may change state the other cores use without locking, such as their code caches or the
+ * page table. The other cores are therefore halted before each request is served, and resume their
+ * slice afterwards.
+ */
+class ARM_ThreadPool {
+public:
+    using SwitchCoreCallback = std::function<void(const std::shared_ptr<ARM_Interface>&)>;
+
+    explicit ARM_ThreadPool(std::size_t num_cores);
+    ~ARM_ThreadPool();
+
+    /**
+     * Runs each of the given cores on its host thread until it has used up its downcount or was
+     * halted, serving their kernel requests on the calling thread in the meantime.
+     * @param cores Cores to run, all of which must share the current page table
+     * @param switch_core Makes the given core the running core before a request is served
+     */
+    void RunSlice(const std::vector<std::shared_ptr<ARM_Interface>>& cores,
+                  const SwitchCoreCallback& switch_core);
+
+    /**
+     * Called from a core's host thread to execute func on the thread running the slice, with the
+     * kernel switched to that core. Blocks until func has returned.
+     */
+    void CallOnKernelThread(ARM_Interface& core, const std::function<void()>& func);
+
+    /**
+     * Marks the given core as halted for a reschedule, so that it doesn't resume its slice after
+     * other cores' requests. Called from the thread running the slice.
+     */
+    void NotifyReschedule(const ARM_Interface& core);
+
+    /// Returns the pool the calling thread belongs to, or nullptr if it is not a core thread
+    static ARM_ThreadPool* GetCurrent();
+
+private:
+    struct Request {
+        std::size_t core_id;
+        const std::function<void()>* func;
+        bool done = false;
+    };
+
+    struct CoreSlot {
+        /// Null if the core doesn't run in this slice
+        std::shared_ptr<ARM_Interface> core;
+        /// Whether the core may be running guest code
+        bool executing = false;
+        /// Halted to let a request be served, resumes its slice afterwards
+        bool halted = false;
+        /// Halted by the kernel for a reschedule, must not resume during this slice
+        bool rescheduled = false;
+    };
+
+    void WorkerLoop(std::size_t core_id);
+
+    /// Halts all cores that are executing guest code and waits for them to stop
+    void HaltExecutingCores(std::unique_lock<std::mutex>& lock);
+
+    std::vector<std::thread> threads;
+
+    std::mutex mutex;
+    std::condition_variable slice_started;
+    std::condition_variable request_pending;
+    std::condition_variable request_done;
+    std::condition_variable core_stopped;
+
+    // All of the following are guarded by mutex
+    std::vector<CoreSlot> slots; ///< Indexed by core id
+    u64 slice_id = 0;
+    std::size_t running_cores = 0;
+    std::deque<Request*> requests;
+    bool serving_request = false;
+    bool stop_requested = false;
+};
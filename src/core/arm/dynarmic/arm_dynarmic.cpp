@@ -2,14 +2,19 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
 #include <cstring>
+#include <type_traits>
 #include <dynarmic/A32/a32.h>
 #include <dynarmic/A32/context.h>
 #include "common/assert.h"
+#include "common/logging/log.h"
 #include "common/microprofile.h"
+#include "core/arm/arm_thread_pool.h"
 #include "core/arm/dynarmic/arm_dynarmic.h"
 #include "core/arm/dynarmic/arm_dynarmic_cp15.h"
 #include "core/arm/dyncom/arm_dyncom_interpreter.h"
+#include "core/arm/dyncom/arm_dyncom_trans.h"
 #include "core/core.h"
 #include "core/core_timing.h"
 #include "core/gdbstub/gdbstub.h"
@@ -72,36 +77,66 @@ private:
 class DynarmicUserCallbacks final : public Dynarmic::A32::UserCallbacks {
 public:
     explicit DynarmicUserCallbacks(ARM_Dynarmic& parent)
-        : parent(parent), svc_context(parent.system), memory(parent.memory) {}
+        : parent(parent), memory(parent.memory) {
+        if (parent.system != nullptr) {
+            svc_context = std::make_unique<Kernel::SVCContext>(*parent.system);
+        }
+    }
     ~DynarmicUserCallbacks() = default;
 
     std::uint8_t MemoryRead8(VAddr vaddr) override {
-        return memory.Read8(vaddr);
+        CheckWatchpoint(vaddr, GDBStub::BreakpointType::Read);
+        return OnKernelThread(vaddr, [&] { return memory.Read8(vaddr); });
     }
     std::uint16_t MemoryRead16(VAddr vaddr) override {
-        return memory.Read16(vaddr);
+        CheckWatchpoint(vaddr, GDBStub::BreakpointType::Read);
+        return OnKernelThread(vaddr, [&] { return memory.Read16(vaddr); });
     }
     std::uint32_t MemoryRead32(VAddr vaddr) override {
-        return memory.Read32(vaddr);
+        CheckWatchpoint(vaddr, GDBStub::BreakpointType::Read);
+        return OnKernelThread(vaddr, [&] { return memory.Read32(vaddr); });
     }
     std::uint64_t MemoryRead64(VAddr vaddr) override {
-        return memory.Read64(vaddr);
+        CheckWatchpoint(vaddr, GDBStub::BreakpointType::Read);
+        return OnKernelThread(vaddr, [&] { return memory.Read64(vaddr); });
     }
 
     void MemoryWrite8(VAddr vaddr, std::uint8_t value) override {
-        memory.Write8(vaddr, value);
+        CheckWatchpoint(vaddr, GDBStub::BreakpointType::Write);
+        OnKernelThread(vaddr, [&] { memory.Write8(vaddr, value); });
     }
     void MemoryWrite16(VAddr vaddr, std::uint16_t value) override {
-        memory.Write16(vaddr, value);
+        CheckWatchpoint(vaddr, GDBStub::BreakpointType::Write);
+        OnKernelThread(vaddr, [&] { memory.Write16(vaddr, value); });
     }
     void MemoryWrite32(VAddr vaddr, std::uint32_t value) override {
-        memory.Write32(vaddr, value);
+        CheckWatchpoint(vaddr, GDBStub::BreakpointType::Write);
+        OnKernelThread(vaddr, [&] { memory.Write32(vaddr, value); });
     }
     void MemoryWrite64(VAddr vaddr, std::uint64_t value) override {
-        memory.Write64(vaddr, value);
+        CheckWatchpoint(vaddr, GDBStub::BreakpointType::Write);
+        OnKernelThread(vaddr, [&] { memory.Write64(vaddr, value); });
+    }
+
+    /**
+     * The pages of watched regions have no pointer in the page table, so the JIT calls back for
+     * every access to them. When a watchpoint is hit, the execution halts once the current block
+     * has finished, and Run reports the trap after the access, like a hardware watchpoint would.
+     */
+    void CheckWatchpoint(VAddr vaddr, GDBStub::BreakpointType type) {
+        if (GDBStub::IsServerEnabled() && GDBStub::CheckBreakpoint(vaddr, type)) {
+            LOG_DEBUG(Debug, "Found memory breakpoint @ {:08x}", vaddr);
+            watchpoint_hit = true;
+            GDBStub::Break(true);
+            parent.jit->HaltExecution();
+        }
     }
 
     void InterpreterFallback(VAddr pc, std::size_t num_instructions) override {
+        OnKernelThread([&] { RunInterpreter(pc, num_instructions); });
+    }
+
+    void RunInterpreter(VAddr pc, std::size_t num_instructions) {
         parent.interpreter_state->Reg = parent.jit->Regs();
         parent.interpreter_state->Cpsr = parent.jit->Cpsr();
         parent.interpreter_state->Reg[15] = pc;
@@ -123,10 +158,15 @@ public:
     }
 
     void CallSVC(std::uint32_t swi) override {
-        svc_context.CallSVC(swi);
+        DEBUG_ASSERT(svc_context != nullptr);
+        OnKernelThread([&] { svc_context->CallSVC(swi); });
     }
 
     void ExceptionRaised(VAddr pc, Dynarmic::A32::Exception exception) override {
+        OnKernelThread([&] { HandleException(pc, exception); });
+    }
+
+    void HandleException(VAddr pc, Dynarmic::A32::Exception exception) {
         switch (exception) {
         case Dynarmic::A32::Exception::UndefinedInstruction:
         case Dynarmic::A32::Exception::UnpredictableInstruction:
@@ -136,7 +176,7 @@ public:
                 parent.jit->HaltExecution();
                 parent.SetPC(pc);
                 Kernel::Thread* thread =
-                    parent.system.Kernel().GetCurrentThreadManager().GetCurrentThread();
+                    parent.system->Kernel().GetCurrentThreadManager().GetCurrentThread();
                 parent.SaveContext(thread->context);
                 GDBStub::Break();
                 GDBStub::SendTrap(thread, 5);
@@ -156,15 +196,49 @@ public:
         return static_cast<u64>(ticks <= 0 ? 0 : ticks);
     }
 
+    /**
+     * When this core runs on an ARM_ThreadPool thread, executes func on the thread that owns the
+     * kernel, otherwise calls it directly.
+     */
+    template <typename Func>
+    auto OnKernelThread(Func&& func) -> decltype(func()) {
+        ARM_ThreadPool* thread_pool = ARM_ThreadPool::GetCurrent();
+        if (thread_pool == nullptr) {
+            return func();
+        }
+        if constexpr (std::is_void_v<decltype(func())>) {
+            thread_pool->CallOnKernelThread(parent, func);
+        } else {
+            decltype(func()) result{};
+            thread_pool->CallOnKernelThread(parent, [&] { result = func(); });
+            return result;
+        }
+    }
+
+    /**
+     * Plain memory can be accessed from any thread, only forward accesses to special pages. The
+     * page table is only changed while all cores of the pool are halted, so it can be read here.
+     */
+    template <typename Func>
+    auto OnKernelThread(VAddr vaddr, Func&& func) -> decltype(func()) {
+        if (parent.current_page_table->pointers[vaddr >> Memory::PAGE_BITS] != nullptr) {
+            return func();
+        }
+        return OnKernelThread(std::forward<Func>(func));
+    }
+
     ARM_Dynarmic& parent;
-    Kernel::SVCContext svc_context;
+    /// Set when a memory access has hit a watchpoint during the current run
+    bool watchpoint_hit = false;
+    /// Only null when there is no system to handle SVCs, i.e. in tests
+    std::unique_ptr<Kernel::SVCContext> svc_context;
     Memory::MemorySystem& memory;
 };
 
 ARM_Dynarmic::ARM_Dynarmic(Core::System* system, Memory::MemorySystem& memory,
                            PrivilegeMode initial_mode, u32 id,
                            std::shared_ptr<Core::Timing::Timer> timer)
-    : ARM_Interface(id, timer), system(*system), memory(memory),
+    : ARM_Interface(id, timer), system(system), memory(memory),
       cb(std::make_unique<DynarmicUserCallbacks>(*this)) {
     interpreter_state = std::make_shared<ARMul_State>(system, memory, initial_mode);
     PageTableChanged();
@@ -179,6 +253,13 @@ void ARM_Dynarmic::Run() {
     MICROPROFILE_SCOPE(ARM_Jit);
 
     jit->Run();
+
+    if (cb->watchpoint_hit) {
+        cb->watchpoint_hit = false;
+        Kernel::Thread* thread = system->Kernel().GetCurrentThreadManager().GetCurrentThread();
+        SaveContext(thread->context);
+        GDBStub::SendTrap(thread, 5);
+    }
 }
 
 void ARM_Dynarmic::Step() {
@@ -271,28 +352,44 @@ void ARM_Dynarmic::PrepareReschedule() {
 
 void ARM_Dynarmic::ClearInstructionCache() {
     // TODO: Clear interpreter cache when appropriate.
-    for (const auto& j : jits) {
-        j.second->ClearCache();
+    for (const auto& cached : jits) {
+        cached.jit->ClearCache();
     }
-    interpreter_state->instruction_cache.clear();
+    ClearTranslationCache();
+    interpreter_state->ClearInstructionCache();
 }
 
 void ARM_Dynarmic::InvalidateCacheRange(u32 start_address, std::size_t length) {
     jit->InvalidateCacheRange(start_address, length);
+    // Blocks translated for interpreter fallbacks may overlap the range as well
+    interpreter_state->InvalidateInstructionCacheRange(start_address, length);
 }
 
 void ARM_Dynarmic::PageTableChanged() {
-    current_page_table = memory.GetCurrentPageTable();
+    Memory::PageTable* page_table = memory.GetCurrentPageTable();
+    if (jit != nullptr && page_table == current_page_table) {
+        return;
+    }
+    current_page_table = page_table;
 
-    auto iter = jits.find(current_page_table);
+    auto iter = std::find_if(jits.begin(), jits.end(), [page_table](const CachedJit& cached) {
+        return cached.page_table == page_table;
+    });
     if (iter != jits.end()) {
-        jit = iter->second.get();
+        jits.splice(jits.begin(), jits, iter);
+        jit = jits.front().jit.get();
         return;
     }
 
-    auto new_jit = MakeJit();
-    jit = new_jit.get();
-    jits.emplace(current_page_table, std::move(new_jit));
+    jits.push_front({page_table, MakeJit()});
+    jit = jits.front().jit.get();
+
+    // The page table can change from within a callback of the previous JIT, which is then still
+    // executing. It is always the second most recently used one, so only the tail is evicted.
+    static_assert(MaxCachedJits >= 2);
+    if (jits.size() > MaxCachedJits) {
+        jits.pop_back();
+    }
 }
 
 std::unique_ptr<Dynarmic::A32::Jit> ARM_Dynarmic::MakeJit() {
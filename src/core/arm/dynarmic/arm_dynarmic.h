@@ -4,7 +4,7 @@
 
 #pragma once
 
-#include <map>
+#include <list>
 #include <memory>
 #include <dynarmic/A32/a32.h>
 #include "common/common_types.h"
@@ -56,13 +56,22 @@ public:
 
 private:
     friend class DynarmicUserCallbacks;
-    Core::System& system;
+    Core::System* system;
     Memory::MemorySystem& memory;
     std::unique_ptr<DynarmicUserCallbacks> cb;
     std::unique_ptr<Dynarmic::A32::Jit> MakeJit();
 
+    struct CachedJit {
+        Memory::PageTable* page_table;
+        std::unique_ptr<Dynarmic::A32::Jit> jit;
+    };
+
+    /// Maximum number of JITs (and thus code caches) kept around for inactive processes
+    static constexpr std::size_t MaxCachedJits = 4;
+
     Dynarmic::A32::Jit* jit = nullptr;
     Memory::PageTable* current_page_table = nullptr;
-    std::map<Memory::PageTable*, std::unique_ptr<Dynarmic::A32::Jit>> jits;
+    /// JITs of the most recently used page tables, most recent first
+    std::list<CachedJit> jits;
     std::shared_ptr<ARMul_State> interpreter_state;
 };
@@ -78,7 +78,7 @@ ARM_DynCom::ARM_DynCom(Core::System* system, Memory::MemorySystem& memory,
 ARM_DynCom::~ARM_DynCom() {}
 
 void ARM_DynCom::Run() {
-    DEBUG_ASSERT(system != nullptr);
+    DEBUG_ASSERT(timer != nullptr);
     ExecuteInstructions(std::max<s64>(timer->GetDowncount(), 0));
 }
 
@@ -87,8 +87,8 @@ void ARM_DynCom::Step() {
 }
 
 void ARM_DynCom::ClearInstructionCache() {
-    state->instruction_cache.clear();
-    trans_cache_buf_top = 0;
+    ClearTranslationCache();
+    state->ClearInstructionCache();
 }
 
 void ARM_DynCom::InvalidateCacheRange(u32, std::size_t) {
@@ -150,7 +150,7 @@ void ARM_DynCom::SetCP15Register(CP15Register reg, u32 value) {
 void ARM_DynCom::ExecuteInstructions(u64 num_instructions) {
     state->NumInstrsToExecute = num_instructions;
     unsigned ticks_executed = InterpreterMainLoop(state.get());
-    if (system != nullptr) {
+    if (timer != nullptr) {
         timer->AddTicks(ticks_executed);
     }
     state->ServeBreak();
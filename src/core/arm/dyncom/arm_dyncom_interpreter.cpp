@@ -927,6 +927,11 @@ unsigned InterpreterMainLoop(ARMul_State* cpu) {
     GDBStub::BreakpointAddress breakpoint_data;
     breakpoint_data.type = GDBStub::BreakpointType::None;
 
+    // The translation cache is shared by all CPUs, blocks cached before it was cleared are gone
+    if (cpu->instruction_cache_generation != trans_cache_buf_generation) {
+        cpu->ClearInstructionCache();
+    }
+
 #undef RM
 #undef RS
 
@@ -1395,6 +1400,23 @@ unsigned InterpreterMainLoop(ARMul_State* cpu) {
     }
 #endif
 
+// Compares are nearly always followed by a conditional branch. Jumping straight to the branch
+// handler executes the pair as one unit, without the poorly predicted indirect jump in between.
+#define GOTO_FUSED_INST(label)                                                                     \
+    GDB_BP_CHECK;                                                                                  \
+    if (num_instrs >= cpu->NumInstrsToExecute)                                                     \
+        goto END;                                                                                  \
+    num_instrs++;                                                                                  \
+    goto label
+
+#define GOTO_NEXT_INST_AFTER_COMPARE                                                               \
+    if (inst_base->idx == BBL_INST_INDEX) {                                                        \
+        GOTO_FUSED_INST(BBL_INST);                                                                 \
+    } else if (inst_base->idx == B_COND_THUMB_INDEX) {                                             \
+        GOTO_FUSED_INST(B_COND_THUMB);                                                             \
+    }                                                                                              \
+    GOTO_NEXT_INST
+
 #define UPDATE_NFLAG(dst) (cpu->NFlag = BIT(dst, 31) ? 1 : 0)
 #define UPDATE_ZFLAG(dst) (cpu->ZFlag = dst ? 0 : 1)
 #define UPDATE_CFLAG_WITH_SC (cpu->CFlag = cpu->shifter_carry_out)
@@ -1627,6 +1649,9 @@ unsigned InterpreterMainLoop(ARMul_State* cpu) {
 
     std::size_t ptr;
 
+    // Link slot of the direct branch that ended the previous block, if any
+    std::size_t* block_link = nullptr;
+
     LOAD_NZCVT;
 DISPATCH : {
     if (!cpu->NirqSig) {
@@ -1640,17 +1665,38 @@ DISPATCH : {
     else
         cpu->Reg[15] &= 0xfffffffc;
 
-    // Find the cached instruction cream, otherwise translate it...
-    auto itr = cpu->instruction_cache.find(cpu->Reg[15]);
-    if (itr != cpu->instruction_cache.end()) {
-        ptr = itr->second;
-    } else if (cpu->NumInstrsToExecute != 1) {
-        if (InterpreterTranslateBlock(cpu, ptr, cpu->Reg[15]) == FETCH_EXCEPTION)
-            goto END;
+    // Follow the link of a direct branch if it has been resolved before. Links live in the
+    // translation cache themselves, so clearing the cache discards them together with the blocks.
+    if (block_link != nullptr && *block_link != UNLINKED_BLOCK) {
+        ptr = *block_link;
     } else {
-        if (InterpreterTranslateSingle(cpu, ptr, cpu->Reg[15]) == FETCH_EXCEPTION)
-            goto END;
+        // Find the cached instruction cream, otherwise translate it...
+        auto itr = cpu->instruction_cache.find(cpu->Reg[15]);
+        if (itr != cpu->instruction_cache.end()) {
+            ptr = itr->second;
+        } else {
+            // The translation cache is only reclaimed once it is full. The branch that led here
+            // is discarded along with the other blocks, so it isn't linked.
+            if (trans_cache_buf_top > TRANS_CACHE_SIZE - TRANS_CACHE_BLOCK_RESERVE) {
+                ClearTranslationCache();
+                cpu->ClearInstructionCache();
+                block_link = nullptr;
+            }
+            if (cpu->NumInstrsToExecute != 1) {
+                if (InterpreterTranslateBlock(cpu, ptr, cpu->Reg[15]) == FETCH_EXCEPTION)
+                    goto END;
+            } else {
+                if (InterpreterTranslateSingle(cpu, ptr, cpu->Reg[15]) == FETCH_EXCEPTION)
+                    goto END;
+            }
+        }
+
+        if (block_link != nullptr) {
+            *block_link = ptr;
+            cpu->resolved_block_links.push_back(block_link);
+        }
     }
+    block_link = nullptr;
 
     // Find breakpoint if one exists within the block
     if (GDBStub::IsConnected()) {
@@ -1761,17 +1807,19 @@ AND_INST : {
     GOTO_NEXT_INST;
 }
 BBL_INST : {
+    bbl_inst* inst_cream = (bbl_inst*)inst_base->component;
     if ((inst_base->cond == ConditionCode::AL) || CondPassed(cpu, inst_base->cond)) {
-        bbl_inst* inst_cream = (bbl_inst*)inst_base->component;
         if (inst_cream->L) {
             LINK_RTN_ADDR;
         }
         SET_PC;
         INC_PC(sizeof(bbl_inst));
+        block_link = &inst_cream->taken_block;
         goto DISPATCH;
     }
     cpu->Reg[15] += cpu->GetInstructionSize();
     INC_PC(sizeof(bbl_inst));
+    block_link = &inst_cream->not_taken_block;
     goto DISPATCH;
 }
 BIC_INST : {
@@ -1919,7 +1967,7 @@ CMN_INST : {
     cpu->Reg[15] += cpu->GetInstructionSize();
     INC_PC(sizeof(cmn_inst));
     FETCH_INST;
-    GOTO_NEXT_INST;
+    GOTO_NEXT_INST_AFTER_COMPARE;
 }
 CMP_INST : {
     if (inst_base->cond == ConditionCode::AL || CondPassed(cpu, inst_base->cond)) {
@@ -1941,7 +1989,7 @@ CMP_INST : {
     cpu->Reg[15] += cpu->GetInstructionSize();
     INC_PC(sizeof(cmp_inst));
     FETCH_INST;
-    GOTO_NEXT_INST;
+    GOTO_NEXT_INST_AFTER_COMPARE;
 }
 CPS_INST : {
     cps_inst* inst_cream = (cps_inst*)inst_base->component;
@@ -3989,7 +4037,7 @@ TEQ_INST : {
     cpu->Reg[15] += cpu->GetInstructionSize();
     INC_PC(sizeof(teq_inst));
     FETCH_INST;
-    GOTO_NEXT_INST;
+    GOTO_NEXT_INST_AFTER_COMPARE;
 }
 TST_INST : {
     if (inst_base->cond == ConditionCode::AL || CondPassed(cpu, inst_base->cond)) {
@@ -4010,7 +4058,7 @@ TST_INST : {
     cpu->Reg[15] += cpu->GetInstructionSize();
     INC_PC(sizeof(tst_inst));
     FETCH_INST;
-    GOTO_NEXT_INST;
+    GOTO_NEXT_INST_AFTER_COMPARE;
 }
 
 UADD8_INST:
@@ -4323,15 +4371,19 @@ B_2_THUMB : {
     b_2_thumb* inst_cream = (b_2_thumb*)inst_base->component;
     cpu->Reg[15] = cpu->Reg[15] + 4 + inst_cream->imm;
     INC_PC(sizeof(b_2_thumb));
+    block_link = &inst_cream->taken_block;
     goto DISPATCH;
 }
 B_COND_THUMB : {
     b_cond_thumb* inst_cream = (b_cond_thumb*)inst_base->component;
 
-    if (CondPassed(cpu, inst_cream->cond))
+    if (CondPassed(cpu, inst_cream->cond)) {
         cpu->Reg[15] = cpu->Reg[15] + 4 + inst_cream->imm;
-    else
+        block_link = &inst_cream->taken_block;
+    } else {
         cpu->Reg[15] += 2;
+        block_link = &inst_cream->not_taken_block;
+    }
 
     INC_PC(sizeof(b_cond_thumb));
     goto DISPATCH;
@@ -8,6 +8,12 @@
 
 char trans_cache_buf[TRANS_CACHE_SIZE];
 size_t trans_cache_buf_top = 0;
+u32 trans_cache_buf_generation = 0;
+
+void ClearTranslationCache() {
+    trans_cache_buf_top = 0;
+    ++trans_cache_buf_generation;
+}
 
 static void* AllocBuffer(std::size_t size) {
     std::size_t start = trans_cache_buf_top;
@@ -99,6 +105,8 @@ static ARM_INST_PTR INTERPRETER_TRANSLATE(bbl)(unsigned int inst, int index) {
 
     inst_cream->L = BIT(inst, 24);
     inst_cream->signed_immed_24 = BIT(inst, 23) ? NEGBRANCH : POSBRANCH;
+    inst_cream->taken_block = UNLINKED_BLOCK;
+    inst_cream->not_taken_block = UNLINKED_BLOCK;
 
     return inst_base;
 }
@@ -1646,6 +1654,7 @@ static ARM_INST_PTR INTERPRETER_TRANSLATE(b_2_thumb)(unsigned int tinst, int ind
     b_2_thumb* inst_cream = (b_2_thumb*)inst_base->component;
 
     inst_cream->imm = ((tinst & 0x3FF) << 1) | ((tinst & (1 << 10)) ? 0xFFFFF800 : 0);
+    inst_cream->taken_block = UNLINKED_BLOCK;
 
     inst_base->idx = index;
     inst_base->br = TransExtData::DIRECT_BRANCH;
@@ -1659,6 +1668,8 @@ static ARM_INST_PTR INTERPRETER_TRANSLATE(b_cond_thumb)(unsigned int tinst, int
 
     inst_cream->imm = (((tinst & 0x7F) << 1) | ((tinst & (1 << 7)) ? 0xFFFFFF00 : 0));
     inst_cream->cond = ((tinst >> 8) & 0xf);
+    inst_cream->taken_block = UNLINKED_BLOCK;
+    inst_cream->not_taken_block = UNLINKED_BLOCK;
     inst_base->idx = index;
     inst_base->br = TransExtData::DIRECT_BRANCH;
 
@@ -1807,7 +1818,7 @@ static ARM_INST_PTR INTERPRETER_TRANSLATE(yield)(unsigned int inst, int index) {
 #include "core/arm/skyeye_common/vfp/vfpinstr.cpp"
 #undef VFP_INTERPRETER_TRANS
 
-const transop_fp_t arm_instruction_trans[] = {
+constexpr transop_fp_t arm_instruction_trans[] = {
     INTERPRETER_TRANSLATE(vmla),
     INTERPRETER_TRANSLATE(vmls),
     INTERPRETER_TRANSLATE(vnmla),
@@ -2016,3 +2027,9 @@ const transop_fp_t arm_instruction_trans[] = {
 };
 
 const std::size_t arm_instruction_trans_len = sizeof(arm_instruction_trans) / sizeof(transop_fp_t);
+
+// The interpreter jumps straight to these handlers after a compare
+static_assert(arm_instruction_trans[BBL_INST_INDEX] == INTERPRETER_TRANSLATE(bbl),
+              "BBL_INST_INDEX doesn't match arm_instruction_trans");
+static_assert(arm_instruction_trans[B_COND_THUMB_INDEX] == INTERPRETER_TRANSLATE(b_cond_thumb),
+              "B_COND_THUMB_INDEX doesn't match arm_instruction_trans");
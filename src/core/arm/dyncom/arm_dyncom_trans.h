@@ -29,6 +29,9 @@ struct arm_inst {
     char component[0];
 };
 
+/// Value of a block link in a direct branch's cream that has not been resolved yet
+constexpr std::size_t UNLINKED_BLOCK = ~static_cast<std::size_t>(0);
+
 struct generic_arm_inst {
     u32 Ra;
     u32 Rm;
@@ -88,6 +91,9 @@ struct bbl_inst {
     int signed_immed_24;
     unsigned int next_addr;
     unsigned int jmp_addr;
+    // Translation cache offsets of the blocks the branch continues at, filled in by the dispatcher
+    std::size_t taken_block;
+    std::size_t not_taken_block;
 };
 
 struct bx_inst {
@@ -451,10 +457,13 @@ struct setend_inst {
 
 struct b_2_thumb {
     unsigned int imm;
+    std::size_t taken_block;
 };
 struct b_cond_thumb {
     unsigned int imm;
     unsigned int cond;
+    std::size_t taken_block;
+    std::size_t not_taken_block;
 };
 
 struct bl_1_thumb {
@@ -493,6 +502,19 @@ typedef ARM_INST_PTR (*transop_fp_t)(unsigned int, int);
 extern const transop_fp_t arm_instruction_trans[];
 extern const std::size_t arm_instruction_trans_len;
 
+// Indices of the direct conditional branches in arm_instruction_trans, the table checks them
+constexpr unsigned int BBL_INST_INDEX = 196;
+constexpr unsigned int B_COND_THUMB_INDEX = 198;
+
 #define TRANS_CACHE_SIZE (64 * 1024 * 2000)
 extern char trans_cache_buf[TRANS_CACHE_SIZE];
 extern std::size_t trans_cache_buf_top;
+/// Incremented whenever trans_cache_buf is cleared, invalidating the cached blocks of all CPUs
+extern u32 trans_cache_buf_generation;
+
+/// Discards all translated blocks, the instruction caches of the CPUs are cleared on their next run
+void ClearTranslationCache();
+
+/// Space a block can take up in trans_cache_buf. Blocks never cross a page, so they hold at most
+/// 2048 Thumb instructions, and no instruction takes up more than 64 bytes.
+constexpr std::size_t TRANS_CACHE_BLOCK_RESERVE = 2048 * 64;
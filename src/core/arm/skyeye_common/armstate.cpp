@@ -5,6 +5,7 @@
 #include <algorithm>
 #include "common/logging/log.h"
 #include "common/swap.h"
+#include "core/arm/dyncom/arm_dyncom_trans.h"
 #include "core/arm/skyeye_common/armstate.h"
 #include "core/arm/skyeye_common/vfp/vfp.h"
 #include "core/core.h"
@@ -597,6 +598,41 @@ void ARMul_State::WriteCP15Register(u32 value, u32 crn, u32 opcode_1, u32 crm, u
     }
 }
 
+void ARMul_State::ClearInstructionCache() {
+    instruction_cache.clear();
+    resolved_block_links.clear();
+    instruction_cache_generation = trans_cache_buf_generation;
+}
+
+void ARMul_State::InvalidateInstructionCacheRange(u32 start_address, std::size_t length) {
+    // The links point into the translation cache, which may have been reused by another CPU
+    if (instruction_cache_generation != trans_cache_buf_generation) {
+        ClearInstructionCache();
+        return;
+    }
+
+    // Blocks end at page boundaries, so only the blocks starting in a page of the range overlap it
+    const u32 first_block = start_address & ~static_cast<u32>(0xFFF);
+    const u64 end_address = static_cast<u64>(start_address) + length;
+    bool erased = false;
+    for (auto itr = instruction_cache.begin(); itr != instruction_cache.end();) {
+        if (itr->first >= first_block && itr->first < end_address) {
+            itr = instruction_cache.erase(itr);
+            erased = true;
+        } else {
+            ++itr;
+        }
+    }
+
+    // The remaining blocks may still branch straight into the discarded ones
+    if (erased) {
+        for (std::size_t* link : resolved_block_links) {
+            *link = UNLINKED_BLOCK;
+        }
+        resolved_block_links.clear();
+    }
+}
+
 void ARMul_State::ServeBreak() {
     if (!GDBStub::IsServerEnabled()) {
         return;
@@ -19,6 +19,7 @@
 
 #include <array>
 #include <unordered_map>
+#include <vector>
 #include "common/common_types.h"
 #include "core/arm/skyeye_common/arm_regformat.h"
 #include "core/gdbstub/gdbstub.h"
@@ -255,6 +256,16 @@ public:
     // TODO(bunnei): Move this cache to a better place - it should be per codeset (likely per
     // process for our purposes), not per ARMul_State (which tracks CPU core state).
     std::unordered_map<u32, std::size_t> instruction_cache;
+    /// Value of trans_cache_buf_generation the blocks in instruction_cache were translated at
+    u32 instruction_cache_generation = 0;
+    /// Links of direct branches in the translation cache that have been resolved to a block
+    std::vector<std::size_t*> resolved_block_links;
+
+    /// Forgets all translated blocks of this CPU, call after clearing the translation cache
+    void ClearInstructionCache();
+
+    /// Forgets the translated blocks which may contain code in the given range
+    void InvalidateInstructionCacheRange(u32 start_address, std::size_t length);
 
 private:
     void ResetMPCoreCP15Registers();
@@ -2,10 +2,14 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
 #include <fstream>
 #include <functional>
 #include <fmt/format.h>
 #include "common/file_util.h"
+#include "common/logging/log.h"
+#include "common/microprofile.h"
+#include "core/cheats/cheat_base.h"
 #include "core/cheats/cheats.h"
 #include "core/cheats/gateway_cheat.h"
 #include "core/core.h"
@@ -15,6 +19,8 @@
 namespace Cheats {
 
 constexpr u64 run_interval_ticks = BASE_CLOCK_RATE_ARM11 / 60;
+/// Number of runs over which the execution times of the cheats are averaged, about one second
+constexpr u32 runs_per_report = 60;
 
 CheatEngine::CheatEngine(Core::System& system_) : system(system_) {
     LoadCheatFile();
@@ -44,6 +50,10 @@ void CheatEngine::RemoveCheat(int index) {
         LOG_ERROR(Core_Cheats, "Invalid index {}", index);
         return;
     }
+    {
+        std::lock_guard times_lock{execution_times_mutex};
+        execution_times.erase(cheats_list[index].get());
+    }
     cheats_list.erase(cheats_list.begin() + index);
 }
 
@@ -53,6 +63,10 @@ void CheatEngine::UpdateCheat(int index, const std::shared_ptr<CheatBase>& new_c
         LOG_ERROR(Core_Cheats, "Invalid index {}", index);
         return;
     }
+    {
+        std::lock_guard times_lock{execution_times_mutex};
+        execution_times.erase(cheats_list[index].get());
+    }
     cheats_list[index] = new_cheat;
 }
 
@@ -95,16 +109,57 @@ void CheatEngine::LoadCheatFile() {
     }
 }
 
+MICROPROFILE_DEFINE(Cheats_Run, "Cheats", "Run Cheats", MP_RGB(255, 160, 0));
+
 void CheatEngine::RunCallback([[maybe_unused]] u64 userdata, int cycles_late) {
     {
+        MICROPROFILE_SCOPE(Cheats_Run);
         std::shared_lock<std::shared_mutex> lock(cheats_list_mutex);
+
+        // The cheats don't depend on each other's code modifications, so the caches only have to
+        // be invalidated once all of them ran. Cheats rewriting the same code every frame then
+        // only invalidate it once.
+        system.BeginCacheInvalidationBatch();
         for (auto& cheat : cheats_list) {
-            if (cheat->IsEnabled()) {
-                cheat->Execute(system);
+            if (!cheat->IsEnabled()) {
+                continue;
             }
+            const auto start = std::chrono::steady_clock::now();
+            cheat->Execute(system);
+            const auto elapsed = std::chrono::steady_clock::now() - start;
+
+            std::lock_guard times_lock{execution_times_mutex};
+            auto& execution_time = execution_times[cheat.get()];
+            execution_time.total += elapsed;
+            execution_time.max = std::max<std::chrono::nanoseconds>(execution_time.max, elapsed);
+            ++execution_time.runs;
+        }
+        system.EndCacheInvalidationBatch();
+
+        std::lock_guard times_lock{execution_times_mutex};
+        if (++runs_since_report == runs_per_report) {
+            ReportExecutionTimes();
         }
     }
     system.CoreTiming().ScheduleEvent(run_interval_ticks - cycles_late, event);
 }
 
+void CheatEngine::ReportExecutionTimes() {
+    for (const auto& cheat : cheats_list) {
+        const auto it = execution_times.find(cheat.get());
+        if (it == execution_times.end()) {
+            continue;
+        }
+        using std::chrono::duration_cast;
+        using std::chrono::microseconds;
+        // Cheats that were enabled, added or changed during the window ran fewer times
+        const auto average = duration_cast<microseconds>(it->second.total) / it->second.runs;
+        LOG_DEBUG(Core_Cheats, "Cheat \"{}\" took {} us per run on average, {} us at most",
+                  cheat->GetName(), average.count(),
+                  duration_cast<microseconds>(it->second.max).count());
+    }
+    execution_times.clear();
+    runs_since_report = 0;
+}
+
 } // namespace Cheats
@@ -4,8 +4,11 @@
 
 #pragma once
 
+#include <chrono>
 #include <memory>
+#include <mutex>
 #include <shared_mutex>
+#include <unordered_map>
 #include <vector>
 #include "common/common_types.h"
 
@@ -35,8 +38,22 @@ public:
 private:
     void LoadCheatFile();
     void RunCallback(u64 userdata, int cycles_late);
+    /// Logs the execution times of the cheats, execution_times_mutex has to be held
+    void ReportExecutionTimes();
+
+    struct ExecutionTime {
+        std::chrono::nanoseconds total{};
+        std::chrono::nanoseconds max{};
+        u32 runs = 0;
+    };
+
     std::vector<std::shared_ptr<CheatBase>> cheats_list;
     mutable std::shared_mutex cheats_list_mutex;
+    /// Time spent in every enabled cheat since the last report
+    std::unordered_map<const CheatBase*, ExecutionTime> execution_times;
+    u32 runs_since_report = 0;
+    /// Guards execution_times and runs_since_report, the cheats only lock the list for reading
+    std::mutex execution_times_mutex;
     Core::TimingEventType* event;
     Core::System& system;
 };
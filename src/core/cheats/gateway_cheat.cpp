@@ -6,6 +6,7 @@
 #include <cmath>
 #include <fstream>
 #include <functional>
+#include <optional>
 #include <string>
 #include <vector>
 #include "common/file_util.h"
@@ -26,20 +27,20 @@ struct State {
     std::size_t loop_back_line = 0;
     std::size_t current_line_nr = 0;
     bool loop_flag = false;
+    std::optional<u32> pad_state;
 };
 
 template <typename T, typename WriteFunction>
-static inline std::enable_if_t<std::is_integral_v<T>> WriteOp(const GatewayCheat::CheatLine& line,
-                                                              const State& state,
-                                                              WriteFunction write_func,
-                                                              Core::System& system) {
+static inline std::enable_if_t<std::is_integral_v<T>> WriteOp(
+    const GatewayCheat::Instruction& line, const State& state, WriteFunction write_func,
+    Core::System& system) {
     u32 addr = line.address + state.offset;
     write_func(addr, static_cast<T>(line.value));
     system.InvalidateCacheRange(addr, sizeof(T));
 }
 
 template <typename T, typename ReadFunction, typename CompareFunc>
-static inline std::enable_if_t<std::is_integral_v<T>> CompOp(const GatewayCheat::CheatLine& line,
+static inline std::enable_if_t<std::is_integral_v<T>> CompOp(const GatewayCheat::Instruction& line,
                                                              State& state, ReadFunction read_func,
                                                              CompareFunc comp) {
     u32 addr = line.address + state.offset;
@@ -49,13 +50,13 @@ static inline std::enable_if_t<std::is_integral_v<T>> CompOp(const GatewayCheat:
     }
 }
 
-static inline void LoadOffsetOp(Memory::MemorySystem& memory, const GatewayCheat::CheatLine& line,
-                                State& state) {
+static inline void LoadOffsetOp(Memory::MemorySystem& memory,
+                                const GatewayCheat::Instruction& line, State& state) {
     u32 addr = line.address + state.offset;
     state.offset = memory.Read32(addr);
 }
 
-static inline void LoopOp(const GatewayCheat::CheatLine& line, State& state) {
+static inline void LoopOp(const GatewayCheat::Instruction& line, State& state) {
     state.loop_flag = state.loop_count < line.value;
     state.loop_count++;
     state.loop_back_line = state.current_line_nr;
@@ -87,21 +88,21 @@ static inline void FullTerminateOp(State& state) {
     }
 }
 
-static inline void SetOffsetOp(const GatewayCheat::CheatLine& line, State& state) {
+static inline void SetOffsetOp(const GatewayCheat::Instruction& line, State& state) {
     state.offset = line.value;
 }
 
-static inline void AddValueOp(const GatewayCheat::CheatLine& line, State& state) {
+static inline void AddValueOp(const GatewayCheat::Instruction& line, State& state) {
     state.reg += line.value;
 }
 
-static inline void SetValueOp(const GatewayCheat::CheatLine& line, State& state) {
+static inline void SetValueOp(const GatewayCheat::Instruction& line, State& state) {
     state.reg = line.value;
 }
 
 template <typename T, typename WriteFunction>
 static inline std::enable_if_t<std::is_integral_v<T>> IncrementiveWriteOp(
-    const GatewayCheat::CheatLine& line, State& state, WriteFunction write_func,
+    const GatewayCheat::Instruction& line, State& state, WriteFunction write_func,
     Core::System& system) {
     u32 addr = line.value + state.offset;
     write_func(addr, static_cast<T>(state.reg));
@@ -110,32 +111,36 @@ static inline std::enable_if_t<std::is_integral_v<T>> IncrementiveWriteOp(
 }
 
 template <typename T, typename ReadFunction>
-static inline std::enable_if_t<std::is_integral_v<T>> LoadOp(const GatewayCheat::CheatLine& line,
+static inline std::enable_if_t<std::is_integral_v<T>> LoadOp(const GatewayCheat::Instruction& line,
                                                              State& state, ReadFunction read_func) {
-
     u32 addr = line.value + state.offset;
     state.reg = read_func(addr);
 }
 
-static inline void AddOffsetOp(const GatewayCheat::CheatLine& line, State& state) {
+static inline void AddOffsetOp(const GatewayCheat::Instruction& line, State& state) {
     state.offset += line.value;
 }
 
-static inline void JokerOp(const GatewayCheat::CheatLine& line, State& state,
+static inline void JokerOp(const GatewayCheat::Instruction& line, State& state,
                            const Core::System& system) {
-    u32 pad_state = system.ServiceManager()
-                        .GetService<Service::HID::Module::Interface>("hid:USER")
-                        ->GetModule()
-                        ->GetState()
-                        .hex;
+    // The pad state can't change while a cheat runs, so only look up the service once
+    if (!state.pad_state) {
+        state.pad_state = system.ServiceManager()
+                              .GetService<Service::HID::Module::Interface>("hid:USER")
+                              ->GetModule()
+                              ->GetState()
+                              .hex;
+    }
+    const u32 pad_state = *state.pad_state;
     bool pressed = (pad_state & line.value) == line.value;
     if (!pressed) {
         state.if_flag++;
     }
 }
 
-static inline void PatchOp(const GatewayCheat::CheatLine& line, State& state, Core::System& system,
-                           const std::vector<GatewayCheat::CheatLine>& cheat_lines) {
+static inline void PatchOp(const GatewayCheat::Instruction& line, State& state,
+                           Core::System& system,
+                           const std::vector<GatewayCheat::Instruction>& program) {
     if (state.if_flag > 0) {
         // Skip over the additional patch lines
         state.current_line_nr += static_cast<int>(std::ceil(line.value / 8.0));
@@ -150,8 +155,8 @@ static inline void PatchOp(const GatewayCheat::CheatLine& line, State& state, Co
     if (num_bytes > 0)
         state.current_line_nr++; // skip over the current code
     while (num_bytes >= 4) {
-        u32 tmp = first ? cheat_lines[state.current_line_nr].first
-                        : cheat_lines[state.current_line_nr].value;
+        u32 tmp = first ? program[state.current_line_nr].first
+                        : program[state.current_line_nr].value;
         if (!first && num_bytes > 4) {
             state.current_line_nr++;
         }
@@ -161,8 +166,8 @@ static inline void PatchOp(const GatewayCheat::CheatLine& line, State& state, Co
         num_bytes -= 4;
     }
     while (num_bytes > 0) {
-        u32 tmp = (first ? cheat_lines[state.current_line_nr].first
-                         : cheat_lines[state.current_line_nr].value) >>
+        u32 tmp = (first ? program[state.current_line_nr].first
+                         : program[state.current_line_nr].value) >>
                   bit_offset;
         system.Memory().Write8(addr, tmp);
         addr += 1;
@@ -202,6 +207,7 @@ GatewayCheat::CheatLine::CheatLine(const std::string& line) {
 GatewayCheat::GatewayCheat(std::string name_, std::vector<CheatLine> cheat_lines_,
                            std::string comments_)
     : name(std::move(name_)), cheat_lines(std::move(cheat_lines_)), comments(std::move(comments_)) {
+    Compile();
 }
 
 GatewayCheat::GatewayCheat(std::string name_, std::string code, std::string comments_)
@@ -216,10 +222,23 @@ GatewayCheat::GatewayCheat(std::string name_, std::string code, std::string comm
             temp_cheat_lines.emplace_back(code_lines[i]);
     }
     cheat_lines = std::move(temp_cheat_lines);
+    Compile();
 }
 
 GatewayCheat::~GatewayCheat() = default;
 
+void GatewayCheat::Compile() {
+    program.clear();
+    program.reserve(cheat_lines.size());
+    for (const auto& line : cheat_lines) {
+        if (line.valid) {
+            program.push_back({line.type, line.address, line.value, line.first});
+        } else {
+            program.push_back({CheatType::Null, 0, 0, 0});
+        }
+    }
+}
+
 void GatewayCheat::Execute(Core::System& system) const {
     State state;
 
@@ -231,9 +250,9 @@ void GatewayCheat::Execute(Core::System& system) const {
     auto Write16 = [&memory](VAddr addr, u16 value) { memory.Write16(addr, value); };
     auto Write32 = [&memory](VAddr addr, u32 value) { memory.Write32(addr, value); };
 
-    for (state.current_line_nr = 0; state.current_line_nr < cheat_lines.size();
+    for (state.current_line_nr = 0; state.current_line_nr < program.size();
          state.current_line_nr++) {
-        auto line = cheat_lines[state.current_line_nr];
+        const Instruction& line = program[state.current_line_nr];
         if (state.if_flag > 0) {
             switch (line.type) {
             case CheatType::GreaterThan32:
@@ -252,7 +271,7 @@ void GatewayCheat::Execute(Core::System& system) const {
                 // EXXXXXXX YYYYYYYY
                 // Copies YYYYYYYY bytes from (current code location + 8) to [XXXXXXXX + offset].
                 // We need to call this here to skip the additional patch lines
-                PatchOp(line, state, system, cheat_lines);
+                PatchOp(line, state, system, program);
                 break;
             case CheatType::Terminator:
                 // D0000000 00000000 - ENDIF
@@ -408,7 +427,7 @@ void GatewayCheat::Execute(Core::System& system) const {
         case CheatType::Patch: {
             // EXXXXXXX YYYYYYYY
             // Copies YYYYYYYY bytes from (current code location + 8) to [XXXXXXXX + offset].
-            PatchOp(line, state, system, cheat_lines);
+            PatchOp(line, state, system, program);
             break;
         }
         }
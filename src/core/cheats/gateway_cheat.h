@@ -6,6 +6,9 @@
 
 #include <atomic>
 #include <memory>
+#include <string>
+#include <vector>
+#include "common/common_types.h"
 #include "core/cheats/cheat_base.h"
 
 namespace Cheats {
@@ -53,6 +56,15 @@ public:
         bool valid = true;
     };
 
+    /// Decoded form of a CheatLine, which is what actually gets executed. Parsing and the original
+    /// text are only needed once, so they are kept out of the instructions to keep them compact.
+    struct Instruction {
+        CheatType type;
+        u32 address;
+        u32 value;
+        u32 first;
+    };
+
     GatewayCheat(std::string name, std::vector<CheatLine> cheat_lines, std::string comments);
     GatewayCheat(std::string name, std::string code, std::string comments);
     ~GatewayCheat();
@@ -78,9 +90,14 @@ public:
     static std::vector<std::unique_ptr<CheatBase>> LoadFile(const std::string& filepath);
 
 private:
+    /// Decodes cheat_lines into program. Instructions keep the index of their line, as loops and
+    /// patches address lines by index.
+    void Compile();
+
     std::atomic<bool> enabled = false;
     const std::string name;
     std::vector<CheatLine> cheat_lines;
+    std::vector<Instruction> program;
     const std::string comments;
 };
 } // namespace Cheats
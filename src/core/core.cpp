@@ -2,14 +2,17 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
 #include <memory>
 #include <utility>
 #include "audio_core/dsp_interface.h"
 #include "audio_core/hle/hle.h"
 #include "audio_core/lle/lle.h"
+#include "common/assert.h"
 #include "common/logging/log.h"
 #include "common/texture.h"
 #include "core/arm/arm_interface.h"
+#include "core/arm/arm_thread_pool.h"
 #ifdef ARCHITECTURE_x86_64
 #include "core/arm/dynarmic/arm_dynarmic.h"
 #endif
@@ -108,6 +111,8 @@ System::ResultStatus System::RunLoop(bool tight_loop) {
         for (auto& cpu_core : cpu_cores) {
             cpu_core->GetTimer()->Advance(max_slice);
         }
+        const bool run_in_parallel = cpu_thread_pool && tight_loop && !GDBStub::IsServerEnabled();
+        std::vector<std::shared_ptr<ARM_Interface>> parallel_cores;
         for (auto& cpu_core : cpu_cores) {
             LOG_TRACE(Core_ARM11, "Core {} running for {} ticks", cpu_core->GetID(),
                       cpu_core->GetTimer()->GetDowncount());
@@ -119,6 +124,8 @@ System::ResultStatus System::RunLoop(bool tight_loop) {
                 LOG_TRACE(Core_ARM11, "Core {} idling", cpu_core->GetID());
                 cpu_core->GetTimer()->Idle();
                 PrepareReschedule();
+            } else if (run_in_parallel) {
+                parallel_cores.push_back(cpu_core);
             } else {
                 if (tight_loop) {
                     cpu_core->Run();
@@ -127,6 +134,9 @@ System::ResultStatus System::RunLoop(bool tight_loop) {
                 }
             }
         }
+        if (!parallel_cores.empty()) {
+            RunCoresInParallel(parallel_cores);
+        }
         timing->AddToGlobalTicks(max_slice);
     }
 
@@ -208,6 +218,9 @@ System::ResultStatus System::Load(Frontend::EmuWindow& emu_window, const std::st
                   static_cast<u32>(load_result));
     }
     perf_stats = std::make_unique<PerfStats>(title_id);
+    if (Settings::values.enable_perf_reports) {
+        perf_reporter = std::make_unique<PerfReporter>(title_id, Settings::values.perf_report_url);
+    }
     custom_tex_cache = std::make_unique<Core::CustomTexCache>();
     if (Settings::values.custom_textures) {
         FileUtil::CreateFullPath(fmt::format("{}textures/{:016X}/",
@@ -223,12 +236,16 @@ System::ResultStatus System::Load(Frontend::EmuWindow& emu_window, const std::st
 
     // Reset counters and set time origin to current frame
     GetAndResetPerfStats();
+    perf_stats->GetAndResetFrameSample(timing->GetGlobalTimeUs());
     perf_stats->BeginSystemFrame();
     return status;
 }
 
 void System::PrepareReschedule() {
     running_core->PrepareReschedule();
+    if (cpu_thread_pool) {
+        cpu_thread_pool->NotifyReschedule(*running_core);
+    }
     reschedule_pending = true;
 }
 
@@ -236,6 +253,83 @@ PerfStats::Results System::GetAndResetPerfStats() {
     return perf_stats->GetAndResetStats(timing->GetGlobalTimeUs());
 }
 
+void System::RunCoresInParallel(const std::vector<std::shared_ptr<ARM_Interface>>& cores) {
+    const auto switch_core = [this](const std::shared_ptr<ARM_Interface>& core) {
+        running_core = core.get();
+        kernel->SetRunningCPU(core);
+    };
+
+    // The memory system only has a single current page table, so cores running threads of
+    // different processes still have to take turns
+    bool same_process = true;
+    std::shared_ptr<Kernel::Process> process;
+    for (const auto& core : cores) {
+        switch_core(core);
+        if (process && kernel->GetCurrentProcess() != process) {
+            same_process = false;
+        }
+        process = kernel->GetCurrentProcess();
+    }
+
+    if (same_process && cores.size() > 1) {
+        cpu_thread_pool->RunSlice(cores, switch_core);
+        return;
+    }
+
+    for (const auto& core : cores) {
+        switch_core(core);
+        core->Run();
+    }
+}
+
+void System::InvalidateCacheRange(u32 start_address, std::size_t length) {
+    if (cache_invalidation_batch_depth > 0) {
+        if (length == 0) {
+            return;
+        }
+        const u32 first_page = start_address >> Memory::PAGE_BITS;
+        const u32 last_page = static_cast<u32>((start_address + length - 1) >> Memory::PAGE_BITS);
+        for (u32 page = first_page; page <= last_page; ++page) {
+            pending_invalidation_pages.push_back(page);
+        }
+        return;
+    }
+
+    for (const auto& cpu : cpu_cores) {
+        cpu->InvalidateCacheRange(start_address, length);
+    }
+}
+
+void System::BeginCacheInvalidationBatch() {
+    ++cache_invalidation_batch_depth;
+}
+
+void System::EndCacheInvalidationBatch() {
+    ASSERT(cache_invalidation_batch_depth > 0);
+    if (--cache_invalidation_batch_depth > 0) {
+        return;
+    }
+
+    auto& pages = pending_invalidation_pages;
+    std::sort(pages.begin(), pages.end());
+    pages.erase(std::unique(pages.begin(), pages.end()), pages.end());
+
+    for (auto run_begin = pages.begin(); run_begin != pages.end();) {
+        auto run_end = run_begin + 1;
+        while (run_end != pages.end() && *run_end == *(run_end - 1) + 1) {
+            ++run_end;
+        }
+        const u32 start_address = *run_begin << Memory::PAGE_BITS;
+        const std::size_t length = static_cast<std::size_t>(run_end - run_begin)
+                                   << Memory::PAGE_BITS;
+        for (const auto& cpu : cpu_cores) {
+            cpu->InvalidateCacheRange(start_address, length);
+        }
+        run_begin = run_end;
+    }
+    pages.clear();
+}
+
 void System::Reschedule() {
     if (!reschedule_pending) {
         return;
@@ -265,6 +359,11 @@ System::ResultStatus System::Init(Frontend::EmuWindow& emu_window, u32 system_mo
 
     if (Settings::values.use_cpu_jit) {
 #ifdef ARCHITECTURE_x86_64
+        // Each core keeps its own exclusive monitor: the pinned Dynarmic has no global monitor for
+        // A32 yet, so exclusive stores of cores on the thread pool aren't arbitrated between them
+        if (Settings::values.use_multi_core && num_cores > 1) {
+            cpu_thread_pool = std::make_unique<ARM_ThreadPool>(num_cores);
+        }
         for (std::size_t i = 0; i < num_cores; ++i) {
             cpu_cores.push_back(
                 std::make_shared<ARM_Dynarmic>(this, *memory, USER32MODE, i, timing->GetTimer(i)));
@@ -275,6 +374,9 @@ System::ResultStatus System::Init(Frontend::EmuWindow& emu_window, u32 system_mo
                 std::make_shared<ARM_DynCom>(this, *memory, USER32MODE, i, timing->GetTimer(i)));
         }
         LOG_WARNING(Core, "CPU JIT requested, but Dynarmic not available");
+        if (Settings::values.use_multi_core) {
+            LOG_WARNING(Core, "Multi-threaded CPU emulation requested, but Dynarmic not available");
+        }
 #endif
     } else {
         for (std::size_t i = 0; i < num_cores; ++i) {
@@ -395,6 +497,10 @@ const VideoDumper::Backend& System::VideoDumper() const {
     return *video_dumper;
 }
 
+RPC::RPCServer& System::RPCServer() {
+    return *rpc_server;
+}
+
 Core::CustomTexCache& System::CustomTexCache() {
     return *custom_tex_cache;
 }
@@ -432,12 +538,14 @@ void System::Shutdown() {
     VideoCore::Shutdown();
     HW::Shutdown();
     telemetry_session.reset();
+    perf_reporter.reset();
     perf_stats.reset();
     rpc_server.reset();
     cheat_engine.reset();
     archive_manager.reset();
     service_manager.reset();
     dsp_core.reset();
+    cpu_thread_pool.reset();
     cpu_cores.clear();
     kernel.reset();
     timing.reset();
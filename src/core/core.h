@@ -6,6 +6,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 #include "common/common_types.h"
 #include "core/custom_tex_cache.h"
 #include "core/frontend/applets/mii_selector.h"
@@ -13,10 +14,12 @@
 #include "core/frontend/image_interface.h"
 #include "core/loader/loader.h"
 #include "core/memory.h"
+#include "core/perf_reporter.h"
 #include "core/perf_stats.h"
 #include "core/telemetry_session.h"
 
 class ARM_Interface;
+class ARM_ThreadPool;
 
 namespace Frontend {
 class EmuWindow;
@@ -182,11 +185,21 @@ public:
         return cpu_cores.size();
     }
 
-    void InvalidateCacheRange(u32 start_address, std::size_t length) {
-        for (const auto& cpu : cpu_cores) {
-            cpu->InvalidateCacheRange(start_address, length);
-        }
-    }
+    /**
+     * Invalidates the code caches of all CPU cores for the given range. Inside a cache
+     * invalidation batch the range is only recorded, see BeginCacheInvalidationBatch.
+     */
+    void InvalidateCacheRange(u32 start_address, std::size_t length);
+
+    /**
+     * Starts collecting the ranges passed to InvalidateCacheRange instead of invalidating them
+     * right away. Meant for HLE code that patches guest memory one word at a time, e.g. CRO
+     * relocation. Batches can be nested.
+     */
+    void BeginCacheInvalidationBatch();
+
+    /// Ends a batch, invalidating every page touched by it once, with adjacent pages merged
+    void EndCacheInvalidationBatch();
 
     /**
      * Gets a reference to the emulated DSP.
@@ -255,7 +268,12 @@ public:
     /// Gets a const reference to the video dumper backend
     const VideoDumper::Backend& VideoDumper() const;
 
+    /// Gets a reference to the scripting RPC server
+    RPC::RPCServer& RPCServer();
+
     std::unique_ptr<PerfStats> perf_stats;
+    /// Periodic performance reports, only created when they are enabled
+    std::unique_ptr<PerfReporter> perf_reporter;
     FrameLimiter frame_limiter;
 
     void SetStatus(ResultStatus new_status, const char* details = nullptr) {
@@ -308,6 +326,12 @@ private:
     /// Reschedule the core emulation
     void Reschedule();
 
+    /**
+     * Runs the given cores for the current slice on the CPU thread pool, or one after another if
+     * they do not share an address space.
+     */
+    void RunCoresInParallel(const std::vector<std::shared_ptr<ARM_Interface>>& cores);
+
     /// AppLoader used to load the current executing application
     std::unique_ptr<Loader::AppLoader> app_loader;
 
@@ -315,6 +339,15 @@ private:
     std::vector<std::shared_ptr<ARM_Interface>> cpu_cores;
     ARM_Interface* running_core = nullptr;
 
+    /// Host threads for the CPU cores, only created when multi-threaded CPU emulation is enabled
+    std::unique_ptr<ARM_ThreadPool> cpu_thread_pool;
+
+    /// Nesting depth of cache invalidation batches
+    u32 cache_invalidation_batch_depth = 0;
+
+    /// Pages recorded by InvalidateCacheRange while a batch is active
+    std::vector<u32> pending_invalidation_pages;
+
     /// DSP core
     std::unique_ptr<AudioCore::DspInterface> dsp_core;
 
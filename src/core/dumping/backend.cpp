@@ -7,8 +7,20 @@
 
 namespace VideoDumper {
 
-VideoFrame::VideoFrame(std::size_t width_, std::size_t height_, u8* data_)
-    : width(width_), height(height_), stride(width * 4), data(data_, data_ + width * height * 4) {}
+VideoFrame::VideoFrame(std::size_t width_, std::size_t height_, u8* data_, PixelFormat format_)
+    : width(width_), height(height_),
+      stride(static_cast<u32>(format_ == PixelFormat::BGRA ? width * 4 : width)), format(format_),
+      data(data_, data_ + GetDataSize(width_, height_, format_)) {}
+
+std::size_t VideoFrame::GetDataSize(std::size_t width, std::size_t height, PixelFormat format) {
+    switch (format) {
+    case PixelFormat::BGRA:
+        return width * height * 4;
+    case PixelFormat::YUV420P:
+        return width * height + 2 * (width / 2) * (height / 2);
+    }
+    return 0;
+}
 
 Backend::~Backend() = default;
 NullBackend::~NullBackend() = default;
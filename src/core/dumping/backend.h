@@ -11,18 +11,31 @@
 #include "core/frontend/framebuffer_layout.h"
 
 namespace VideoDumper {
+
+/// Pixel layouts a video frame can be handed to the backend in
+enum class PixelFormat {
+    BGRA,    ///< Packed BGRA8888
+    YUV420P, ///< Planar 8-bit Y, U and V, chroma subsampled by two in both directions
+};
+
 /**
  * Frame dump data for a single screen
- * data is in RGB888 format, left to right then top to bottom
+ * data is in the given pixel format, left to right then top to bottom. For YUV420P the three
+ * planes are stored back to back and stride is the stride of the Y plane.
  */
 class VideoFrame {
 public:
     std::size_t width;
     std::size_t height;
     u32 stride;
+    PixelFormat format;
     std::vector<u8> data;
 
-    VideoFrame(std::size_t width_ = 0, std::size_t height_ = 0, u8* data_ = nullptr);
+    VideoFrame(std::size_t width_ = 0, std::size_t height_ = 0, u8* data_ = nullptr,
+               PixelFormat format_ = PixelFormat::BGRA);
+
+    /// Size in bytes of a frame with the given dimensions and pixel format
+    static std::size_t GetDataSize(std::size_t width, std::size_t height, PixelFormat format);
 };
 
 class Backend {
@@ -35,6 +48,8 @@ public:
     virtual void StopDumping() = 0;
     virtual bool IsDumping() const = 0;
     virtual Layout::FramebufferLayout GetLayout() const = 0;
+    /// Pixel format video frames should preferably be passed in
+    virtual PixelFormat GetPixelFormat() const = 0;
 };
 
 class NullBackend : public Backend {
@@ -54,5 +69,8 @@ public:
     Layout::FramebufferLayout GetLayout() const override {
         return Layout::FramebufferLayout{};
     }
+    PixelFormat GetPixelFormat() const override {
+        return PixelFormat::BGRA;
+    }
 };
 } // namespace VideoDumper
@@ -185,6 +185,26 @@ void FFmpegVideoStream::ProcessFrame(VideoFrame& frame) {
         LOG_ERROR(Render, "Frame dropped: resolution does not match");
         return;
     }
+
+    if (frame.format == PixelFormat::YUV420P) {
+        // Already converted by the renderer, hand the planes to the encoder directly
+        const std::size_t luma_size = frame.stride * layout.height;
+        const std::size_t chroma_size = (frame.stride / 2) * (layout.height / 2);
+        current_frame->data[0] = frame.data.data();
+        current_frame->data[1] = frame.data.data() + luma_size;
+        current_frame->data[2] = frame.data.data() + luma_size + chroma_size;
+        current_frame->linesize[0] = frame.stride;
+        current_frame->linesize[1] = frame.stride / 2;
+        current_frame->linesize[2] = frame.stride / 2;
+        current_frame->format = AV_PIX_FMT_YUV420P;
+        current_frame->width = layout.width;
+        current_frame->height = layout.height;
+        current_frame->pts = frame_count++;
+
+        SendFrame(current_frame.get());
+        return;
+    }
+
     // Prepare frame
     current_frame->data[0] = frame.data.data();
     current_frame->linesize[0] = frame.stride;
@@ -203,6 +223,15 @@ void FFmpegVideoStream::ProcessFrame(VideoFrame& frame) {
     SendFrame(scaled_frame.get());
 }
 
+PixelFormat FFmpegVideoStream::GetInputPixelFormat() const {
+    // The GPU conversion needs even dimensions to subsample the chroma planes
+    if (codec_context && codec_context->pix_fmt == AV_PIX_FMT_YUV420P && layout.width % 2 == 0 &&
+        layout.height % 2 == 0) {
+        return PixelFormat::YUV420P;
+    }
+    return PixelFormat::BGRA;
+}
+
 FFmpegAudioStream::~FFmpegAudioStream() {
     Free();
 }
@@ -451,6 +480,10 @@ void FFmpegMuxer::ProcessVideoFrame(VideoFrame& frame) {
     video_stream.ProcessFrame(frame);
 }
 
+PixelFormat FFmpegMuxer::GetVideoPixelFormat() const {
+    return video_stream.GetInputPixelFormat();
+}
+
 void FFmpegMuxer::ProcessAudioFrame(const VariableAudioFrame& channel0,
                                     const VariableAudioFrame& channel1) {
     audio_stream.ProcessFrame(channel0, channel1);
@@ -490,18 +523,22 @@ bool FFmpegBackend::StartDumping(const std::string& path, const Layout::Framebuf
     }
 
     video_layout = layout;
+    video_pixel_format = ffmpeg.GetVideoPixelFormat();
 
     if (video_processing_thread.joinable())
         video_processing_thread.join();
     video_processing_thread = std::thread([&] {
-        event1.Set();
         while (true) {
-            event2.Wait();
-            current_buffer = (current_buffer + 1) % 2;
-            next_buffer = (current_buffer + 1) % 2;
-            event1.Set();
+            VideoFrame frame;
+            {
+                std::unique_lock lock{video_frame_queue_mutex};
+                video_frame_available.wait(lock, [this] { return !video_frame_queue.empty(); });
+                frame = std::move(video_frame_queue.front());
+                video_frame_queue.pop_front();
+            }
+            video_frame_consumed.notify_one();
+
             // Process this frame
-            auto& frame = video_frame_buffers[current_buffer];
             if (frame.width == 0 && frame.height == 0) {
                 // An empty frame marks the end of frame data
                 ffmpeg.FlushVideo();
@@ -538,9 +575,13 @@ bool FFmpegBackend::StartDumping(const std::string& path, const Layout::Framebuf
 }
 
 void FFmpegBackend::AddVideoFrame(VideoFrame frame) {
-    event1.Wait();
-    video_frame_buffers[next_buffer] = std::move(frame);
-    event2.Set();
+    {
+        std::unique_lock lock{video_frame_queue_mutex};
+        video_frame_consumed.wait(
+            lock, [this] { return video_frame_queue.size() < MaxQueuedVideoFrames; });
+        video_frame_queue.push_back(std::move(frame));
+    }
+    video_frame_available.notify_one();
 }
 
 void FFmpegBackend::AddAudioFrame(AudioCore::StereoFrame16 frame) {
@@ -582,6 +623,10 @@ Layout::FramebufferLayout FFmpegBackend::GetLayout() const {
     return video_layout;
 }
 
+PixelFormat FFmpegBackend::GetPixelFormat() const {
+    return video_pixel_format;
+}
+
 void FFmpegBackend::EndDumping() {
     LOG_INFO(Render, "Ending frame dumping");
 
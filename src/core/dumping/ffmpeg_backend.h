@@ -6,6 +6,7 @@
 
 #include <atomic>
 #include <condition_variable>
+#include <deque>
 #include <limits>
 #include <memory>
 #include <mutex>
@@ -77,6 +78,9 @@ public:
     void Free();
     void ProcessFrame(VideoFrame& frame);
 
+    /// Pixel format that can be sent to the encoder without a conversion
+    PixelFormat GetInputPixelFormat() const;
+
 private:
     struct SwsContextDeleter {
         void operator()(SwsContext* sws_context) const {
@@ -137,6 +141,7 @@ public:
     bool Init(const std::string& path, const Layout::FramebufferLayout& layout);
     void Free();
     void ProcessVideoFrame(VideoFrame& frame);
+    PixelFormat GetVideoPixelFormat() const;
     void ProcessAudioFrame(const VariableAudioFrame& channel0, const VariableAudioFrame& channel1);
     void FlushVideo();
     void FlushAudio();
@@ -157,7 +162,7 @@ private:
 
 /**
  * FFmpeg video dumping backend.
- * This class implements a double buffer.
+ * Video frames are encoded on a separate thread, fed through a bounded queue.
  */
 class FFmpegBackend : public Backend {
 public:
@@ -170,18 +175,24 @@ public:
     void StopDumping() override;
     bool IsDumping() const override;
     Layout::FramebufferLayout GetLayout() const override;
+    PixelFormat GetPixelFormat() const override;
 
 private:
     void EndDumping();
 
+    /// Number of frames that can be waiting for the encoder before AddVideoFrame blocks
+    static constexpr std::size_t MaxQueuedVideoFrames = 6;
+
     std::atomic_bool is_dumping = false; ///< Whether the backend is currently dumping
 
     FFmpegMuxer ffmpeg{};
 
     Layout::FramebufferLayout video_layout;
-    std::array<VideoFrame, 2> video_frame_buffers;
-    u32 current_buffer = 0, next_buffer = 1;
-    Common::Event event1, event2;
+    PixelFormat video_pixel_format = PixelFormat::BGRA;
+    std::deque<VideoFrame> video_frame_queue;
+    std::mutex video_frame_queue_mutex;
+    std::condition_variable video_frame_available;
+    std::condition_variable video_frame_consumed;
     std::thread video_processing_thread;
 
     std::array<Common::SPSCQueue<VariableAudioFrame>, 2> audio_frame_queues;
@@ -27,9 +27,9 @@ namespace FileSys {
  */
 class FixSizeDiskFile : public DiskFile {
 public:
-    FixSizeDiskFile(FileUtil::IOFile&& file, const Mode& mode,
+    FixSizeDiskFile(FileUtil::IOFile&& file, const std::string& host_path, const Mode& mode,
                     std::unique_ptr<DelayGenerator> delay_generator_)
-        : DiskFile(std::move(file), mode, std::move(delay_generator_)) {
+        : DiskFile(std::move(file), host_path, mode, std::move(delay_generator_)) {
         size = GetSize();
     }
 
@@ -121,7 +121,7 @@ public:
 
         const auto full_path = path_parser.BuildHostPath(mount_point);
 
-        switch (path_parser.GetHostStatus(mount_point)) {
+        switch (metadata_cache.GetHostStatus(path_parser, mount_point)) {
         case PathParser::InvalidMountPoint:
             LOG_CRITICAL(Service_FS, "(unreachable) Invalid mount point {}", mount_point);
             return ERROR_FILE_NOT_FOUND;
@@ -150,8 +150,8 @@ public:
         rwmode.read_flag.Assign(1);
         std::unique_ptr<DelayGenerator> delay_generator =
             std::make_unique<ExtSaveDataDelayGenerator>();
-        auto disk_file =
-            std::make_unique<FixSizeDiskFile>(std::move(file), rwmode, std::move(delay_generator));
+        auto disk_file = std::make_unique<FixSizeDiskFile>(std::move(file), full_path, rwmode,
+                                                           std::move(delay_generator));
         return MakeResult<std::unique_ptr<FileBackend>>(std::move(disk_file));
     }
 
@@ -259,6 +259,7 @@ ResultCode ArchiveFactory_ExtSaveData::Format(const Path& path,
     std::string boss_path = GetExtSaveDataPath(mount_point, corrected_path) + "boss/";
     FileUtil::CreateFullPath(user_path);
     FileUtil::CreateFullPath(boss_path);
+    DiskMetadataCache::Invalidate(GetExtSaveDataPath(mount_point, corrected_path));
 
     // Write the format metadata
     std::string metadata_path = GetExtSaveDataPath(mount_point, corrected_path) + "metadata";
@@ -6,6 +6,7 @@
 #include <memory>
 #include "common/file_util.h"
 #include "common/logging/log.h"
+#include "common/scope_exit.h"
 #include "core/file_sys/archive_sdmc.h"
 #include "core/file_sys/disk_archive.h"
 #include "core/file_sys/errors.h"
@@ -92,6 +93,7 @@ ResultVal<std::unique_ptr<FileBackend>> SDMCArchive::OpenFileBase(const Path& pa
         } else {
             // Create the file
             FileUtil::CreateEmptyFile(full_path);
+            DiskMetadataCache::Invalidate(mount_point);
         }
         break;
     case PathParser::FileFound:
@@ -105,7 +107,8 @@ ResultVal<std::unique_ptr<FileBackend>> SDMCArchive::OpenFileBase(const Path& pa
     }
 
     std::unique_ptr<DelayGenerator> delay_generator = std::make_unique<SDMCDelayGenerator>();
-    auto disk_file = std::make_unique<DiskFile>(std::move(file), mode, std::move(delay_generator));
+    auto disk_file = std::make_unique<DiskFile>(std::move(file), full_path, mode,
+                                                std::move(delay_generator));
     return MakeResult<std::unique_ptr<FileBackend>>(std::move(disk_file));
 }
 
@@ -136,6 +139,7 @@ ResultCode SDMCArchive::DeleteFile(const Path& path) const {
     }
 
     if (FileUtil::Delete(full_path)) {
+        DiskMetadataCache::Invalidate(mount_point);
         return RESULT_SUCCESS;
     }
 
@@ -163,6 +167,7 @@ ResultCode SDMCArchive::RenameFile(const Path& src_path, const Path& dest_path)
     const auto dest_path_full = path_parser_dest.BuildHostPath(mount_point);
 
     if (FileUtil::Rename(src_path_full, dest_path_full)) {
+        DiskMetadataCache::Invalidate(mount_point);
         return RESULT_SUCCESS;
     }
 
@@ -203,6 +208,8 @@ static ResultCode DeleteDirectoryHelper(const Path& path, const std::string& mou
         break; // Expected 'success' case
     }
 
+    // Even a failed recursive delete may have removed some of the contents
+    DiskMetadataCache::Invalidate(mount_point);
     if (deleter(full_path)) {
         return RESULT_SUCCESS;
     }
@@ -248,6 +255,9 @@ ResultCode SDMCArchive::CreateFile(const FileSys::Path& path, u64 size) const {
         break; // Expected 'success' case
     }
 
+    // The file is created below even if it can't be grown to the requested size
+    SCOPE_EXIT({ DiskMetadataCache::Invalidate(mount_point); });
+
     if (size == 0) {
         FileUtil::CreateEmptyFile(full_path);
         return RESULT_SUCCESS;
@@ -292,6 +302,7 @@ ResultCode SDMCArchive::CreateDirectory(const Path& path) const {
     }
 
     if (FileUtil::CreateDir(mount_point + path.AsString())) {
+        DiskMetadataCache::Invalidate(mount_point);
         return RESULT_SUCCESS;
     }
 
@@ -320,6 +331,7 @@ ResultCode SDMCArchive::RenameDirectory(const Path& src_path, const Path& dest_p
     const auto dest_path_full = path_parser_dest.BuildHostPath(mount_point);
 
     if (FileUtil::Rename(src_path_full, dest_path_full)) {
+        DiskMetadataCache::Invalidate(mount_point);
         return RESULT_SUCCESS;
     }
 
@@ -10,6 +10,7 @@
 #include "common/common_types.h"
 #include "common/file_util.h"
 #include "core/file_sys/archive_systemsavedata.h"
+#include "core/file_sys/disk_archive.h"
 #include "core/file_sys/errors.h"
 #include "core/file_sys/savedata_archive.h"
 #include "core/hle/service/fs/archive.h"
@@ -69,6 +70,7 @@ ResultCode ArchiveFactory_SystemSaveData::Format(const Path& path,
     std::string fullpath = GetSystemSaveDataPath(base_path, path);
     FileUtil::DeleteDirRecursively(fullpath);
     FileUtil::CreateFullPath(fullpath);
+    DiskMetadataCache::Invalidate(fullpath);
     return RESULT_SUCCESS;
 }
 
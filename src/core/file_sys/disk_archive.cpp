@@ -5,6 +5,7 @@
 #include <algorithm>
 #include <cstdio>
 #include <memory>
+#include <mutex>
 #include "common/common_types.h"
 #include "common/file_util.h"
 #include "common/logging/log.h"
@@ -16,13 +17,67 @@
 
 namespace FileSys {
 
+using GenerationMap = std::unordered_map<std::string, std::weak_ptr<std::atomic<u64>>>;
+
+/// Returns the generation counter registered for path, creating it if there is none
+static std::shared_ptr<std::atomic<u64>> GetGeneration(GenerationMap& generations,
+                                                       const std::string& path) {
+    if (auto generation = generations[path].lock()) {
+        return generation;
+    }
+
+    // Forget the counters no longer in use, so that the map doesn't grow with every path
+    for (auto it = generations.begin(); it != generations.end();) {
+        it = it->second.expired() ? generations.erase(it) : std::next(it);
+    }
+    auto generation = std::make_shared<std::atomic<u64>>(0);
+    generations[path] = generation;
+    return generation;
+}
+
+/// Returns the write generation shared by the open DiskFiles of the given host path
+static std::shared_ptr<std::atomic<u64>> GetWriteGeneration(const std::string& host_path) {
+    static std::mutex mutex;
+    static GenerationMap generations;
+
+    std::lock_guard lock{mutex};
+    return GetGeneration(generations, host_path);
+}
+
+DiskFile::DiskFile(FileUtil::IOFile&& file_, const std::string& host_path, const Mode& mode_,
+                   std::unique_ptr<DelayGenerator> delay_generator_)
+    : file(new FileUtil::IOFile(std::move(file_))),
+      host_path(host_path), write_generation(GetWriteGeneration(host_path)) {
+    delay_generator = std::move(delay_generator_);
+    mode.hex = mode_.hex;
+}
+
 ResultVal<std::size_t> DiskFile::Read(const u64 offset, const std::size_t length,
                                       u8* buffer) const {
     if (!mode.read_flag)
         return ERROR_INVALID_OPEN_FLAGS;
 
-    file->Seek(offset, SEEK_SET);
-    return MakeResult<std::size_t>(file->ReadBytes(buffer, length));
+    // Savedata is mostly read in small sequential chunks, fetch those from the host in bulk
+    if (length >= ReadAheadSize) {
+        file->Seek(offset, SEEK_SET);
+        return MakeResult<std::size_t>(file->ReadBytes(buffer, length));
+    }
+
+    // The generation is taken before reading, so that a concurrent write leaves it outdated
+    const u64 generation = *write_generation;
+    if (generation != read_ahead_generation || offset < read_ahead_offset ||
+        offset + length > read_ahead_offset + read_ahead.size()) {
+        read_ahead.resize(ReadAheadSize);
+        file->Seek(offset, SEEK_SET);
+        read_ahead.resize(file->ReadBytes(read_ahead.data(), read_ahead.size()));
+        read_ahead_offset = offset;
+        read_ahead_generation = generation;
+    }
+
+    const std::size_t buffered_offset = static_cast<std::size_t>(offset - read_ahead_offset);
+    const std::size_t read = std::min(length, read_ahead.size() - buffered_offset);
+    std::copy_n(read_ahead.begin() + buffered_offset, read, buffer);
+    return MakeResult<std::size_t>(read);
 }
 
 ResultVal<std::size_t> DiskFile::Write(const u64 offset, const std::size_t length, const bool flush,
@@ -30,10 +85,13 @@ ResultVal<std::size_t> DiskFile::Write(const u64 offset, const std::size_t lengt
     if (!mode.write_flag)
         return ERROR_INVALID_OPEN_FLAGS;
 
+    InvalidateReadAhead();
+    DiskMetadataCache::Invalidate(host_path);
     file->Seek(offset, SEEK_SET);
     std::size_t written = file->WriteBytes(buffer, length);
     if (flush)
         file->Flush();
+    ++*write_generation;
     return MakeResult<std::size_t>(written);
 }
 
@@ -42,15 +100,24 @@ u64 DiskFile::GetSize() const {
 }
 
 bool DiskFile::SetSize(const u64 size) const {
+    InvalidateReadAhead();
+    DiskMetadataCache::Invalidate(host_path);
     file->Resize(size);
     file->Flush();
+    ++*write_generation;
     return true;
 }
 
 bool DiskFile::Close() const {
+    InvalidateReadAhead();
     return file->Close();
 }
 
+void DiskFile::InvalidateReadAhead() const {
+    read_ahead.clear();
+    read_ahead_offset = 0;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 DiskDirectory::DiskDirectory(const std::string& path) {
@@ -60,6 +127,10 @@ DiskDirectory::DiskDirectory(const std::string& path) {
     children_iterator = directory.children.begin();
 }
 
+DiskDirectory::DiskDirectory(FileUtil::FSTEntry directory_) : directory(std::move(directory_)) {
+    children_iterator = directory.children.begin();
+}
+
 u32 DiskDirectory::Read(const u32 count, Entry* entries) {
     u32 entries_read = 0;
 
@@ -96,4 +167,73 @@ u32 DiskDirectory::Read(const u32 count, Entry* entries) {
     return entries_read;
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Generations of the archive roots with a metadata cache, bumped on every invalidation below them
+static std::mutex root_generations_mutex;
+static GenerationMap root_generations;
+
+DiskMetadataCache::DiskMetadataCache(const std::string& root) {
+    std::lock_guard lock{root_generations_mutex};
+    root_generation = GetGeneration(root_generations, root);
+    generation = *root_generation;
+}
+
+PathParser::HostStatus DiskMetadataCache::GetHostStatus(const PathParser& path_parser,
+                                                        const std::string& mount_point) {
+    Revalidate();
+
+    const std::string full_path = path_parser.BuildHostPath(mount_point);
+    if (const auto it = host_statuses.find(full_path); it != host_statuses.end()) {
+        return it->second;
+    }
+
+    if (host_statuses.size() >= MaxHostStatuses) {
+        host_statuses.clear();
+    }
+    const auto status = path_parser.GetHostStatus(mount_point);
+    host_statuses.emplace(full_path, status);
+    return status;
+}
+
+FileUtil::FSTEntry DiskMetadataCache::ScanDirectory(const std::string& path) {
+    Revalidate();
+
+    if (const auto it = directories.find(path); it != directories.end()) {
+        return it->second;
+    }
+
+    if (directories.size() >= MaxDirectories) {
+        directories.clear();
+    }
+    FileUtil::FSTEntry directory{};
+    directory.size = FileUtil::ScanDirectoryTree(path, directory);
+    directory.isDirectory = true;
+    return directories.emplace(path, std::move(directory)).first->second;
+}
+
+void DiskMetadataCache::Invalidate(const std::string& host_path) {
+    std::lock_guard lock{root_generations_mutex};
+    for (const auto& [root, weak_generation] : root_generations) {
+        // Changing a path affects the archive containing it, and every archive below it if it is a
+        // directory that was deleted or formatted
+        const std::size_t common_length = std::min(root.size(), host_path.size());
+        if (root.compare(0, common_length, host_path, 0, common_length) != 0) {
+            continue;
+        }
+        if (auto generation = weak_generation.lock()) {
+            ++*generation;
+        }
+    }
+}
+
+void DiskMetadataCache::Revalidate() {
+    const u64 current_generation = *root_generation;
+    if (generation != current_generation) {
+        host_statuses.clear();
+        directories.clear();
+        generation = current_generation;
+    }
+}
+
 } // namespace FileSys
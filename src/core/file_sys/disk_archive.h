@@ -4,15 +4,18 @@
 
 #pragma once
 
+#include <atomic>
 #include <cstddef>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include "common/common_types.h"
 #include "common/file_util.h"
 #include "core/file_sys/archive_backend.h"
 #include "core/file_sys/directory_backend.h"
 #include "core/file_sys/file_backend.h"
+#include "core/file_sys/path_parser.h"
 #include "core/hle/result.h"
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -22,12 +25,12 @@ namespace FileSys {
 
 class DiskFile : public FileBackend {
 public:
-    DiskFile(FileUtil::IOFile&& file_, const Mode& mode_,
-             std::unique_ptr<DelayGenerator> delay_generator_)
-        : file(new FileUtil::IOFile(std::move(file_))) {
-        delay_generator = std::move(delay_generator_);
-        mode.hex = mode_.hex;
-    }
+    /**
+     * @param host_path Path of the file on the host, the read-ahead of all DiskFiles of the same
+     * path is dropped when one of them writes to it
+     */
+    DiskFile(FileUtil::IOFile&& file_, const std::string& host_path, const Mode& mode_,
+             std::unique_ptr<DelayGenerator> delay_generator_);
 
     ResultVal<std::size_t> Read(u64 offset, std::size_t length, u8* buffer) const override;
     ResultVal<std::size_t> Write(u64 offset, std::size_t length, bool flush,
@@ -40,14 +43,33 @@ public:
         file->Flush();
     }
 
+    bool AllowsAsyncRead() const override {
+        return true;
+    }
+
 protected:
     Mode mode;
     std::unique_ptr<FileUtil::IOFile> file;
+
+private:
+    /// Reads smaller than this are served from a read-ahead buffer of this size
+    static constexpr std::size_t ReadAheadSize = 0x20000;
+
+    void InvalidateReadAhead() const;
+
+    std::string host_path;
+    /// Bumped by every write through any DiskFile of this host path
+    std::shared_ptr<std::atomic<u64>> write_generation;
+
+    mutable std::vector<u8> read_ahead; ///< Data of the file starting at read_ahead_offset
+    mutable u64 read_ahead_offset = 0;
+    mutable u64 read_ahead_generation = 0; ///< Value of write_generation read_ahead was filled at
 };
 
 class DiskDirectory : public DirectoryBackend {
 public:
     explicit DiskDirectory(const std::string& path);
+    explicit DiskDirectory(FileUtil::FSTEntry directory_);
 
     ~DiskDirectory() override {
         Close();
@@ -67,4 +89,40 @@ protected:
     std::vector<FileUtil::FSTEntry>::iterator children_iterator;
 };
 
+/**
+ * Remembers the host status of paths and the contents of directories looked up through an archive,
+ * so that games enumerating their save data don't hit the host file system on every request.
+ * Anything changing the host directories that back an archive must call Invalidate.
+ */
+class DiskMetadataCache {
+public:
+    /// @param root Host path of the archive the cache belongs to
+    explicit DiskMetadataCache(const std::string& root);
+
+    /// Same as path_parser.GetHostStatus(mount_point), served from the cache when possible
+    PathParser::HostStatus GetHostStatus(const PathParser& path_parser,
+                                         const std::string& mount_point);
+
+    /// Returns the tree of the directory at the given host path, one level deep
+    FileUtil::FSTEntry ScanDirectory(const std::string& path);
+
+    /**
+     * Drops the contents of the caches of the archives containing host_path or contained in it, so
+     * that host changes are picked up on the next lookup
+     */
+    static void Invalidate(const std::string& host_path);
+
+private:
+    static constexpr std::size_t MaxHostStatuses = 1024;
+    static constexpr std::size_t MaxDirectories = 64;
+
+    void Revalidate();
+
+    /// Shared by the caches of all archives with the same root
+    std::shared_ptr<std::atomic<u64>> root_generation;
+    u64 generation = 0; ///< Value of root_generation the cached contents were looked up at
+    std::unordered_map<std::string, PathParser::HostStatus> host_statuses;
+    std::unordered_map<std::string, FileUtil::FSTEntry> directories;
+};
+
 } // namespace FileSys
@@ -88,6 +88,15 @@ public:
      */
     virtual void Flush() const = 0;
 
+    /**
+     * Whether Read may be called from a host thread other than the emulation thread while no other
+     * operation is in progress on this file. Backends sharing their reader with other files must
+     * return false.
+     */
+    virtual bool AllowsAsyncRead() const {
+        return false;
+    }
+
 protected:
     std::unique_ptr<DelayGenerator> delay_generator;
 };
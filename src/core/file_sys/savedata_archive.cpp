@@ -3,6 +3,7 @@
 // Refer to the license.txt file included.
 
 #include "common/file_util.h"
+#include "common/scope_exit.h"
 #include "core/file_sys/disk_archive.h"
 #include "core/file_sys/errors.h"
 #include "core/file_sys/path_parser.h"
@@ -58,7 +59,7 @@ ResultVal<std::unique_ptr<FileBackend>> SaveDataArchive::OpenFile(const Path& pa
 
     const auto full_path = path_parser.BuildHostPath(mount_point);
 
-    switch (path_parser.GetHostStatus(mount_point)) {
+    switch (metadata_cache.GetHostStatus(path_parser, mount_point)) {
     case PathParser::InvalidMountPoint:
         LOG_CRITICAL(Service_FS, "(unreachable) Invalid mount point {}", mount_point);
         return ERROR_FILE_NOT_FOUND;
@@ -77,6 +78,7 @@ ResultVal<std::unique_ptr<FileBackend>> SaveDataArchive::OpenFile(const Path& pa
         } else {
             // Create the file
             FileUtil::CreateEmptyFile(full_path);
+            DiskMetadataCache::Invalidate(mount_point);
         }
         break;
     case PathParser::FileFound:
@@ -90,7 +92,8 @@ ResultVal<std::unique_ptr<FileBackend>> SaveDataArchive::OpenFile(const Path& pa
     }
 
     std::unique_ptr<DelayGenerator> delay_generator = std::make_unique<SaveDataDelayGenerator>();
-    auto disk_file = std::make_unique<DiskFile>(std::move(file), mode, std::move(delay_generator));
+    auto disk_file = std::make_unique<DiskFile>(std::move(file), full_path, mode,
+                                                std::move(delay_generator));
     return MakeResult<std::unique_ptr<FileBackend>>(std::move(disk_file));
 }
 
@@ -104,7 +107,7 @@ ResultCode SaveDataArchive::DeleteFile(const Path& path) const {
 
     const auto full_path = path_parser.BuildHostPath(mount_point);
 
-    switch (path_parser.GetHostStatus(mount_point)) {
+    switch (metadata_cache.GetHostStatus(path_parser, mount_point)) {
     case PathParser::InvalidMountPoint:
         LOG_CRITICAL(Service_FS, "(unreachable) Invalid mount point {}", mount_point);
         return ERROR_FILE_NOT_FOUND;
@@ -121,6 +124,7 @@ ResultCode SaveDataArchive::DeleteFile(const Path& path) const {
     }
 
     if (FileUtil::Delete(full_path)) {
+        DiskMetadataCache::Invalidate(mount_point);
         return RESULT_SUCCESS;
     }
 
@@ -148,6 +152,7 @@ ResultCode SaveDataArchive::RenameFile(const Path& src_path, const Path& dest_pa
     const auto dest_path_full = path_parser_dest.BuildHostPath(mount_point);
 
     if (FileUtil::Rename(src_path_full, dest_path_full)) {
+        DiskMetadataCache::Invalidate(mount_point);
         return RESULT_SUCCESS;
     }
 
@@ -159,7 +164,7 @@ ResultCode SaveDataArchive::RenameFile(const Path& src_path, const Path& dest_pa
 
 template <typename T>
 static ResultCode DeleteDirectoryHelper(const Path& path, const std::string& mount_point,
-                                        T deleter) {
+                                        DiskMetadataCache& metadata_cache, T deleter) {
     const PathParser path_parser(path);
 
     if (!path_parser.IsValid()) {
@@ -172,7 +177,7 @@ static ResultCode DeleteDirectoryHelper(const Path& path, const std::string& mou
 
     const auto full_path = path_parser.BuildHostPath(mount_point);
 
-    switch (path_parser.GetHostStatus(mount_point)) {
+    switch (metadata_cache.GetHostStatus(path_parser, mount_point)) {
     case PathParser::InvalidMountPoint:
         LOG_CRITICAL(Service_FS, "(unreachable) Invalid mount point {}", mount_point);
         return ERROR_PATH_NOT_FOUND;
@@ -188,6 +193,8 @@ static ResultCode DeleteDirectoryHelper(const Path& path, const std::string& mou
         break; // Expected 'success' case
     }
 
+    // Even a failed recursive delete may have removed some of the contents
+    DiskMetadataCache::Invalidate(mount_point);
     if (deleter(full_path)) {
         return RESULT_SUCCESS;
     }
@@ -197,12 +204,13 @@ static ResultCode DeleteDirectoryHelper(const Path& path, const std::string& mou
 }
 
 ResultCode SaveDataArchive::DeleteDirectory(const Path& path) const {
-    return DeleteDirectoryHelper(path, mount_point, FileUtil::DeleteDir);
+    return DeleteDirectoryHelper(path, mount_point, metadata_cache, FileUtil::DeleteDir);
 }
 
 ResultCode SaveDataArchive::DeleteDirectoryRecursively(const Path& path) const {
-    return DeleteDirectoryHelper(
-        path, mount_point, [](const std::string& p) { return FileUtil::DeleteDirRecursively(p); });
+    return DeleteDirectoryHelper(path, mount_point, metadata_cache, [](const std::string& p) {
+        return FileUtil::DeleteDirRecursively(p);
+    });
 }
 
 ResultCode SaveDataArchive::CreateFile(const FileSys::Path& path, u64 size) const {
@@ -215,7 +223,7 @@ ResultCode SaveDataArchive::CreateFile(const FileSys::Path& path, u64 size) cons
 
     const auto full_path = path_parser.BuildHostPath(mount_point);
 
-    switch (path_parser.GetHostStatus(mount_point)) {
+    switch (metadata_cache.GetHostStatus(path_parser, mount_point)) {
     case PathParser::InvalidMountPoint:
         LOG_CRITICAL(Service_FS, "(unreachable) Invalid mount point {}", mount_point);
         return ERROR_FILE_NOT_FOUND;
@@ -233,6 +241,9 @@ ResultCode SaveDataArchive::CreateFile(const FileSys::Path& path, u64 size) cons
         break; // Expected 'success' case
     }
 
+    // The file is created below even if it can't be grown to the requested size
+    SCOPE_EXIT({ DiskMetadataCache::Invalidate(mount_point); });
+
     if (size == 0) {
         FileUtil::CreateEmptyFile(full_path);
         return RESULT_SUCCESS;
@@ -260,7 +271,7 @@ ResultCode SaveDataArchive::CreateDirectory(const Path& path) const {
 
     const auto full_path = path_parser.BuildHostPath(mount_point);
 
-    switch (path_parser.GetHostStatus(mount_point)) {
+    switch (metadata_cache.GetHostStatus(path_parser, mount_point)) {
     case PathParser::InvalidMountPoint:
         LOG_CRITICAL(Service_FS, "(unreachable) Invalid mount point {}", mount_point);
         return ERROR_FILE_NOT_FOUND;
@@ -279,6 +290,7 @@ ResultCode SaveDataArchive::CreateDirectory(const Path& path) const {
     }
 
     if (FileUtil::CreateDir(mount_point + path.AsString())) {
+        DiskMetadataCache::Invalidate(mount_point);
         return RESULT_SUCCESS;
     }
 
@@ -307,6 +319,7 @@ ResultCode SaveDataArchive::RenameDirectory(const Path& src_path, const Path& de
     const auto dest_path_full = path_parser_dest.BuildHostPath(mount_point);
 
     if (FileUtil::Rename(src_path_full, dest_path_full)) {
+        DiskMetadataCache::Invalidate(mount_point);
         return RESULT_SUCCESS;
     }
 
@@ -327,7 +340,7 @@ ResultVal<std::unique_ptr<DirectoryBackend>> SaveDataArchive::OpenDirectory(
 
     const auto full_path = path_parser.BuildHostPath(mount_point);
 
-    switch (path_parser.GetHostStatus(mount_point)) {
+    switch (metadata_cache.GetHostStatus(path_parser, mount_point)) {
     case PathParser::InvalidMountPoint:
         LOG_CRITICAL(Service_FS, "(unreachable) Invalid mount point {}", mount_point);
         return ERROR_FILE_NOT_FOUND;
@@ -343,7 +356,7 @@ ResultVal<std::unique_ptr<DirectoryBackend>> SaveDataArchive::OpenDirectory(
         break; // Expected 'success' case
     }
 
-    auto directory = std::make_unique<DiskDirectory>(full_path);
+    auto directory = std::make_unique<DiskDirectory>(metadata_cache.ScanDirectory(full_path));
     return MakeResult<std::unique_ptr<DirectoryBackend>>(std::move(directory));
 }
 
@@ -7,6 +7,7 @@
 #include <string>
 #include "core/file_sys/archive_backend.h"
 #include "core/file_sys/directory_backend.h"
+#include "core/file_sys/disk_archive.h"
 #include "core/file_sys/file_backend.h"
 #include "core/hle/result.h"
 
@@ -18,7 +19,8 @@ namespace FileSys {
 /// Archive backend for general save data archive type (SaveData and SystemSaveData)
 class SaveDataArchive : public ArchiveBackend {
 public:
-    explicit SaveDataArchive(const std::string& mount_point_) : mount_point(mount_point_) {}
+    explicit SaveDataArchive(const std::string& mount_point_)
+        : mount_point(mount_point_), metadata_cache(mount_point_) {}
 
     std::string GetName() const override {
         return "SaveDataArchive: " + mount_point;
@@ -38,6 +40,7 @@ public:
 
 protected:
     std::string mount_point;
+    mutable DiskMetadataCache metadata_cache;
 };
 
 } // namespace FileSys
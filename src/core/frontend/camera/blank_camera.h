@@ -18,7 +18,7 @@ public:
     void SetEffect(Service::CAM::Effect) override;
     void SetFormat(Service::CAM::OutputFormat) override;
     void SetFrameRate(Service::CAM::FrameRate frame_rate) override {}
-    std::vector<u16> ReceiveFrame() override;
+    std::shared_ptr<const std::vector<u16>> ReceiveFrame() override;
     bool IsPreviewAvailable() override;
 
 private:
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <memory>
 #include <vector>
 #include "common/common_types.h"
 #include "core/hle/service/cam/cam.h"
@@ -59,9 +60,10 @@ public:
      * Receives a frame from the camera.
      * This function should be only called between a StartCapture call and a StopCapture call.
      * @returns A std::vector<u16> containing pixels. The total size of the vector is width * height
-     *     where width and height are set by a call to SetResolution.
+     *     where width and height are set by a call to SetResolution. The vector is shared, so that
+     *     a camera can hand out the same frame again without copying it.
      */
-    virtual std::vector<u16> ReceiveFrame() = 0;
+    virtual std::shared_ptr<const std::vector<u16>> ReceiveFrame() = 0;
 
     /**
      * Test if the camera is opened successfully and can receive a preview frame. Only used for
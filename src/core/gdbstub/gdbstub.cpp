@@ -41,12 +41,13 @@
 
 namespace GDBStub {
 namespace {
-constexpr int GDB_BUFFER_SIZE = 10000;
+constexpr int GDB_BUFFER_SIZE = 0x20000;
 
 constexpr char GDB_STUB_START = '$';
 constexpr char GDB_STUB_END = '#';
 constexpr char GDB_STUB_ACK = '+';
 constexpr char GDB_STUB_NACK = '-';
+constexpr char GDB_STUB_ESCAPE = '}';
 
 #ifndef SIGTRAP
 constexpr u32 SIGTRAP = 5;
@@ -305,6 +306,51 @@ static void GdbHexToMem(u8* dest, const u8* src, std::size_t len) {
     }
 }
 
+/**
+ * Converts binary data into the escaped form used by the binary memory packets. The characters
+ * that have a special meaning in the protocol are prefixed by '}' and XORed with 0x20, so dest has
+ * to be able to hold twice the length of src.
+ *
+ * @param dest Pointer to buffer to store escaped data.
+ * @param src Pointer to array of u8 bytes.
+ * @param len Length of src array.
+ * @returns the number of bytes written to dest.
+ */
+static std::size_t MemToGdbBinary(u8* dest, const u8* src, std::size_t len) {
+    u8* const start = dest;
+    while (len-- > 0) {
+        const u8 c = *src++;
+        if (c == GDB_STUB_START || c == GDB_STUB_END || c == GDB_STUB_ESCAPE || c == '*') {
+            *dest++ = GDB_STUB_ESCAPE;
+            *dest++ = c ^ 0x20;
+        } else {
+            *dest++ = c;
+        }
+    }
+    return static_cast<std::size_t>(dest - start);
+}
+
+/**
+ * Converts escaped binary data received from the gdb client into the original bytes.
+ *
+ * @param dest Pointer to buffer to store u8 bytes.
+ * @param src Pointer to array of escaped data.
+ * @param len Length of src array.
+ * @returns the number of bytes written to dest.
+ */
+static std::size_t GdbBinaryToMem(u8* dest, const u8* src, std::size_t len) {
+    u8* const start = dest;
+    const u8* const end = src + len;
+    while (src != end) {
+        u8 c = *src++;
+        if (c == GDB_STUB_ESCAPE && src != end) {
+            c = *src++ ^ 0x20;
+        }
+        *dest++ = c;
+    }
+    return static_cast<std::size_t>(dest - start);
+}
+
 /**
  * Convert a u32 into a gdb-formatted hex string.
  *
@@ -424,7 +470,20 @@ static void RemoveBreakpoint(BreakpointType type, VAddr addr) {
             Core::GetCore(i).ClearInstructionCache();
         }
     }
+    const u32 len = bp->second.len;
     p.erase(addr);
+
+    if (type != BreakpointType::Execute) {
+        // The pages may still be covered by other read or write breakpoints
+        auto& process = *Core::System::GetInstance().Kernel().GetCurrentProcess();
+        auto& memory = Core::System::GetInstance().Memory();
+        memory.SetRegionWatched(process, addr, len, false);
+        for (const auto* map : {&breakpoints_read, &breakpoints_write}) {
+            for (const auto& [bp_addr, breakpoint] : *map) {
+                memory.SetRegionWatched(process, bp_addr, breakpoint.len, true);
+            }
+        }
+    }
 }
 
 BreakpointAddress GetNextBreakpointFromAddress(VAddr addr, BreakpointType type) {
@@ -448,12 +507,14 @@ bool CheckBreakpoint(VAddr addr, BreakpointType type) {
         return false;
     }
 
+    // Read and write breakpoints cover a range, so look for the closest one starting at or before
+    // the address
     const BreakpointMap& p = GetBreakpointMap(type);
-    const auto bp = p.find(addr);
-
-    if (bp == p.end()) {
+    auto bp = p.upper_bound(addr);
+    if (bp == p.begin()) {
         return false;
     }
+    --bp;
 
     u32 len = bp->second.len;
 
@@ -496,16 +557,17 @@ static void SendPacket(const char packet) {
  * Send reply to gdb client.
  *
  * @param reply Reply to be sent to client.
+ * @param length Length of the reply, which may contain binary data.
  */
-static void SendReply(const char* reply) {
+static void SendReply(const char* reply, std::size_t length) {
     if (!IsConnected()) {
         return;
     }
 
     memset(command_buffer, 0, sizeof(command_buffer));
 
-    command_length = static_cast<u32>(strlen(reply));
-    if (command_length + 4 > sizeof(command_buffer)) {
+    command_length = static_cast<u32>(length);
+    if (length + 4 > sizeof(command_buffer)) {
         LOG_ERROR(Debug_GDBStub, "command_buffer overflow in SendReply");
         return;
     }
@@ -532,6 +594,67 @@ static void SendReply(const char* reply) {
     }
 }
 
+/**
+ * Send reply to gdb client.
+ *
+ * @param reply Null-terminated reply to be sent to client.
+ */
+static void SendReply(const char* reply) {
+    SendReply(reply, strlen(reply));
+}
+
+/**
+ * Send the part of an object that is requested by a qXfer read to the gdb client.
+ *
+ * @param object The whole object, e.g. an XML document.
+ * @param args The "offset,length" arguments at the end of the query.
+ */
+static void SendXferReply(const std::string& object, const char* args) {
+    const char* length_pos = strchr(args, ',');
+    if (length_pos == nullptr) {
+        return SendReply("E01");
+    }
+    const std::size_t offset = HexToInt(reinterpret_cast<const u8*>(args), length_pos - args);
+    std::size_t length = HexToInt(reinterpret_cast<const u8*>(length_pos + 1),
+                                  strlen(length_pos + 1));
+    if (offset >= object.size()) {
+        return SendReply("l");
+    }
+
+    // 'm' tells that there is more data to read, 'l' that this is the last part
+    length = std::min({length, object.size() - offset, sizeof(command_buffer) - 5});
+    const char type = offset + length < object.size() ? 'm' : 'l';
+    SendReply((type + object.substr(offset, length)).c_str());
+}
+
+/// Builds a memory map of the regions mapped in the current process, for qXfer:memory-map:read.
+static std::string BuildMemoryMap() {
+    std::string memory_map = R"(<?xml version="1.0"?>)"
+                             R"(<!DOCTYPE memory-map PUBLIC "+//IDN gnu.org//DTD GDB Memory Map )"
+                             R"(V1.0//EN" "http://sourceware.org/gdb/gdb-memory-map.dtd">)"
+                             "<memory-map>";
+    const auto& vma_map =
+        Core::System::GetInstance().Kernel().GetCurrentProcess()->vm_manager.vma_map;
+    auto iter = vma_map.begin();
+    while (iter != vma_map.end()) {
+        if (iter->second.type == Kernel::VMAType::Free) {
+            ++iter;
+            continue;
+        }
+
+        // Adjacent mapped regions are merged to keep the map small
+        const VAddr start = iter->second.base;
+        VAddr end = start;
+        for (; iter != vma_map.end() && iter->second.type != Kernel::VMAType::Free; ++iter) {
+            end = iter->second.base + iter->second.size;
+        }
+        memory_map += fmt::format(R"(<memory type="ram" start="0x{:x}" length="0x{:x}"/>)",
+                                  start, end - start);
+    }
+    memory_map += "</memory-map>";
+    return memory_map;
+}
+
 /// Handle query command from gdb client.
 static void HandleQuery() {
     LOG_DEBUG(Debug_GDBStub, "gdb: query '{}'\n", command_buffer + 1);
@@ -541,11 +664,18 @@ static void HandleQuery() {
     if (strcmp(query, "TStatus") == 0) {
         SendReply("T0");
     } else if (strncmp(query, "Supported", strlen("Supported")) == 0) {
-        // PacketSize needs to be large enough for target xml
-        SendReply("PacketSize=2000;qXfer:features:read+;qXfer:threads:read+");
+        // PacketSize needs to be large enough for target xml, and the larger it is the fewer
+        // packets are needed to transfer memory
+        const std::string reply = fmt::format("PacketSize={:x};qXfer:features:read+;"
+                                              "qXfer:threads:read+;qXfer:memory-map:read+;"
+                                              "binary-upload+",
+                                              GDB_BUFFER_SIZE - 4);
+        SendReply(reply.c_str());
     } else if (strncmp(query, "Xfer:features:read:target.xml:",
                        strlen("Xfer:features:read:target.xml:")) == 0) {
         SendReply(target_xml);
+    } else if (strncmp(query, "Xfer:memory-map:read::", strlen("Xfer:memory-map:read::")) == 0) {
+        SendXferReply(BuildMemoryMap(), query + strlen("Xfer:memory-map:read::"));
     } else if (strncmp(query, "fThreadInfo", strlen("fThreadInfo")) == 0) {
         std::string val = "m";
         u32 num_cores = Core::GetNumCores();
@@ -845,9 +975,8 @@ static void ReadMemory() {
 
     LOG_DEBUG(Debug_GDBStub, "gdb: addr: {:08x} len: {:08x}\n", addr, len);
 
-    if (len * 2 > sizeof(reply)) {
-        SendReply("E01");
-    }
+    // The client handles replies that are shorter than requested
+    len = std::min<u32>(len, (sizeof(reply) - 1) / 2);
 
     if (!Memory::IsValidVirtualAddress(*Core::System::GetInstance().Kernel().GetCurrentProcess(),
                                        addr)) {
@@ -863,6 +992,73 @@ static void ReadMemory() {
     SendReply(reinterpret_cast<char*>(reply));
 }
 
+/// Read location in memory specified by gdb client, replying with binary data.
+static void ReadMemoryBinary() {
+    static u8 reply[GDB_BUFFER_SIZE - 4];
+
+    auto start_offset = command_buffer + 1;
+    auto addr_pos = std::find(start_offset, command_buffer + command_length, ',');
+    VAddr addr = HexToInt(start_offset, static_cast<u32>(addr_pos - start_offset));
+
+    start_offset = addr_pos + 1;
+    u32 len =
+        HexToInt(start_offset, static_cast<u32>((command_buffer + command_length) - start_offset));
+
+    LOG_DEBUG(Debug_GDBStub, "gdb: addr: {:08x} len: {:08x}\n", addr, len);
+
+    // Every byte takes up to two characters once escaped, and the reply starts with 'b'
+    len = std::min<u32>(len, (sizeof(reply) - 1) / 2);
+
+    if (!Memory::IsValidVirtualAddress(*Core::System::GetInstance().Kernel().GetCurrentProcess(),
+                                       addr)) {
+        return SendReply("E00");
+    }
+
+    std::vector<u8> data(len);
+    Core::System::GetInstance().Memory().ReadBlock(
+        *Core::System::GetInstance().Kernel().GetCurrentProcess(), addr, data.data(), len);
+
+    reply[0] = 'b';
+    const std::size_t reply_length = 1 + MemToGdbBinary(reply + 1, data.data(), len);
+    SendReply(reinterpret_cast<char*>(reply), reply_length);
+}
+
+/// Modify location in memory with binary data received from the gdb client.
+static void WriteMemoryBinary() {
+    auto start_offset = command_buffer + 1;
+    auto addr_pos = std::find(start_offset, command_buffer + command_length, ',');
+    VAddr addr = HexToInt(start_offset, static_cast<u32>(addr_pos - start_offset));
+
+    start_offset = addr_pos + 1;
+    auto len_pos = std::find(start_offset, command_buffer + command_length, ':');
+    if (len_pos == command_buffer + command_length) {
+        return SendReply("E01");
+    }
+    u32 len = HexToInt(start_offset, static_cast<u32>(len_pos - start_offset));
+
+    // gdb probes for support of the packet with an empty write
+    if (len == 0) {
+        return SendReply("OK");
+    }
+
+    if (!Memory::IsValidVirtualAddress(*Core::System::GetInstance().Kernel().GetCurrentProcess(),
+                                       addr)) {
+        return SendReply("E00");
+    }
+
+    const auto data_pos = len_pos + 1;
+    std::vector<u8> data((command_buffer + command_length) - data_pos);
+    data.resize(GdbBinaryToMem(data.data(), data_pos, data.size()));
+    if (data.size() != len) {
+        return SendReply("E01");
+    }
+
+    Core::System::GetInstance().Memory().WriteBlock(
+        *Core::System::GetInstance().Kernel().GetCurrentProcess(), addr, data.data(), len);
+    Core::GetRunningCore().ClearInstructionCache();
+    SendReply("OK");
+}
+
 /// Modify location in memory with data received from the gdb client.
 static void WriteMemory() {
     auto start_offset = command_buffer + 1;
@@ -945,6 +1141,11 @@ static bool CommitBreakpoint(BreakpointType type, VAddr addr, u32 len) {
             *Core::System::GetInstance().Kernel().GetCurrentProcess(), addr, btrap.data(),
             btrap.size());
         Core::GetRunningCore().ClearInstructionCache();
+    } else {
+        // Route the accesses to the region through the slow path of the JIT, where watchpoints are
+        // checked
+        Core::System::GetInstance().Memory().SetRegionWatched(
+            *Core::System::GetInstance().Kernel().GetCurrentProcess(), addr, len, true);
     }
     p.insert({addr, breakpoint});
 
@@ -1093,6 +1294,12 @@ void HandlePacket() {
     case 'M':
         WriteMemory();
         break;
+    case 'x':
+        ReadMemoryBinary();
+        break;
+    case 'X':
+        WriteMemoryBinary();
+        break;
     case 's':
         Step();
         return;
@@ -3,15 +3,23 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cinttypes>
+#include <condition_variable>
 #include <cstddef>
 #include <cstring>
+#include <mutex>
+#include <thread>
 #include <cryptopp/aes.h>
 #include <cryptopp/modes.h>
+#include <cryptopp/sha.h>
 #include <fmt/format.h>
 #include "common/file_util.h"
 #include "common/logging/log.h"
 #include "common/string_util.h"
+#include "common/thread.h"
+#include "common/threadsafe_queue.h"
 #include "core/core.h"
 #include "core/file_sys/errors.h"
 #include "core/file_sys/ncch_container.h"
@@ -81,6 +89,166 @@ public:
     std::vector<CryptoPP::CBC_Mode<CryptoPP::AES>::Decryption> content;
 };
 
+/**
+ * Decrypts, verifies and writes out the content data of a CIA. Decryption and hashing run on one
+ * host thread and the disk writes on another, so that they overlap with each other and with the
+ * caller reading the CIA. At most MaxChunksInFlight chunks are buffered between the stages.
+ */
+class CIAFile::InstallPipeline {
+public:
+    struct Content {
+        std::string path;
+        u64 size;
+        bool encrypted;
+        std::array<u8, CryptoPP::SHA256::DIGESTSIZE> hash;
+    };
+
+    InstallPipeline(std::vector<Content> contents_, DecryptionState& decryption_state_)
+        : contents(std::move(contents_)), decryption_state(decryption_state_),
+          start_time(std::chrono::steady_clock::now()),
+          decrypt_thread(&InstallPipeline::DecryptLoop, this),
+          write_thread(&InstallPipeline::WriteLoop, this) {}
+
+    ~InstallPipeline() {
+        Finish();
+    }
+
+    /// Queues the next chunk of the given content, blocking while the pipeline is full
+    void Push(u16 index, std::vector<u8> data) {
+        if (data.empty()) {
+            return;
+        }
+        {
+            std::unique_lock lock{mutex};
+            chunk_written.wait(lock, [this] { return chunks_in_flight < MaxChunksInFlight; });
+            ++chunks_in_flight;
+        }
+        decrypt_queue.Push(Chunk{index, std::move(data)});
+    }
+
+    /// Whether writing out any of the content failed so far
+    bool HasFailed() const {
+        return failed;
+    }
+
+    /// Waits for all queued chunks to be written and stops the threads. Returns false on failure.
+    bool Finish() {
+        if (!write_thread.joinable()) {
+            return !failed;
+        }
+
+        // An empty chunk tells the stages to stop once everything before it is done
+        decrypt_queue.Push(Chunk{});
+        decrypt_thread.join();
+        write_thread.join();
+
+        const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                                           start_time);
+        const double written_mib = bytes_written / (1024.0 * 1024.0);
+        LOG_INFO(Service_AM, "Wrote {:.1f} MiB of content in {:.2f} s ({:.1f} MiB/s)",
+                 written_mib, elapsed.count(), written_mib / elapsed.count());
+        return !failed;
+    }
+
+private:
+    static constexpr std::size_t MaxChunksInFlight = 32;
+
+    struct Chunk {
+        u16 index;
+        std::vector<u8> data;
+    };
+
+    void DecryptLoop() {
+        Common::SetCurrentThreadName("CIADecrypt");
+
+        CryptoPP::SHA256 hash;
+        u16 hash_index = 0;
+        u64 hashed = 0;
+        while (true) {
+            Chunk chunk = decrypt_queue.PopWait();
+            if (chunk.data.empty()) {
+                write_queue.Push(std::move(chunk));
+                return;
+            }
+
+            const Content& content = contents[chunk.index];
+            if (content.encrypted) {
+                decryption_state.content[chunk.index].ProcessData(
+                    chunk.data.data(), chunk.data.data(), chunk.data.size());
+            }
+
+            if (chunk.index != hash_index) {
+                hash.Restart();
+                hash_index = chunk.index;
+                hashed = 0;
+            }
+            hash.Update(chunk.data.data(), chunk.data.size());
+            hashed += chunk.data.size();
+            if (hashed == content.size) {
+                std::array<u8, CryptoPP::SHA256::DIGESTSIZE> digest;
+                hash.Final(digest.data());
+                if (digest != content.hash) {
+                    LOG_ERROR(Service_AM, "Hash mismatch in content {}", chunk.index);
+                }
+            }
+
+            write_queue.Push(std::move(chunk));
+        }
+    }
+
+    void WriteLoop() {
+        Common::SetCurrentThreadName("CIAWrite");
+
+        FileUtil::IOFile file;
+        std::size_t file_index = contents.size();
+        while (true) {
+            Chunk chunk = write_queue.PopWait();
+            if (chunk.data.empty()) {
+                return;
+            }
+
+            // Content is received in order, so each file is opened once and then appended to
+            if (chunk.index != file_index) {
+                file = FileUtil::IOFile(contents[chunk.index].path, "wb");
+                file_index = chunk.index;
+            }
+            if (!failed) {
+                if (file.WriteBytes(chunk.data.data(), chunk.data.size()) == chunk.data.size()) {
+                    bytes_written += chunk.data.size();
+                } else {
+                    LOG_ERROR(Service_AM, "Failed to write content {} to {}", chunk.index,
+                              contents[chunk.index].path);
+                    failed = true;
+                }
+            }
+
+            {
+                std::lock_guard lock{mutex};
+                --chunks_in_flight;
+            }
+            chunk_written.notify_one();
+        }
+    }
+
+    const std::vector<Content> contents;
+    DecryptionState& decryption_state;
+
+    std::chrono::steady_clock::time_point start_time;
+    u64 bytes_written = 0; ///< Only accessed by the write thread until it is joined
+    std::atomic<bool> failed{false};
+
+    std::mutex mutex;
+    std::condition_variable chunk_written;
+    std::size_t chunks_in_flight = 0; ///< Guarded by mutex
+
+    Common::SPSCQueue<Chunk> decrypt_queue;
+    Common::SPSCQueue<Chunk> write_queue;
+
+    // Declared last, so that everything the threads use is constructed before they start
+    std::thread decrypt_thread;
+    std::thread write_thread;
+};
+
 CIAFile::CIAFile(Service::FS::MediaType media_type)
     : media_type(media_type), decryption_state(std::make_unique<DecryptionState>()) {}
 
@@ -141,12 +309,27 @@ ResultCode CIAFile::WriteTitleMetadata() {
         }
     }
 
+    std::vector<InstallPipeline::Content> contents(content_count);
+    for (std::size_t i = 0; i < content_count; ++i) {
+        const u16 index = static_cast<u16>(i);
+        contents[i].path = GetTitleContentPath(media_type, tmd.GetTitleID(), index, is_update);
+        contents[i].size = container.GetContentSize(index);
+        contents[i].encrypted =
+            (tmd.GetContentTypeByIndex(index) & FileSys::TMDContentTypeFlag::Encrypted) != 0;
+        contents[i].hash = tmd.GetContentHashByIndex(index);
+    }
+    install_pipeline = std::make_unique<InstallPipeline>(std::move(contents), *decryption_state);
+
     install_state = CIAInstallState::TMDLoaded;
 
     return RESULT_SUCCESS;
 }
 
 ResultVal<std::size_t> CIAFile::WriteContentData(u64 offset, std::size_t length, const u8* buffer) {
+    // Failures of the asynchronous writes surface on the next call
+    if (install_pipeline->HasFailed())
+        return FileSys::ERROR_INSUFFICIENT_SPACE;
+
     // Data is not being buffered, so we have to keep track of how much of each <ID>.app
     // has been written since we might get a written buffer which contains multiple .app
     // contents or only part of a larger .app's contents.
@@ -166,24 +349,10 @@ ResultVal<std::size_t> CIAFile::WriteContentData(u64 offset, std::size_t length,
             // Figure out how much of this content ID we have just recieved/can write out
             u64 available_to_write = std::min(offset_max, range_max) - range_min;
 
-            // Since the incoming TMD has already been written, we can use GetTitleContentPath
-            // to get the content paths to write to.
-            FileSys::TitleMetadata tmd = container.GetTitleMetadata();
-            FileUtil::IOFile file(GetTitleContentPath(media_type, tmd.GetTitleID(), i, is_update),
-                                  content_written[i] ? "ab" : "wb");
-
-            if (!file.IsOpen())
-                return FileSys::ERROR_INSUFFICIENT_SPACE;
-
+            // Decryption and the write to the content path happen on the pipeline's threads
             std::vector<u8> temp(buffer + (range_min - offset),
                                  buffer + (range_min - offset) + available_to_write);
-
-            if (tmd.GetContentTypeByIndex(static_cast<u16>(i)) &
-                FileSys::TMDContentTypeFlag::Encrypted) {
-                decryption_state->content[i].ProcessData(temp.data(), temp.data(), temp.size());
-            }
-
-            file.WriteBytes(temp.data(), temp.size());
+            install_pipeline->Push(static_cast<u16>(i), std::move(temp));
 
             // Keep tabs on how much of this content ID has been written so new range_min
             // values can be calculated.
@@ -277,6 +446,9 @@ bool CIAFile::SetSize(u64 size) const {
 
 bool CIAFile::Close() const {
     bool complete = true;
+    if (install_pipeline && !install_pipeline->Finish())
+        complete = false;
+
     for (std::size_t i = 0; i < container.GetTitleMetadata().GetContentCount(); i++) {
         if (content_written[i] < container.GetContentSize(static_cast<u16>(i)))
             complete = false;
@@ -94,6 +94,9 @@ private:
 
     class DecryptionState;
     std::unique_ptr<DecryptionState> decryption_state;
+
+    class InstallPipeline;
+    std::unique_ptr<InstallPipeline> install_pipeline;
 };
 
 /**
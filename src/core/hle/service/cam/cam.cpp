@@ -17,6 +17,7 @@
 #include "core/hle/service/cam/cam_q.h"
 #include "core/hle/service/cam/cam_s.h"
 #include "core/hle/service/cam/cam_u.h"
+#include "core/hle/service/cam/capture_thread.h"
 #include "core/memory.h"
 #include "core/settings.h"
 
@@ -73,16 +74,33 @@ void Module::PortConfig::Clear() {
     transfer_bytes = 256;
 }
 
-void Module::CompletionEventCallBack(u64 port_id, s64) {
+// interval in us at which the completion event checks again for a frame that is still captured
+constexpr int CAPTURE_POLL_INTERVAL = 1000;
+
+void Module::CompletionEventCallBack(u64 port_id, s64 cycles_late) {
     PortConfig& port = ports[port_id];
     const CameraConfig& camera = cameras[port.camera_id];
-    const auto buffer = port.capture_result.get();
+    const Resolution& resolution = camera.contexts[camera.current_context].resolution;
+
+    // A frame from an earlier receiving process is reused if the new one isn't ready yet, unless
+    // the resolution has changed since. Instead of blocking the emulation thread on the capture,
+    // the completion is postponed until a suitable frame is available.
+    const std::vector<u16>* frame = port.capture_thread->GetLatestFrame();
+    const bool is_frame_usable =
+        frame && (frame->size() == static_cast<std::size_t>(resolution.width * resolution.height) ||
+                  !port.capture_thread->IsBusy());
+    if (!is_frame_usable) {
+        system.CoreTiming().ScheduleEvent(usToCycles(CAPTURE_POLL_INTERVAL) - cycles_late,
+                                          completion_event_callback, port_id);
+        return;
+    }
+    const std::vector<u16>& buffer = *frame;
 
     if (port.is_trimming) {
         u32 trim_width;
         u32 trim_height;
-        const int original_width = camera.contexts[camera.current_context].resolution.width;
-        const int original_height = camera.contexts[camera.current_context].resolution.height;
+        const int original_width = resolution.width;
+        const int original_height = resolution.height;
         if (port.x1 <= port.x0 || port.y1 <= port.y0 || port.x1 > original_width ||
             port.y1 > original_height) {
             LOG_ERROR(Service_CAM, "Invalid trimming coordinates x0={}, y0={}, x1={}, y1={}",
@@ -159,31 +177,25 @@ void Module::StartReceiving(int port_id) {
     PortConfig& port = ports[port_id];
     port.is_receiving = true;
 
-    // launches a capture task asynchronously
-    CameraConfig& camera = cameras[port.camera_id];
-    port.capture_result = std::async(std::launch::async, [&camera, &port, this] {
-        if (is_camera_reload_pending.exchange(false)) {
-            // reinitialize the camera according to new settings
-            camera.impl->StopCapture();
-            LoadCameraImplementation(camera, port.camera_id);
-            camera.impl->StartCapture();
-        }
-        return camera.impl->ReceiveFrame();
-    });
+    // requests a frame from the capture thread, which receives it asynchronously
+    const CameraConfig& camera = cameras[port.camera_id];
+    port.capture_thread->RequestFrame();
 
-    // schedules a completion event according to the frame rate. The event will block on the
-    // capture task if it is not finished within the expected time
+    // schedules a completion event according to the frame rate. The event is postponed if no frame
+    // is available within the expected time
     system.CoreTiming().ScheduleEvent(
         msToCycles(LATENCY_BY_FRAME_RATE[static_cast<int>(camera.frame_rate)]),
         completion_event_callback, port_id);
 }
 
 void Module::CancelReceiving(int port_id) {
+    // The capture thread can still be receiving a frame that the completion event didn't wait for,
+    // so this has to be done even if there is no ongoing receiving process
+    ports[port_id].capture_thread->Wait();
     if (!ports[port_id].is_receiving)
         return;
     LOG_WARNING(Service_CAM, "tries to cancel an ongoing receiving process.");
     system.CoreTiming().UnscheduleEvent(completion_event_callback, port_id);
-    ports[port_id].capture_result.wait();
     ports[port_id].is_receiving = false;
 }
 
@@ -193,6 +205,10 @@ void Module::ActivatePort(int port_id, int camera_id) {
         cameras[ports[port_id].camera_id].impl->StopCapture();
         ports[port_id].is_busy = false;
     }
+    if (ports[port_id].camera_id != camera_id) {
+        // frames of the previous camera must not be reused
+        ports[port_id].capture_thread->DiscardFrames();
+    }
     ports[port_id].is_active = true;
     ports[port_id].camera_id = camera_id;
     system.CoreTiming().ScheduleEvent(
@@ -1090,6 +1106,18 @@ Module::Module(Core::System& system) : system(system) {
         "CAM::VsyncInterruptEventCallBack", [this](u64 userdata, s64 cycles_late) {
             VsyncInterruptEventCallBack(userdata, cycles_late);
         });
+    for (PortConfig& port : ports) {
+        port.capture_thread = std::make_unique<CaptureThread>([this, &port] {
+            CameraConfig& camera = cameras[port.camera_id];
+            if (is_camera_reload_pending.exchange(false)) {
+                // reinitialize the camera according to new settings
+                camera.impl->StopCapture();
+                LoadCameraImplementation(camera, port.camera_id);
+                camera.impl->StartCapture();
+            }
+            return camera.impl->ReceiveFrame();
+        });
+    }
 }
 
 Module::~Module() {
@@ -6,7 +6,6 @@
 
 #include <array>
 #include <deque>
-#include <future>
 #include <memory>
 #include <vector>
 #include "common/common_types.h"
@@ -32,6 +31,8 @@ class Process;
 
 namespace Service::CAM {
 
+class CaptureThread;
+
 enum CameraIndex {
     OuterRightCamera = 0,
     InnerCamera = 1,
@@ -731,7 +732,7 @@ public:
     };
 
 private:
-    void CompletionEventCallBack(u64 port_id, s64);
+    void CompletionEventCallBack(u64 port_id, s64 cycles_late);
     void VsyncInterruptEventCallBack(u64 port_id, s64 cycles_late);
 
     // Starts a receiving process on the specified port. This can only be called when is_busy = true
@@ -792,7 +793,8 @@ private:
 
         std::deque<s64> vsync_timings;
 
-        std::future<std::vector<u16>> capture_result; // will hold the received frame.
+        // receives the frames in the background. The completion event takes the newest one.
+        std::unique_ptr<CaptureThread> capture_thread;
         Kernel::Process* dest_process{nullptr};
         VAddr dest{0};    // the destination address of the receiving process
         u32 dest_size{0}; // the destination size of the receiving process
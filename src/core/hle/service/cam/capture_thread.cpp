@@ -0,0 +1,84 @@
+// Copyright 2020 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <utility>
+#include "common/thread.h"
+#include "core/hle/service/cam/capture_thread.h"
+
+namespace Service::CAM {
+
+CaptureThread::CaptureThread(CaptureFunction capture)
+    : capture(std::move(capture)), thread(&CaptureThread::CaptureLoop, this) {}
+
+CaptureThread::~CaptureThread() {
+    {
+        std::lock_guard lock{mutex};
+        stop_requested = true;
+    }
+    frame_requested_cv.notify_one();
+    thread.join();
+}
+
+void CaptureThread::RequestFrame() {
+    {
+        std::lock_guard lock{mutex};
+        is_frame_requested = true;
+    }
+    frame_requested_cv.notify_one();
+}
+
+const std::vector<u16>* CaptureThread::GetLatestFrame() {
+    std::lock_guard lock{mutex};
+    if (has_new_frame) {
+        std::swap(front_frame, ready_frame);
+        has_new_frame = false;
+    }
+    return front_frame && !front_frame->empty() ? front_frame.get() : nullptr;
+}
+
+bool CaptureThread::IsBusy() {
+    std::lock_guard lock{mutex};
+    return is_frame_requested || is_capturing;
+}
+
+void CaptureThread::Wait() {
+    std::unique_lock lock{mutex};
+    idle_cv.wait(lock, [this] { return !is_frame_requested && !is_capturing; });
+}
+
+void CaptureThread::DiscardFrames() {
+    std::unique_lock lock{mutex};
+    idle_cv.wait(lock, [this] { return !is_frame_requested && !is_capturing; });
+    ready_frame.reset();
+    front_frame.reset();
+    has_new_frame = false;
+}
+
+void CaptureThread::CaptureLoop() {
+    Common::SetCurrentThreadName("CameraCapture");
+
+    std::unique_lock lock{mutex};
+    while (true) {
+        frame_requested_cv.wait(lock, [this] { return stop_requested || is_frame_requested; });
+        if (stop_requested) {
+            break;
+        }
+        is_frame_requested = false;
+        is_capturing = true;
+
+        lock.unlock();
+        Frame frame = capture();
+        lock.lock();
+
+        // The previous ready frame is dropped if the reader didn't take it in time
+        ready_frame = std::move(frame);
+        has_new_frame = true;
+        is_capturing = false;
+        if (!is_frame_requested) {
+            idle_cv.notify_all();
+        }
+    }
+}
+
+} // namespace Service::CAM
@@ -0,0 +1,69 @@
+// Copyright 2020 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "common/common_types.h"
+
+namespace Service::CAM {
+
+/**
+ * Receives camera frames on a dedicated thread, so that the emulation thread never has to wait for
+ * the frontend to convert a frame. Frames are triple buffered: the thread captures into its own
+ * buffer and publishes it as the ready frame, which the reader then swaps into the front buffer.
+ * Frames are shared with the camera and never copied.
+ */
+class CaptureThread {
+public:
+    using Frame = std::shared_ptr<const std::vector<u16>>;
+    using CaptureFunction = std::function<Frame()>;
+
+    explicit CaptureThread(CaptureFunction capture);
+    ~CaptureThread();
+
+    /// Requests a new frame to be captured in the background. Returns immediately.
+    void RequestFrame();
+
+    /**
+     * Gets the newest captured frame. The frame stays valid until the next call to GetLatestFrame
+     * or DiscardFrames.
+     * @returns the newest frame, or nullptr if no frame has been captured yet
+     */
+    const std::vector<u16>* GetLatestFrame();
+
+    /// Returns whether a requested frame hasn't been captured yet.
+    bool IsBusy();
+
+    /// Blocks until all requested frames have been captured.
+    void Wait();
+
+    /// Waits for the pending requests, then drops all captured frames.
+    void DiscardFrames();
+
+private:
+    void CaptureLoop();
+
+    CaptureFunction capture;
+
+    std::mutex mutex;
+    std::condition_variable frame_requested_cv;
+    std::condition_variable idle_cv;
+    bool is_frame_requested = false;
+    bool is_capturing = false;
+    bool stop_requested = false;
+
+    Frame ready_frame;          ///< The newest captured frame, guarded by mutex
+    bool has_new_frame = false; ///< Whether ready_frame hasn't been taken by the reader yet
+    Frame front_frame;          ///< The frame handed out to the reader
+
+    std::thread thread;
+};
+
+} // namespace Service::CAM
@@ -23,6 +23,7 @@
 #include "core/file_sys/archive_selfncch.h"
 #include "core/file_sys/archive_systemsavedata.h"
 #include "core/file_sys/directory_backend.h"
+#include "core/file_sys/disk_archive.h"
 #include "core/file_sys/errors.h"
 #include "core/file_sys/file_backend.h"
 #include "core/hle/result.h"
@@ -259,6 +260,7 @@ ResultCode ArchiveManager::DeleteExtSaveData(MediaType media_type, u32 high, u32
     std::string base_path =
         FileSys::GetExtDataContainerPath(media_type_directory, media_type == MediaType::NAND);
     std::string extsavedata_path = FileSys::GetExtSaveDataPath(base_path, path);
+    FileSys::DiskMetadataCache::Invalidate(extsavedata_path);
     if (FileUtil::Exists(extsavedata_path) && !FileUtil::DeleteDirRecursively(extsavedata_path))
         return ResultCode(-1); // TODO(Subv): Find the right error code
     return RESULT_SUCCESS;
@@ -271,6 +273,7 @@ ResultCode ArchiveManager::DeleteSystemSaveData(u32 high, u32 low) {
     std::string nand_directory = FileUtil::GetUserPath(FileUtil::UserPath::NANDDir);
     std::string base_path = FileSys::GetSystemSaveDataContainerPath(nand_directory);
     std::string systemsavedata_path = FileSys::GetSystemSaveDataPath(base_path, path);
+    FileSys::DiskMetadataCache::Invalidate(systemsavedata_path);
     if (!FileUtil::DeleteDirRecursively(systemsavedata_path))
         return ResultCode(-1); // TODO(Subv): Find the right error code
     return RESULT_SUCCESS;
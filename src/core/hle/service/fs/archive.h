@@ -14,6 +14,7 @@
 #include "core/hle/result.h"
 #include "core/hle/service/fs/directory.h"
 #include "core/hle/service/fs/file.h"
+#include "core/hle/service/fs/io_thread_pool.h"
 
 /// The unique system identifier hash, also known as ID0
 static constexpr char SYSTEM_ID[]{"00000000000000000000000000000000"};
@@ -233,7 +234,15 @@ public:
     /// Registers a new NCCH file with the SelfNCCH archive factory
     void RegisterSelfNCCH(Loader::AppLoader& app_loader);
 
+    /// Host threads for the file accesses that don't have to block the emulation
+    IOThreadPool& GetIOThreadPool() {
+        return io_thread_pool;
+    }
+
 private:
+    /// Savedata is accessed by few files at a time, and host storage gains little from more
+    static constexpr std::size_t NumIOThreads = 2;
+
     Core::System& system;
 
     /**
@@ -260,6 +269,8 @@ private:
      */
     std::unordered_map<ArchiveHandle, std::unique_ptr<ArchiveBackend>> handle_map;
     ArchiveHandle next_handle = 1;
+
+    IOThreadPool io_thread_pool{NumIOThreads};
 };
 
 } // namespace Service::FS
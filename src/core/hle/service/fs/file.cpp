@@ -2,6 +2,8 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <memory>
+#include <vector>
 #include "common/logging/log.h"
 #include "core/core.h"
 #include "core/file_sys/errors.h"
@@ -11,6 +13,7 @@
 #include "core/hle/kernel/client_session.h"
 #include "core/hle/kernel/event.h"
 #include "core/hle/kernel/server_session.h"
+#include "core/hle/service/fs/archive.h"
 #include "core/hle/service/fs/file.h"
 
 namespace Service::FS {
@@ -33,6 +36,16 @@ File::File(Core::System& system, std::unique_ptr<FileSys::FileBackend>&& backend
     RegisterHandlers(functions);
 }
 
+File::~File() {
+    WaitForPendingRead();
+}
+
+void File::WaitForPendingRead() {
+    if (pending_read.valid()) {
+        pending_read.wait();
+    }
+}
+
 void File::Read(Kernel::HLERequestContext& ctx) {
     IPC::RequestParser rp(ctx, 0x0802, 3, 2);
     u64 offset = rp.Pop<u64>();
@@ -50,12 +63,45 @@ void File::Read(Kernel::HLERequestContext& ctx) {
     // This file session might have a specific offset from where to start reading, apply it.
     offset += file->offset;
 
+    WaitForPendingRead();
+
     if (offset + length > backend->GetSize()) {
         LOG_ERROR(Service_FS,
                   "Reading from out of bounds offset=0x{:x} length=0x{:08X} file_size=0x{:x}",
                   offset, length, backend->GetSize());
     }
 
+    std::chrono::nanoseconds read_timeout_ns{backend->GetReadDelayNs(length)};
+
+    if (backend->AllowsAsyncRead()) {
+        // Let the host read the file while the client sleeps for the emulated read delay, so
+        // emulation only stalls if the host storage is slower than the console's.
+        auto data = std::make_shared<std::vector<u8>>(length);
+        pending_read = system.ArchiveManager().GetIOThreadPool().Submit(
+            [backend = backend.get(), offset, data] {
+                return backend->Read(offset, data->size(), data->data());
+            });
+
+        ctx.SleepClientThread(
+            "file::read", read_timeout_ns,
+            [read = pending_read, data, buffer](std::shared_ptr<Kernel::Thread> /*thread*/,
+                                                 Kernel::HLERequestContext& ctx,
+                                                 Kernel::ThreadWakeupReason /*reason*/) mutable {
+                const ResultVal<std::size_t> result = read.get();
+                IPC::RequestBuilder rb(ctx, 0x0802, 2, 2);
+                if (result.Failed()) {
+                    rb.Push(result.Code());
+                    rb.Push<u32>(0);
+                } else {
+                    buffer.Write(data->data(), 0, *result);
+                    rb.Push(RESULT_SUCCESS);
+                    rb.Push<u32>(static_cast<u32>(*result));
+                }
+                rb.PushMappedBuffer(buffer);
+            });
+        return;
+    }
+
     IPC::RequestBuilder rb = rp.MakeBuilder(2, 2);
 
     std::vector<u8> data(length);
@@ -70,7 +116,6 @@ void File::Read(Kernel::HLERequestContext& ctx) {
     }
     rb.PushMappedBuffer(buffer);
 
-    std::chrono::nanoseconds read_timeout_ns{backend->GetReadDelayNs(length)};
     ctx.SleepClientThread("file::read", read_timeout_ns,
                           [](std::shared_ptr<Kernel::Thread> /*thread*/,
                              Kernel::HLERequestContext& /*ctx*/,
@@ -100,6 +145,7 @@ void File::Write(Kernel::HLERequestContext& ctx) {
         return;
     }
 
+    WaitForPendingRead();
     std::vector<u8> data(length);
     buffer.Read(data.data(), 0, data.size());
     ResultVal<std::size_t> written = backend->Write(offset, data.size(), flush != 0, data.data());
@@ -141,6 +187,7 @@ void File::SetSize(Kernel::HLERequestContext& ctx) {
         return;
     }
 
+    WaitForPendingRead();
     file->size = size;
     backend->SetSize(size);
     rb.Push(RESULT_SUCCESS);
@@ -154,6 +201,7 @@ void File::Close(Kernel::HLERequestContext& ctx) {
         LOG_WARNING(Service_FS, "Closing File backend but {} clients still connected",
                     connected_sessions.size());
 
+    WaitForPendingRead();
     backend->Close();
     IPC::RequestBuilder rb = rp.MakeBuilder(1, 0);
     rb.Push(RESULT_SUCCESS);
@@ -172,6 +220,7 @@ void File::Flush(Kernel::HLERequestContext& ctx) {
         return;
     }
 
+    WaitForPendingRead();
     backend->Flush();
     rb.Push(RESULT_SUCCESS);
 }
@@ -207,6 +256,7 @@ void File::OpenLinkFile(Kernel::HLERequestContext& ctx) {
     FileSessionSlot* slot = GetSessionData(server);
     const FileSessionSlot* original_file = GetSessionData(ctx.Session());
 
+    WaitForPendingRead();
     slot->priority = original_file->priority;
     slot->offset = 0;
     slot->size = backend->GetSize();
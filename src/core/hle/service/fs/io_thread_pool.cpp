@@ -0,0 +1,57 @@
+// Copyright 2020 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include "common/thread.h"
+#include "core/hle/service/fs/io_thread_pool.h"
+
+namespace Service::FS {
+
+IOThreadPool::IOThreadPool(std::size_t num_threads) : num_threads(num_threads) {}
+
+IOThreadPool::~IOThreadPool() {
+    {
+        std::lock_guard lock{mutex};
+        stop_requested = true;
+    }
+    job_queued.notify_all();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+void IOThreadPool::Enqueue(std::function<void()> job) {
+    {
+        std::lock_guard lock{mutex};
+        if (threads.empty()) {
+            threads.reserve(num_threads);
+            for (std::size_t i = 0; i < num_threads; ++i) {
+                threads.emplace_back(&IOThreadPool::WorkerLoop, this);
+            }
+        }
+        jobs.push_back(std::move(job));
+    }
+    job_queued.notify_one();
+}
+
+void IOThreadPool::WorkerLoop() {
+    Common::SetCurrentThreadName("FileIO");
+
+    std::unique_lock lock{mutex};
+    while (true) {
+        // Jobs queued before the stop request are still run, their submitters wait for them
+        job_queued.wait(lock, [this] { return stop_requested || !jobs.empty(); });
+        if (jobs.empty()) {
+            break;
+        }
+
+        auto job = std::move(jobs.front());
+        jobs.pop_front();
+
+        lock.unlock();
+        job();
+        lock.lock();
+    }
+}
+
+} // namespace Service::FS
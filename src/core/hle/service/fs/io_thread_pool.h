@@ -0,0 +1,54 @@
+// Copyright 2020 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace Service::FS {
+
+/**
+ * Host threads that access the files of the FS service, so that slow host storage doesn't stall
+ * the emulation. The threads are only started once the first job is submitted.
+ */
+class IOThreadPool {
+public:
+    explicit IOThreadPool(std::size_t num_threads);
+
+    /// Finishes the queued jobs, so that the futures of their submitters become ready
+    ~IOThreadPool();
+
+    /// Queues func to run on a host thread, the returned future becomes ready with its result
+    template <typename Func>
+    auto Submit(Func&& func) -> std::shared_future<decltype(func())> {
+        using Task = std::packaged_task<decltype(func())()>;
+        auto task = std::make_shared<Task>(std::forward<Func>(func));
+        auto future = task->get_future().share();
+        Enqueue([task] { (*task)(); });
+        return future;
+    }
+
+private:
+    void Enqueue(std::function<void()> job);
+    void WorkerLoop();
+
+    const std::size_t num_threads;
+    std::vector<std::thread> threads;
+
+    std::mutex mutex;
+    std::condition_variable job_queued;
+    std::deque<std::function<void()>> jobs; ///< Guarded by mutex
+    bool stop_requested = false;            ///< Guarded by mutex
+};
+
+} // namespace Service::FS
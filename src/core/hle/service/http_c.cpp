@@ -2,17 +2,23 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
 #include <atomic>
+#include <unordered_map>
+#include <fmt/format.h>
 #ifdef ENABLE_WEB_SERVICE
 #include <LUrlParser.h>
 #endif
 #include <cryptopp/aes.h>
 #include <cryptopp/modes.h>
 #include "common/assert.h"
+#include "common/thread.h"
 #include "core/core.h"
+#include "core/core_timing.h"
 #include "core/file_sys/archive_ncch.h"
 #include "core/file_sys/file_backend.h"
 #include "core/hle/ipc_helpers.h"
+#include "core/hle/kernel/event.h"
 #include "core/hle/kernel/ipc.h"
 #include "core/hle/romfs.h"
 #include "core/hle/service/fs/archive.h"
@@ -52,47 +58,64 @@ const ResultCode ERROR_WRONG_CERT_HANDLE = // 0xD8A0A0C9
     ResultCode(201, ErrorModule::HTTP, ErrorSummary::InvalidState, ErrorLevel::Permanent);
 const ResultCode ERROR_CERT_ALREADY_SET = // 0xD8A0A03D
     ResultCode(61, ErrorModule::HTTP, ErrorSummary::InvalidState, ErrorLevel::Permanent);
-
-void Context::MakeRequest() {
-    ASSERT(state == RequestState::NotStarted);
+const ResultCode ERROR_BUFFER_SMALL = // 0xD840A02B
+    ResultCode(43, ErrorModule::HTTP, ErrorSummary::WouldBlock, ErrorLevel::Permanent);
+const ResultCode ERROR_TIMEOUT = // 0xD820A069
+    ResultCode(105, ErrorModule::HTTP, ErrorSummary::NothingHappened, ErrorLevel::Permanent);
+
+/// Number of host threads sending requests. The HTTP sysmodule also serves requests on a few
+/// worker threads, and only 8 contexts can exist at the same time anyway.
+constexpr std::size_t NumRequestThreads = 3;
+/// Maximum number of queued requests to the same host that are sent over one connection.
+constexpr std::size_t MaxRequestsPerConnection = 5;
+/// Maximum number of idle clients that are kept for every host.
+constexpr std::size_t MaxIdleClientsPerHost = 2;
+/// Interval at which the requests that client threads wait on are checked.
+constexpr s64 request_poll_interval_us = 1000;
+
+bool Context::IsRequestFinished() const {
+    return request_future.valid() &&
+           request_future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
 
 #ifdef ENABLE_WEB_SERVICE
+std::unique_ptr<httplib::Client> Context::CreateClient() const {
     LUrlParser::clParseURL parsedUrl = LUrlParser::clParseURL::ParseURL(url);
     int port;
-    std::unique_ptr<httplib::Client> client;
     if (parsedUrl.m_Scheme == "http") {
         if (!parsedUrl.GetPort(&port)) {
             port = 80;
         }
         // TODO(B3N30): Support for setting timeout
         // Figure out what the default timeout on 3DS is
-        client = std::make_unique<httplib::Client>(parsedUrl.m_Host.c_str(), port);
-    } else {
-        if (!parsedUrl.GetPort(&port)) {
-            port = 443;
-        }
-        // TODO(B3N30): Support for setting timeout
-        // Figure out what the default timeout on 3DS is
+        return std::make_unique<httplib::Client>(parsedUrl.m_Host.c_str(), port);
+    }
 
-        auto ssl_client = std::make_unique<httplib::SSLClient>(parsedUrl.m_Host, port);
-        SSL_CTX* ctx = ssl_client->ssl_context();
-        client = std::move(ssl_client);
+    if (!parsedUrl.GetPort(&port)) {
+        port = 443;
+    }
+    // TODO(B3N30): Support for setting timeout
+    // Figure out what the default timeout on 3DS is
 
-        if (auto client_cert = ssl_config.client_cert_ctx.lock()) {
-            SSL_CTX_use_certificate_ASN1(ctx, client_cert->certificate.size(),
-                                         client_cert->certificate.data());
-            SSL_CTX_use_PrivateKey_ASN1(EVP_PKEY_RSA, ctx, client_cert->private_key.data(),
-                                        client_cert->private_key.size());
-        }
+    auto ssl_client = std::make_unique<httplib::SSLClient>(parsedUrl.m_Host, port);
+    SSL_CTX* ctx = ssl_client->ssl_context();
 
-        // TODO(B3N30): Check for SSLOptions-Bits and set the verify method accordingly
-        // https://www.3dbrew.org/wiki/SSL_Services#SSLOpt
-        // Hack: Since for now RootCerts are not implemented we set the VerifyMode to None.
-        SSL_CTX_set_verify(ctx, SSL_VERIFY_NONE, NULL);
+    if (auto client_cert = ssl_config.client_cert_ctx.lock()) {
+        SSL_CTX_use_certificate_ASN1(ctx, client_cert->certificate.size(),
+                                     client_cert->certificate.data());
+        SSL_CTX_use_PrivateKey_ASN1(EVP_PKEY_RSA, ctx, client_cert->private_key.data(),
+                                    client_cert->private_key.size());
     }
 
-    state = RequestState::InProgress;
+    // TODO(B3N30): Check for SSLOptions-Bits and set the verify method accordingly
+    // https://www.3dbrew.org/wiki/SSL_Services#SSLOpt
+    // Hack: Since for now RootCerts are not implemented we set the VerifyMode to None.
+    SSL_CTX_set_verify(ctx, SSL_VERIFY_NONE, NULL);
 
+    return ssl_client;
+}
+
+httplib::Request Context::CreateRequest() {
     static const std::unordered_map<RequestMethod, std::string> request_method_strings{
         {RequestMethod::Get, "GET"},       {RequestMethod::Post, "POST"},
         {RequestMethod::Head, "HEAD"},     {RequestMethod::Put, "PUT"},
@@ -104,31 +127,237 @@ void Context::MakeRequest() {
     request.method = request_method_strings.at(method);
     request.path = url;
     // TODO(B3N30): Add post data body
+    request.response_handler = [this](const httplib::Response& received) -> bool {
+        response = received;
+        return !cancel_requested;
+    };
+    request.content_receiver = [this](const char* data, std::size_t length) -> bool {
+        std::lock_guard lock{response_mutex};
+        response_body.insert(response_body.end(), data, data + length);
+        return !cancel_requested;
+    };
     request.progress = [this](u64 current, u64 total) -> bool {
         // TODO(B3N30): Is there a state that shows response header are available
         current_download_size_bytes = current;
         total_download_size_bytes = total;
-        return true;
+        return !cancel_requested;
     };
 
     for (const auto& header : headers) {
         request.headers.emplace(header.name, header.value);
     }
 
-    if (!client->send(request, response)) {
+    return request;
+}
+#endif
+
+RequestExecutor::RequestExecutor(std::size_t num_threads) : num_threads(num_threads) {}
+
+RequestExecutor::~RequestExecutor() {
+    {
+        std::lock_guard lock{queue_mutex};
+        stop_requested = true;
+    }
+    job_queued.notify_all();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (auto& job : jobs) {
+        job.context->state = RequestState::TimedOut;
+        job.promise.set_value();
+    }
+
+    const u64 finished_requests = stats.completed_requests + stats.failed_requests;
+    if (finished_requests > 0) {
+        LOG_INFO(Service_HTTP,
+                 "{} requests completed, {} failed, {} bytes received, {} ms average latency, "
+                 "{} ms maximum latency",
+                 stats.completed_requests, stats.failed_requests, stats.received_bytes,
+                 stats.total_latency.count() / 1000 / finished_requests,
+                 stats.max_latency.count() / 1000);
+    }
+}
+
+std::future<void> RequestExecutor::Submit(Context& context) {
+    ASSERT(context.state == RequestState::NotStarted);
+
+    Job job{&context, GetHostKey(context), {}, std::chrono::steady_clock::now()};
+    auto future = job.promise.get_future();
+    {
+        std::lock_guard lock{queue_mutex};
+        jobs.push_back(std::move(job));
+
+        // Most titles never use HTTP, so the threads are only started once they are needed
+        if (threads.empty()) {
+            threads.reserve(num_threads);
+            for (std::size_t i = 0; i < num_threads; ++i) {
+                threads.emplace_back(&RequestExecutor::WorkerLoop, this);
+            }
+        }
+    }
+    job_queued.notify_one();
+    return future;
+}
+
+RequestExecutor::Stats RequestExecutor::GetStats() const {
+    std::lock_guard lock{queue_mutex};
+    return stats;
+}
+
+std::string RequestExecutor::GetHostKey(const Context& context) {
+#ifdef ENABLE_WEB_SERVICE
+    LUrlParser::clParseURL parsedUrl = LUrlParser::clParseURL::ParseURL(context.url);
+    int port;
+    if (!parsedUrl.GetPort(&port)) {
+        port = parsedUrl.m_Scheme == "http" ? 80 : 443;
+    }
+    std::string key = fmt::format("{}://{}:{}", parsedUrl.m_Scheme, parsedUrl.m_Host, port);
+
+    // The client certificate is part of the SSL context of the client
+    if (auto client_cert = context.ssl_config.client_cert_ctx.lock()) {
+        key += fmt::format("#{}", client_cert->handle);
+    }
+    return key;
+#else
+    return context.url;
+#endif
+}
+
+void RequestExecutor::WorkerLoop() {
+    Common::SetCurrentThreadName("HTTP Request");
+
+    std::unique_lock lock{queue_mutex};
+    while (true) {
+        job_queued.wait(lock, [this] { return stop_requested || !jobs.empty(); });
+        if (stop_requested) {
+            break;
+        }
+
+        std::vector<Job> batch;
+        batch.push_back(std::move(jobs.front()));
+        jobs.pop_front();
+        for (auto itr = jobs.begin();
+             itr != jobs.end() && batch.size() < MaxRequestsPerConnection;) {
+            if (itr->host_key == batch.front().host_key) {
+                batch.push_back(std::move(*itr));
+                itr = jobs.erase(itr);
+            } else {
+                ++itr;
+            }
+        }
+
+        lock.unlock();
+        RunBatch(batch);
+        std::vector<std::size_t> sizes;
+        sizes.reserve(batch.size());
+        for (auto& job : batch) {
+            std::lock_guard response_lock{job.context->response_mutex};
+            sizes.push_back(job.context->response_body.size());
+        }
+        lock.lock();
+
+        const auto now = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < batch.size(); ++i) {
+            auto& job = batch[i];
+            const auto latency =
+                std::chrono::duration_cast<std::chrono::microseconds>(now - job.submit_time);
+            const bool completed = job.context->state == RequestState::ReadyToDownloadContent;
+            LOG_DEBUG(Service_HTTP, "Request to {} {} in {} ms, {} bytes received",
+                      job.context->url, completed ? "completed" : "failed",
+                      latency.count() / 1000, sizes[i]);
+
+            if (completed) {
+                stats.completed_requests++;
+            } else {
+                stats.failed_requests++;
+            }
+            stats.received_bytes += sizes[i];
+            stats.total_latency += latency;
+            stats.max_latency = std::max(stats.max_latency, latency);
+            job.promise.set_value();
+        }
+    }
+}
+
+void RequestExecutor::RunBatch(std::vector<Job>& batch) {
+#ifdef ENABLE_WEB_SERVICE
+    std::vector<Context*> contexts;
+    std::vector<httplib::Request> requests;
+    for (auto& job : batch) {
+        Context& context = *job.context;
+        if (context.cancel_requested) {
+            context.state = RequestState::TimedOut;
+            continue;
+        }
+        context.state = RequestState::InProgress;
+        contexts.push_back(&context);
+        requests.push_back(context.CreateRequest());
+    }
+    if (contexts.empty()) {
+        return;
+    }
+
+    const std::string& host_key = batch.front().host_key;
+    auto client = AcquireClient(*contexts.front(), host_key);
+
+    // The requests are sent in order, and responses are only added for the ones that succeeded.
+    // The first failed request ends the send, for example when its context was closed, so the
+    // requests of the other contexts after it are sent again.
+    std::size_t next_context = 0;
+    while (true) {
+        std::vector<httplib::Response> responses;
+        const bool success = client->send(requests, responses);
+        for (std::size_t i = 0; i < responses.size(); ++i) {
+            LOG_DEBUG(Service_HTTP, "Request successful");
+            // TODO(B3N30): Verify this state on HW
+            contexts[next_context++]->state = RequestState::ReadyToDownloadContent;
+        }
+        if (success) {
+            break;
+        }
+
         LOG_ERROR(Service_HTTP, "Request failed");
-        state = RequestState::TimedOut;
-    } else {
-        LOG_DEBUG(Service_HTTP, "Request successful");
-        // TODO(B3N30): Verify this state on HW
-        state = RequestState::ReadyToDownloadContent;
+        contexts[next_context++]->state = RequestState::TimedOut;
+        requests.erase(requests.begin(), requests.begin() + responses.size() + 1);
+        if (requests.empty()) {
+            return;
+        }
     }
+    ReleaseClient(host_key, std::move(client));
 #else
-    LOG_ERROR(Service_HTTP, "Tried to make request but WebServices is not enabled in this build");
-    state = RequestState::TimedOut;
+    for (auto& job : batch) {
+        LOG_ERROR(Service_HTTP,
+                  "Tried to make request but WebServices is not enabled in this build");
+        job.context->state = RequestState::TimedOut;
+    }
 #endif
 }
 
+#ifdef ENABLE_WEB_SERVICE
+std::unique_ptr<httplib::Client> RequestExecutor::AcquireClient(const Context& context,
+                                                                const std::string& host_key) {
+    {
+        std::lock_guard lock{pool_mutex};
+        auto itr = idle_clients.find(host_key);
+        if (itr != idle_clients.end()) {
+            auto client = std::move(itr->second);
+            idle_clients.erase(itr);
+            return client;
+        }
+    }
+    return context.CreateClient();
+}
+
+void RequestExecutor::ReleaseClient(const std::string& host_key,
+                                    std::unique_ptr<httplib::Client> client) {
+    std::lock_guard lock{pool_mutex};
+    if (idle_clients.count(host_key) < MaxIdleClientsPerHost) {
+        idle_clients.emplace(host_key, std::move(client));
+    }
+}
+#endif
+
 void HTTP_C::Initialize(Kernel::HLERequestContext& ctx) {
     IPC::RequestParser rp(ctx, 0x1, 1, 4);
     const u32 shmem_size = rp.Pop<u32>();
@@ -238,13 +467,22 @@ void HTTP_C::BeginRequest(Kernel::HLERequestContext& ctx) {
     // trying to enqueue any more will either fail (BeginRequestAsync), or block (BeginRequest)
     // Note that you only can have 8 Contexts at a time. So this difference shouldn't matter
     // Then there are 3? worker threads that pop the requests from the queue and send them
-    // For now make every request async in it's own thread.
-
-    itr->second.request_future =
-        std::async(std::launch::async, &Context::MakeRequest, std::ref(itr->second));
-
-    IPC::RequestBuilder rb = rp.MakeBuilder(1, 0);
-    rb.Push(RESULT_SUCCESS);
+    // Here the requests are sent by the host threads of the executor, and BeginRequest puts the
+    // client thread to sleep until its request has finished.
+
+    itr->second.request_future = executor->Submit(itr->second);
+
+    SleepUntil(
+        ctx,
+        [this, context_handle] {
+            auto itr = contexts.find(context_handle);
+            return itr == contexts.end() || itr->second.IsRequestFinished();
+        },
+        std::chrono::nanoseconds(0), "http:BeginRequest",
+        [](Kernel::HLERequestContext& ctx, Kernel::ThreadWakeupReason) {
+            IPC::RequestBuilder rb(ctx, 0x9, 1, 0);
+            rb.Push(RESULT_SUCCESS);
+        });
 }
 
 void HTTP_C::BeginRequestAsync(Kernel::HLERequestContext& ctx) {
@@ -291,15 +529,181 @@ void HTTP_C::BeginRequestAsync(Kernel::HLERequestContext& ctx) {
     // trying to enqueue any more will either fail (BeginRequestAsync), or block (BeginRequest)
     // Note that you only can have 8 Contexts at a time. So this difference shouldn't matter
     // Then there are 3? worker threads that pop the requests from the queue and send them
-    // For now make every request async in it's own thread.
+    // Here the requests are sent by the host threads of the executor.
 
-    itr->second.request_future =
-        std::async(std::launch::async, &Context::MakeRequest, std::ref(itr->second));
+    itr->second.request_future = executor->Submit(itr->second);
 
     IPC::RequestBuilder rb = rp.MakeBuilder(1, 0);
     rb.Push(RESULT_SUCCESS);
 }
 
+void HTTP_C::GetDownloadSizeState(Kernel::HLERequestContext& ctx) {
+    IPC::RequestParser rp(ctx, 0x6, 1, 0);
+    const Context::Handle context_handle = rp.Pop<u32>();
+
+    LOG_DEBUG(Service_HTTP, "called, context_id={}", context_handle);
+
+    auto itr = contexts.find(context_handle);
+    if (itr == contexts.end()) {
+        IPC::RequestBuilder rb = rp.MakeBuilder(1, 0);
+        rb.Push(ResultCode(ErrCodes::ContextNotFound, ErrorModule::HTTP, ErrorSummary::InvalidState,
+                           ErrorLevel::Permanent));
+        return;
+    }
+
+    IPC::RequestBuilder rb = rp.MakeBuilder(3, 0);
+    rb.Push(RESULT_SUCCESS);
+    rb.Push(static_cast<u32>(itr->second.current_download_size_bytes));
+    rb.Push(static_cast<u32>(itr->second.total_download_size_bytes));
+}
+
+void HTTP_C::ReceiveData(Kernel::HLERequestContext& ctx) {
+    ReceiveDataImpl(ctx, false);
+}
+
+void HTTP_C::ReceiveDataTimeout(Kernel::HLERequestContext& ctx) {
+    ReceiveDataImpl(ctx, true);
+}
+
+void HTTP_C::ReceiveDataImpl(Kernel::HLERequestContext& ctx, bool timeout) {
+    const u16 command_id = timeout ? 0xC : 0xB;
+    IPC::RequestParser rp(ctx, command_id, timeout ? 4 : 2, 2);
+    const Context::Handle context_handle = rp.Pop<u32>();
+    const u32 buffer_size = rp.Pop<u32>();
+    u64 timeout_nanos = 0;
+    if (timeout) {
+        timeout_nanos = rp.Pop<u64>();
+    }
+    Kernel::MappedBuffer& buffer = rp.PopMappedBuffer();
+
+    LOG_DEBUG(Service_HTTP, "called, context_id={} buffer_size={} timeout={}", context_handle,
+              buffer_size, timeout_nanos);
+
+    auto itr = contexts.find(context_handle);
+    if (itr == contexts.end()) {
+        IPC::RequestBuilder rb = rp.MakeBuilder(1, 2);
+        rb.Push(ResultCode(ErrCodes::ContextNotFound, ErrorModule::HTTP, ErrorSummary::InvalidState,
+                           ErrorLevel::Permanent));
+        rb.PushMappedBuffer(buffer);
+        return;
+    }
+
+    if (!itr->second.request_future.valid()) {
+        LOG_ERROR(Service_HTTP, "Tried to receive data before the request was started");
+        IPC::RequestBuilder rb = rp.MakeBuilder(1, 2);
+        rb.Push(ResultCode(ErrCodes::InvalidRequestState, ErrorModule::HTTP,
+                           ErrorSummary::InvalidState, ErrorLevel::Permanent));
+        rb.PushMappedBuffer(buffer);
+        return;
+    }
+
+    // The data is available as soon as it fills the buffer or the whole body has been received
+    const auto is_ready = [this, context_handle, buffer_size] {
+        auto itr = contexts.find(context_handle);
+        if (itr == contexts.end() || itr->second.IsRequestFinished()) {
+            return true;
+        }
+        Context& http_context = itr->second;
+        std::lock_guard lock{http_context.response_mutex};
+        return http_context.response_body.size() - http_context.current_copied_data >=
+               buffer_size;
+    };
+
+    auto copy_data = [this, command_id, context_handle, buffer_size,
+                      buffer](Kernel::HLERequestContext& ctx,
+                              Kernel::ThreadWakeupReason reason) mutable {
+        IPC::RequestBuilder rb(ctx, command_id, 1, 2);
+
+        auto itr = contexts.find(context_handle);
+        if (itr == contexts.end()) {
+            rb.Push(ResultCode(ErrCodes::ContextNotFound, ErrorModule::HTTP,
+                               ErrorSummary::InvalidState, ErrorLevel::Permanent));
+            rb.PushMappedBuffer(buffer);
+            return;
+        }
+        Context& http_context = itr->second;
+
+        if (reason == Kernel::ThreadWakeupReason::Timeout) {
+            LOG_DEBUG(Service_HTTP, "Timed out waiting for data, context_id={}", context_handle);
+            rb.Push(ERROR_TIMEOUT);
+            rb.PushMappedBuffer(buffer);
+            return;
+        }
+
+        const bool finished = http_context.IsRequestFinished();
+        std::lock_guard lock{http_context.response_mutex};
+        const std::size_t remaining =
+            http_context.response_body.size() - http_context.current_copied_data;
+        const std::size_t size = std::min<std::size_t>(remaining, buffer_size);
+        buffer.Write(http_context.response_body.data() + http_context.current_copied_data, 0,
+                     size);
+        http_context.current_copied_data += size;
+
+        if (finished && http_context.state == RequestState::TimedOut && size == 0) {
+            LOG_ERROR(Service_HTTP, "Tried to receive data of a failed request");
+            rb.Push(ResultCode(ErrCodes::InvalidRequestState, ErrorModule::HTTP,
+                               ErrorSummary::InvalidState, ErrorLevel::Permanent));
+        } else if (finished && size == remaining) {
+            rb.Push(RESULT_SUCCESS);
+        } else {
+            // There is more data to receive
+            rb.Push(ERROR_BUFFER_SMALL);
+        }
+        rb.PushMappedBuffer(buffer);
+    };
+
+    if (is_ready()) {
+        copy_data(ctx, Kernel::ThreadWakeupReason::Signal);
+        return;
+    }
+
+    SleepUntil(ctx, is_ready, std::chrono::nanoseconds(timeout_nanos),
+               timeout ? "http:ReceiveDataTimeout" : "http:ReceiveData", std::move(copy_data));
+}
+
+void HTTP_C::SleepUntil(
+    Kernel::HLERequestContext& ctx, std::function<bool()> is_ready,
+    std::chrono::nanoseconds timeout, const std::string& reason,
+    std::function<void(Kernel::HLERequestContext&, Kernel::ThreadWakeupReason)> on_wakeup) {
+    const u64 wait_id = next_wait_id++;
+    auto event = ctx.SleepClientThread(
+        reason, timeout,
+        [this, wait_id, on_wakeup = std::move(on_wakeup)](std::shared_ptr<Kernel::Thread> /*thread*/,
+                                                           Kernel::HLERequestContext& ctx,
+                                                           Kernel::ThreadWakeupReason reason) {
+            request_waits.erase(std::remove_if(request_waits.begin(), request_waits.end(),
+                                               [wait_id](const RequestWait& wait) {
+                                                   return wait.id == wait_id;
+                                               }),
+                                request_waits.end());
+            on_wakeup(ctx, reason);
+        });
+    request_waits.push_back({wait_id, std::move(is_ready), std::move(event)});
+
+    if (!is_poll_scheduled) {
+        system.CoreTiming().ScheduleEvent(usToCycles(request_poll_interval_us), poll_event);
+        is_poll_scheduled = true;
+    }
+}
+
+void HTTP_C::PollRequestWaits(s64 cycles_late) {
+    // Signaling an event runs the wakeup callback right away, which removes the wait
+    std::vector<std::shared_ptr<Kernel::Event>> ready_events;
+    for (const auto& wait : request_waits) {
+        if (wait.is_ready())
+            ready_events.push_back(wait.event);
+    }
+    for (const auto& event : ready_events) {
+        event->Signal();
+    }
+
+    is_poll_scheduled = !request_waits.empty();
+    if (is_poll_scheduled) {
+        system.CoreTiming().ScheduleEvent(usToCycles(request_poll_interval_us) - cycles_late,
+                                          poll_event);
+    }
+}
+
 void HTTP_C::CreateContext(Kernel::HLERequestContext& ctx) {
     IPC::RequestParser rp(ctx, 0x2, 2, 2);
     const u32 url_size = rp.Pop<u32>();
@@ -406,12 +810,35 @@ void HTTP_C::CloseContext(Kernel::HLERequestContext& ctx) {
     // TODO(Subv): What happens if you try to close a context that's currently being used?
     // TODO(Subv): Make sure that only the session that created the context can close it.
 
-    // Note that this will block if a request is still in progress
-    contexts.erase(itr);
-    session_data->num_http_contexts--;
+    const auto close_context = [this, context_handle,
+                                session_data](Kernel::HLERequestContext& ctx) {
+        if (contexts.erase(context_handle) != 0) {
+            session_data->num_http_contexts--;
+        }
 
-    IPC::RequestBuilder rb = rp.MakeBuilder(1, 0);
-    rb.Push(RESULT_SUCCESS);
+        IPC::RequestBuilder rb(ctx, 0x3, 1, 0);
+        rb.Push(RESULT_SUCCESS);
+    };
+
+    Context& http_context = itr->second;
+    if (!http_context.request_future.valid() || http_context.IsRequestFinished()) {
+        close_context(ctx);
+        return;
+    }
+
+    // Abort the request in progress and only destroy the context once the executor is done with
+    // it, without blocking the emulation thread in the meantime.
+    http_context.cancel_requested = true;
+    SleepUntil(
+        ctx,
+        [this, context_handle] {
+            auto itr = contexts.find(context_handle);
+            return itr == contexts.end() || itr->second.IsRequestFinished();
+        },
+        std::chrono::nanoseconds(0), "http:CloseContext",
+        [close_context](Kernel::HLERequestContext& ctx, Kernel::ThreadWakeupReason) {
+            close_context(ctx);
+        });
 }
 
 void HTTP_C::AddRequestHeader(Kernel::HLERequestContext& ctx) {
@@ -883,20 +1310,20 @@ void HTTP_C::DecryptClCertA() {
     ClCertA.init = true;
 }
 
-HTTP_C::HTTP_C() : ServiceFramework("http:C", 32) {
+HTTP_C::HTTP_C(Core::System& system) : ServiceFramework("http:C", 32), system(system) {
     static const FunctionInfo functions[] = {
         {0x00010044, &HTTP_C::Initialize, "Initialize"},
         {0x00020082, &HTTP_C::CreateContext, "CreateContext"},
         {0x00030040, &HTTP_C::CloseContext, "CloseContext"},
         {0x00040040, nullptr, "CancelConnection"},
         {0x00050040, nullptr, "GetRequestState"},
-        {0x00060040, nullptr, "GetDownloadSizeState"},
+        {0x00060040, &HTTP_C::GetDownloadSizeState, "GetDownloadSizeState"},
         {0x00070040, nullptr, "GetRequestError"},
         {0x00080042, &HTTP_C::InitializeConnectionSession, "InitializeConnectionSession"},
         {0x00090040, &HTTP_C::BeginRequest, "BeginRequest"},
         {0x000A0040, &HTTP_C::BeginRequestAsync, "BeginRequestAsync"},
-        {0x000B0082, nullptr, "ReceiveData"},
-        {0x000C0102, nullptr, "ReceiveDataTimeout"},
+        {0x000B0082, &HTTP_C::ReceiveData, "ReceiveData"},
+        {0x000C0102, &HTTP_C::ReceiveDataTimeout, "ReceiveDataTimeout"},
         {0x000D0146, nullptr, "SetProxy"},
         {0x000E0040, nullptr, "SetProxyDefault"},
         {0x000F00C4, nullptr, "SetBasicAuthorization"},
@@ -945,10 +1372,23 @@ HTTP_C::HTTP_C() : ServiceFramework("http:C", 32) {
     RegisterHandlers(functions);
 
     DecryptClCertA();
+
+    executor = std::make_unique<RequestExecutor>(NumRequestThreads);
+
+    poll_event = system.CoreTiming().RegisterEvent(
+        "HTTP_C::PollRequestWaits",
+        [this](u64 userdata, s64 cycles_late) { PollRequestWaits(cycles_late); });
+}
+
+HTTP_C::~HTTP_C() {
+    // Abort the requests in progress so that the executor can be stopped
+    for (auto& context : contexts) {
+        context.second.cancel_requested = true;
+    }
 }
 
 void InstallInterfaces(Core::System& system) {
     auto& service_manager = system.ServiceManager();
-    std::make_shared<HTTP_C>()->InstallAsService(service_manager);
+    std::make_shared<HTTP_C>(system)->InstallAsService(service_manager);
 }
 } // namespace Service::HTTP
@@ -4,10 +4,17 @@
 
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
 #include <future>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 #ifdef ENABLE_WEB_SERVICE
@@ -17,11 +24,13 @@
 #include <httplib.h>
 #endif
 #include "core/hle/kernel/shared_memory.h"
+#include "core/hle/kernel/thread.h"
 #include "core/hle/service/service.h"
 
 namespace Core {
 class System;
-}
+struct TimingEventType;
+} // namespace Core
 
 namespace Service::HTTP {
 
@@ -85,7 +94,16 @@ public:
     Context(const Context&) = delete;
     Context& operator=(const Context&) = delete;
 
-    void MakeRequest();
+    /// Returns whether the request has been sent and has completed, successfully or not.
+    bool IsRequestFinished() const;
+
+#ifdef ENABLE_WEB_SERVICE
+    /// Creates a client for the host of the url, configured with the SSL settings of the context.
+    std::unique_ptr<httplib::Client> CreateClient() const;
+
+    /// Creates the request for this context. Its callbacks stream the response into the context.
+    httplib::Request CreateRequest();
+#endif
 
     struct Proxy {
         std::string url;
@@ -131,8 +149,16 @@ public:
     std::vector<PostData> post_data;
 
     std::future<void> request_future;
+    /// Set when the context is closed, aborts the request at the next received chunk.
+    std::atomic<bool> cancel_requested = false;
     std::atomic<u64> current_download_size_bytes;
     std::atomic<u64> total_download_size_bytes;
+
+    /// Guards response_body, which the request thread appends to while the body is received.
+    std::mutex response_mutex;
+    std::vector<u8> response_body;
+    /// Number of bytes of the response body that have already been passed to the guest.
+    std::size_t current_copied_data = 0;
 #ifdef ENABLE_WEB_SERVICE
     httplib::Response response;
 #endif
@@ -155,9 +181,71 @@ struct SessionData : public Kernel::SessionRequestHandler::SessionDataBase {
     bool initialized = false;
 };
 
+/**
+ * Sends the requests of HTTP contexts on a fixed set of host threads, so that neither the
+ * emulation thread nor the guest has to wait for the network. The threads are started when the
+ * first request is submitted.
+ *
+ * Clients are pooled per host and reused, which keeps their SSL contexts around. Requests to the
+ * same host that are queued at the same time are sent over a single keep-alive connection.
+ */
+class RequestExecutor {
+public:
+    struct Stats {
+        u64 completed_requests = 0; ///< Requests that received a response
+        u64 failed_requests = 0;    ///< Requests that failed or were aborted
+        u64 received_bytes = 0;     ///< Size of the response bodies
+        std::chrono::microseconds total_latency{}; ///< Summed time from Submit to completion
+        std::chrono::microseconds max_latency{};
+    };
+
+    explicit RequestExecutor(std::size_t num_threads);
+    ~RequestExecutor();
+
+    /// Queues the request of the context. The returned future becomes ready once it has finished.
+    std::future<void> Submit(Context& context);
+
+    /// Returns the statistics of the requests that have finished so far
+    Stats GetStats() const;
+
+private:
+    struct Job {
+        Context* context;
+        std::string host_key; ///< Requests with the same key can share a client and connection
+        std::promise<void> promise;
+        std::chrono::steady_clock::time_point submit_time;
+    };
+
+    static std::string GetHostKey(const Context& context);
+
+    void WorkerLoop();
+    void RunBatch(std::vector<Job>& batch);
+
+#ifdef ENABLE_WEB_SERVICE
+    std::unique_ptr<httplib::Client> AcquireClient(const Context& context,
+                                                   const std::string& host_key);
+    void ReleaseClient(const std::string& host_key, std::unique_ptr<httplib::Client> client);
+
+    std::mutex pool_mutex;
+    std::unordered_multimap<std::string, std::unique_ptr<httplib::Client>> idle_clients;
+#endif
+
+    std::size_t num_threads;
+
+    mutable std::mutex queue_mutex;
+    std::condition_variable job_queued;
+
+    // All of the following are guarded by queue_mutex
+    std::vector<std::thread> threads;
+    std::deque<Job> jobs;
+    bool stop_requested = false;
+    Stats stats;
+};
+
 class HTTP_C final : public ServiceFramework<HTTP_C, SessionData> {
 public:
-    HTTP_C();
+    explicit HTTP_C(Core::System& system);
+    ~HTTP_C();
 
 private:
     /**
@@ -224,6 +312,46 @@ private:
      */
     void BeginRequestAsync(Kernel::HLERequestContext& ctx);
 
+    /**
+     * HTTP_C::GetDownloadSizeState service function
+     *  Inputs:
+     * 1 : Context handle
+     *  Outputs:
+     *      1 : Result of function, 0 on success, otherwise error code
+     *      2 : Number of bytes of the content received so far
+     *      3 : Total size of the content, 0 if unknown
+     */
+    void GetDownloadSizeState(Kernel::HLERequestContext& ctx);
+
+    /**
+     * HTTP_C::ReceiveData service function
+     *  Inputs:
+     * 1 : Context handle
+     * 2 : Buffer size
+     * 3 : (BufferSize<<4) | 12
+     * 4 : Buffer pointer
+     *  Outputs:
+     *      1 : Result of function, 0 on success, otherwise error code
+     *      2, 3 : Mapped buffer descriptor
+     */
+    void ReceiveData(Kernel::HLERequestContext& ctx);
+
+    /**
+     * HTTP_C::ReceiveDataTimeout service function
+     *  Inputs:
+     * 1 : Context handle
+     * 2 : Buffer size
+     * 3-4 : u64 timeout in nanoseconds
+     * 5 : (BufferSize<<4) | 12
+     * 6 : Buffer pointer
+     *  Outputs:
+     *      1 : Result of function, 0 on success, otherwise error code
+     *      2, 3 : Mapped buffer descriptor
+     */
+    void ReceiveDataTimeout(Kernel::HLERequestContext& ctx);
+
+    void ReceiveDataImpl(Kernel::HLERequestContext& ctx, bool timeout);
+
     /**
      * HTTP_C::AddRequestHeader service function
      *  Inputs:
@@ -317,6 +445,21 @@ private:
 
     void DecryptClCertA();
 
+    /**
+     * Puts the client thread to sleep until is_ready returns true, then calls on_wakeup to write
+     * the response. on_wakeup is also called if the timeout expires first.
+     * @param timeout Time after which the thread is woken up anyway, zero to wait indefinitely
+     */
+    void SleepUntil(Kernel::HLERequestContext& ctx, std::function<bool()> is_ready,
+                    std::chrono::nanoseconds timeout, const std::string& reason,
+                    std::function<void(Kernel::HLERequestContext&, Kernel::ThreadWakeupReason)>
+                        on_wakeup);
+
+    /// Wakes the client threads whose requests made progress
+    void PollRequestWaits(s64 cycles_late);
+
+    Core::System& system;
+
     std::shared_ptr<Kernel::SharedMemory> shared_memory = nullptr;
 
     /// The next number to use when a new HTTP session is initalized.
@@ -331,6 +474,21 @@ private:
     /// Global list of HTTP contexts currently opened.
     std::unordered_map<Context::Handle, Context> contexts;
 
+    /// Sends the requests of the contexts. Declared after contexts so that it is destroyed, and
+    /// its threads are stopped, before the contexts they refer to.
+    std::unique_ptr<RequestExecutor> executor;
+
+    struct RequestWait {
+        u64 id;
+        std::function<bool()> is_ready;
+        std::shared_ptr<Kernel::Event> event; ///< Wakes the sleeping client thread
+    };
+    std::vector<RequestWait> request_waits;
+    u64 next_wait_id = 0;
+
+    Core::TimingEventType* poll_event;
+    bool is_poll_scheduled = false;
+
     /// Global list of  ClientCert contexts currently opened.
     std::unordered_map<ClientCertContext::Handle, std::shared_ptr<ClientCertContext>> client_certs;
 
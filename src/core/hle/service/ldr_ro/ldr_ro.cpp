@@ -5,6 +5,7 @@
 #include "common/alignment.h"
 #include "common/common_types.h"
 #include "common/logging/log.h"
+#include "common/scope_exit.h"
 #include "core/arm/arm_interface.h"
 #include "core/core.h"
 #include "core/hle/ipc_helpers.h"
@@ -185,6 +186,10 @@ void RO::LoadCRO(Kernel::HLERequestContext& ctx, bool link_on_load_bug_fix) {
               data_segment_address, zero, data_segment_size, bss_segment_address, bss_segment_size,
               auto_link ? "true" : "false", fix_level, crr_address);
 
+    // Relocating patches guest memory word by word, only flush the touched code pages once
+    system.BeginCacheInvalidationBatch();
+    SCOPE_EXIT({ system.EndCacheInvalidationBatch(); });
+
     IPC::RequestBuilder rb = rp.MakeBuilder(2, 0);
 
     ClientSlot* slot = GetSessionData(ctx.Session());
@@ -340,6 +345,9 @@ void RO::UnloadCRO(Kernel::HLERequestContext& ctx) {
 
     CROHelper cro(cro_address, *process, system);
 
+    system.BeginCacheInvalidationBatch();
+    SCOPE_EXIT({ system.EndCacheInvalidationBatch(); });
+
     IPC::RequestBuilder rb = rp.MakeBuilder(1, 0);
 
     ClientSlot* slot = GetSessionData(ctx.Session());
@@ -407,6 +415,9 @@ void RO::LinkCRO(Kernel::HLERequestContext& ctx) {
 
     CROHelper cro(cro_address, *process, system);
 
+    system.BeginCacheInvalidationBatch();
+    SCOPE_EXIT({ system.EndCacheInvalidationBatch(); });
+
     IPC::RequestBuilder rb = rp.MakeBuilder(1, 0);
 
     ClientSlot* slot = GetSessionData(ctx.Session());
@@ -447,6 +458,9 @@ void RO::UnlinkCRO(Kernel::HLERequestContext& ctx) {
 
     CROHelper cro(cro_address, *process, system);
 
+    system.BeginCacheInvalidationBatch();
+    SCOPE_EXIT({ system.EndCacheInvalidationBatch(); });
+
     IPC::RequestBuilder rb = rp.MakeBuilder(1, 0);
 
     ClientSlot* slot = GetSessionData(ctx.Session());
@@ -12,7 +12,9 @@
 #include "common/scope_exit.h"
 #include "common/swap.h"
 #include "core/core.h"
+#include "core/core_timing.h"
 #include "core/hle/ipc_helpers.h"
+#include "core/hle/kernel/event.h"
 #include "core/hle/kernel/shared_memory.h"
 #include "core/hle/result.h"
 #include "core/hle/service/soc_u.h"
@@ -350,10 +352,216 @@ struct CTRAddrInfo {
 
 static_assert(sizeof(CTRAddrInfo) == 0x130, "Size of CTRAddrInfo is not correct");
 
+/// How often the sockets of sleeping client threads are checked for readiness
+constexpr s64 socket_poll_interval_us = 500;
+
+/// Host sockets never block, blocking guest sockets are emulated by putting the client thread to
+/// sleep until the host socket is ready
+static void SetHostNonBlocking(u32 socket_fd) {
+#ifdef _WIN32
+    unsigned long nonblocking = 1;
+    ioctlsocket(socket_fd, FIONBIO, &nonblocking);
+#else
+    const int flags = ::fcntl(socket_fd, F_GETFL, 0);
+    ::fcntl(socket_fd, F_SETFL, flags | O_NONBLOCK);
+#endif
+}
+
+/// Returns whether the socket has any of the given events pending or is in an error state
+static bool IsSocketReady(u32 socket_fd, s16 events) {
+    pollfd platform_pollfd{};
+    platform_pollfd.fd = socket_fd;
+    platform_pollfd.events = events;
+    s32 ret = ::poll(&platform_pollfd, 1, 0);
+    return ret != 0;
+}
+
+/// Returns whether the host error means the operation would have had to wait for the socket
+static bool IsWouldBlockError(int error) {
+    return error == ERRNO(EWOULDBLOCK) || error == ERRNO(EAGAIN);
+}
+
+bool SocketSend::Continue(bool blocking) {
+    const auto remaining = static_cast<u32>(data.size()) - sent;
+    const char* buffer = reinterpret_cast<const char*>(data.data()) + sent;
+    s32 ret = SOCKET_ERROR_VALUE;
+    if (!dest_addr.empty()) {
+        CTRSockAddr ctr_dest_addr;
+        std::memcpy(&ctr_dest_addr, dest_addr.data(), sizeof(ctr_dest_addr));
+        sockaddr platform_dest_addr = CTRSockAddr::ToPlatform(ctr_dest_addr);
+        ret = ::sendto(socket_fd, buffer, remaining, flags, &platform_dest_addr,
+                       sizeof(platform_dest_addr));
+    } else {
+        ret = ::sendto(socket_fd, buffer, remaining, flags, nullptr, 0);
+    }
+
+    if (ret == SOCKET_ERROR_VALUE) {
+        const int host_error = GET_ERRNO;
+        if (blocking && IsWouldBlockError(host_error))
+            return false;
+        error = TranslateError(host_error);
+        return true;
+    }
+
+    // A blocking send only returns once everything was handed to the host, a stream socket may
+    // take only part of it at a time
+    sent += static_cast<u32>(ret);
+    return !blocking || sent == data.size();
+}
+
+s32 SocketSend::Result() const {
+    // Like a host send, data that was sent is reported even if a later part of it failed
+    return sent > 0 || error == 0 ? static_cast<s32>(sent) : error;
+}
+
+bool SocketReceive::Continue(bool blocking) {
+    std::vector<u8> output_buff(len);
+    std::vector<u8> addr_buff(want_src_addr ? sizeof(CTRSockAddr) : 0);
+    sockaddr platform_src_addr;
+    socklen_t platform_src_addr_len = sizeof(platform_src_addr);
+
+    s32 ret = SOCKET_ERROR_VALUE;
+    if (want_src_addr) {
+        // Only get src adr if input adr available
+        ret = ::recvfrom(socket_fd, reinterpret_cast<char*>(output_buff.data()), len, flags,
+                         &platform_src_addr, &platform_src_addr_len);
+        if (ret >= 0 && platform_src_addr_len > 0) {
+            CTRSockAddr ctr_src_addr = CTRSockAddr::FromPlatform(platform_src_addr);
+            std::memcpy(addr_buff.data(), &ctr_src_addr, sizeof(ctr_src_addr));
+        }
+    } else {
+        ret = ::recvfrom(socket_fd, reinterpret_cast<char*>(output_buff.data()), len, flags,
+                         nullptr, 0);
+    }
+
+    if (ret == SOCKET_ERROR_VALUE) {
+        const int host_error = GET_ERRNO;
+        if (blocking && IsWouldBlockError(host_error))
+            return false;
+        result = TranslateError(host_error);
+        output_buff.clear();
+    } else {
+        // A blocking receive ends as soon as any data arrived, like the host one does
+        result = ret;
+        output_buff.resize(ret);
+    }
+    data = std::move(output_buff);
+    src_addr = std::move(addr_buff);
+    return true;
+}
+
+bool SOC_U::IsBlocking(u32 socket_handle) const {
+    const auto iter = open_sockets.find(socket_handle);
+    return iter != open_sockets.end() && iter->second.blocking;
+}
+
+void SOC_U::SleepUntilReady(Kernel::HLERequestContext& ctx, std::vector<WaitedSocket> sockets,
+                            std::chrono::nanoseconds timeout, const std::string& reason,
+                            std::function<void(Kernel::HLERequestContext&)> on_ready,
+                            std::function<bool()> try_transfer) {
+    const u64 wait_id = next_wait_id++;
+    auto event = ctx.SleepClientThread(
+        reason, timeout,
+        [this, wait_id, on_ready = std::move(on_ready)](std::shared_ptr<Kernel::Thread> /*thread*/,
+                                                         Kernel::HLERequestContext& ctx,
+                                                         Kernel::ThreadWakeupReason /*reason*/) {
+            socket_waits.erase(std::remove_if(socket_waits.begin(), socket_waits.end(),
+                                              [wait_id](const SocketWait& wait) {
+                                                  return wait.id == wait_id;
+                                              }),
+                               socket_waits.end());
+            on_ready(ctx);
+        });
+    socket_waits.push_back(
+        {wait_id, std::move(sockets), std::move(event), std::move(try_transfer)});
+
+    if (!is_poll_scheduled) {
+        system.CoreTiming().ScheduleEvent(usToCycles(socket_poll_interval_us), poll_event);
+        is_poll_scheduled = true;
+    }
+}
+
+void SOC_U::PollSocketWaits(s64 cycles_late) {
+    // The client thread of a wait may have been stopped while it was asleep
+    socket_waits.erase(std::remove_if(socket_waits.begin(), socket_waits.end(),
+                                      [](const SocketWait& wait) {
+                                          return wait.event->GetWaitingThreads().empty();
+                                      }),
+                       socket_waits.end());
+
+    // Signaling an event runs the wakeup callback right away, which removes the wait
+    std::vector<std::shared_ptr<Kernel::Event>> ready_events;
+    for (const auto& wait : socket_waits) {
+        std::vector<pollfd> platform_pollfd(wait.sockets.size());
+        for (std::size_t i = 0; i < wait.sockets.size(); ++i) {
+            platform_pollfd[i].fd = wait.sockets[i].socket_fd;
+            platform_pollfd[i].events = wait.sockets[i].events;
+        }
+        s32 ret = ::poll(platform_pollfd.data(), static_cast<u32>(platform_pollfd.size()), 0);
+        if (ret != 0 && (!wait.try_transfer || wait.try_transfer()))
+            ready_events.push_back(wait.event);
+    }
+    for (const auto& event : ready_events) {
+        event->Signal();
+    }
+
+    is_poll_scheduled = !socket_waits.empty();
+    if (is_poll_scheduled) {
+        system.CoreTiming().ScheduleEvent(usToCycles(socket_poll_interval_us) - cycles_late,
+                                          poll_event);
+    }
+}
+
+void SOC_U::RunTransfer(Kernel::HLERequestContext& ctx, u32 socket_handle, s16 events,
+                        const std::string& reason, std::function<bool(bool)> try_transfer,
+                        std::function<void(Kernel::HLERequestContext&)> on_done) {
+    const bool blocking = IsBlocking(socket_handle);
+    if (try_transfer(blocking)) {
+        on_done(ctx);
+        return;
+    }
+    SleepUntilReady(ctx, {{socket_handle, events}}, std::chrono::nanoseconds(0), reason,
+                    std::move(on_done),
+                    [try_transfer = std::move(try_transfer)] { return try_transfer(true); });
+}
+
+void SOC_U::EndSocketWaits(u32 socket_fd) {
+    const auto uses_socket = [socket_fd](const SocketWait& wait) {
+        return std::any_of(wait.sockets.begin(), wait.sockets.end(),
+                           [socket_fd](const WaitedSocket& socket) {
+                               return socket.socket_fd == socket_fd;
+                           });
+    };
+
+    std::vector<std::shared_ptr<Kernel::Event>> events;
+    for (const auto& wait : socket_waits) {
+        if (!uses_socket(wait)) {
+            continue;
+        }
+        if (wait.try_transfer) {
+            wait.try_transfer();
+        }
+        events.push_back(wait.event);
+    }
+    for (const auto& event : events) {
+        event->Signal();
+    }
+
+    // Waits of client threads that are gone aren't removed by a wakeup callback
+    socket_waits.erase(std::remove_if(socket_waits.begin(), socket_waits.end(), uses_socket),
+                       socket_waits.end());
+}
+
 void SOC_U::CleanupSockets() {
     for (auto sock : open_sockets)
         closesocket(sock.second.socket_fd);
     open_sockets.clear();
+
+    socket_waits.clear();
+    if (is_poll_scheduled) {
+        system.CoreTiming().UnscheduleEvent(poll_event, 0);
+        is_poll_scheduled = false;
+    }
 }
 
 void SOC_U::Socket(Kernel::HLERequestContext& ctx) {
@@ -386,8 +594,10 @@ void SOC_U::Socket(Kernel::HLERequestContext& ctx) {
 
     u32 ret = static_cast<u32>(::socket(domain, type, protocol));
 
-    if ((s32)ret != SOCKET_ERROR_VALUE)
+    if ((s32)ret != SOCKET_ERROR_VALUE) {
+        SetHostNonBlocking(ret);
         open_sockets[ret] = {ret, true};
+    }
 
     if ((s32)ret == SOCKET_ERROR_VALUE)
         ret = TranslateError(GET_ERRNO);
@@ -432,50 +642,19 @@ void SOC_U::Fcntl(Kernel::HLERequestContext& ctx) {
         rb.Push(posix_ret);
     });
 
+    auto iter = open_sockets.find(socket_handle);
+    if (iter == open_sockets.end()) {
+        posix_ret = TranslateError(ERRNO(EBADF));
+        return;
+    }
+
+    // The host socket always stays nonblocking, only the guest's view of it changes
     if (ctr_cmd == 3) { // F_GETFL
-#ifdef _WIN32
         posix_ret = 0;
-        auto iter = open_sockets.find(socket_handle);
-        if (iter != open_sockets.end() && iter->second.blocking == false)
+        if (!iter->second.blocking)
             posix_ret |= 4; // O_NONBLOCK
-#else
-        int ret = ::fcntl(socket_handle, F_GETFL, 0);
-        if (ret == SOCKET_ERROR_VALUE) {
-            posix_ret = TranslateError(GET_ERRNO);
-            return;
-        }
-        posix_ret = 0;
-        if (ret & O_NONBLOCK)
-            posix_ret |= 4; // O_NONBLOCK
-#endif
     } else if (ctr_cmd == 4) { // F_SETFL
-#ifdef _WIN32
-        unsigned long tmp = (ctr_arg & 4 /* O_NONBLOCK */) ? 1 : 0;
-        int ret = ioctlsocket(socket_handle, FIONBIO, &tmp);
-        if (ret == SOCKET_ERROR_VALUE) {
-            posix_ret = TranslateError(GET_ERRNO);
-            return;
-        }
-        auto iter = open_sockets.find(socket_handle);
-        if (iter != open_sockets.end())
-            iter->second.blocking = (tmp == 0);
-#else
-        int flags = ::fcntl(socket_handle, F_GETFL, 0);
-        if (flags == SOCKET_ERROR_VALUE) {
-            posix_ret = TranslateError(GET_ERRNO);
-            return;
-        }
-
-        flags &= ~O_NONBLOCK;
-        if (ctr_arg & 4) // O_NONBLOCK
-            flags |= O_NONBLOCK;
-
-        int ret = ::fcntl(socket_handle, F_SETFL, flags);
-        if (ret == SOCKET_ERROR_VALUE) {
-            posix_ret = TranslateError(GET_ERRNO);
-            return;
-        }
-#endif
+        iter->second.blocking = (ctr_arg & 4 /* O_NONBLOCK */) == 0;
     } else {
         LOG_ERROR(Service_SOC, "Unsupported command ({}) in fcntl call", ctr_cmd);
         posix_ret = TranslateError(EINVAL); // TODO: Find the correct error
@@ -499,33 +678,42 @@ void SOC_U::Listen(Kernel::HLERequestContext& ctx) {
 }
 
 void SOC_U::Accept(Kernel::HLERequestContext& ctx) {
-    // TODO(Subv): Calling this function on a blocking socket will block the emu thread,
-    // preventing graceful shutdown when closing the emulator, this can be fixed by always
-    // performing nonblocking operations and spinlock until the data is available
     IPC::RequestParser rp(ctx, 0x04, 2, 2);
     u32 socket_handle = rp.Pop<u32>();
     socklen_t max_addr_len = static_cast<socklen_t>(rp.Pop<u32>());
     rp.PopPID();
-    sockaddr addr;
-    socklen_t addr_len = sizeof(addr);
-    u32 ret = static_cast<u32>(::accept(socket_handle, &addr, &addr_len));
 
-    if ((s32)ret != SOCKET_ERROR_VALUE)
-        open_sockets[ret] = {ret, true};
+    auto accept = [this, socket_handle](Kernel::HLERequestContext& ctx) {
+        sockaddr addr;
+        socklen_t addr_len = sizeof(addr);
+        u32 ret = static_cast<u32>(::accept(socket_handle, &addr, &addr_len));
 
-    CTRSockAddr ctr_addr;
-    std::vector<u8> ctr_addr_buf(sizeof(ctr_addr));
-    if ((s32)ret == SOCKET_ERROR_VALUE) {
-        ret = TranslateError(GET_ERRNO);
-    } else {
-        ctr_addr = CTRSockAddr::FromPlatform(addr);
-        std::memcpy(ctr_addr_buf.data(), &ctr_addr, sizeof(ctr_addr));
-    }
+        if ((s32)ret != SOCKET_ERROR_VALUE) {
+            SetHostNonBlocking(ret);
+            open_sockets[ret] = {ret, true};
+        }
 
-    IPC::RequestBuilder rb = rp.MakeBuilder(2, 2);
-    rb.Push(RESULT_SUCCESS);
-    rb.Push(ret);
-    rb.PushStaticBuffer(ctr_addr_buf, 0);
+        CTRSockAddr ctr_addr;
+        std::vector<u8> ctr_addr_buf(sizeof(ctr_addr));
+        if ((s32)ret == SOCKET_ERROR_VALUE) {
+            ret = TranslateError(GET_ERRNO);
+        } else {
+            ctr_addr = CTRSockAddr::FromPlatform(addr);
+            std::memcpy(ctr_addr_buf.data(), &ctr_addr, sizeof(ctr_addr));
+        }
+
+        IPC::RequestBuilder rb(ctx, 0x04, 2, 2);
+        rb.Push(RESULT_SUCCESS);
+        rb.Push(ret);
+        rb.PushStaticBuffer(ctr_addr_buf, 0);
+    };
+
+    if (IsBlocking(socket_handle) && !IsSocketReady(socket_handle, POLLIN)) {
+        SleepUntilReady(ctx, {{socket_handle, POLLIN}}, std::chrono::nanoseconds(0), "soc:accept",
+                        accept);
+        return;
+    }
+    accept(ctx);
 }
 
 void SOC_U::GetHostId(Kernel::HLERequestContext& ctx) {
@@ -559,6 +747,8 @@ void SOC_U::Close(Kernel::HLERequestContext& ctx) {
 
     if (ret != 0)
         ret = TranslateError(GET_ERRNO);
+    else
+        EndSocketWaits(socket_handle);
 
     IPC::RequestBuilder rb = rp.MakeBuilder(2, 0);
     rb.Push(RESULT_SUCCESS);
@@ -575,24 +765,19 @@ void SOC_U::SendTo(Kernel::HLERequestContext& ctx) {
     auto input_buff = rp.PopStaticBuffer();
     auto dest_addr_buff = rp.PopStaticBuffer();
 
-    s32 ret = -1;
-    if (addr_len > 0) {
-        CTRSockAddr ctr_dest_addr;
-        std::memcpy(&ctr_dest_addr, dest_addr_buff.data(), sizeof(ctr_dest_addr));
-        sockaddr dest_addr = CTRSockAddr::ToPlatform(ctr_dest_addr);
-        ret = ::sendto(socket_handle, reinterpret_cast<const char*>(input_buff.data()), len, flags,
-                       &dest_addr, sizeof(dest_addr));
-    } else {
-        ret = ::sendto(socket_handle, reinterpret_cast<const char*>(input_buff.data()), len, flags,
-                       nullptr, 0);
-    }
-
-    if (ret == SOCKET_ERROR_VALUE)
-        ret = TranslateError(GET_ERRNO);
-
-    IPC::RequestBuilder rb = rp.MakeBuilder(2, 0);
-    rb.Push(RESULT_SUCCESS);
-    rb.Push(ret);
+    input_buff.resize(len);
+    if (addr_len == 0)
+        dest_addr_buff.clear();
+
+    auto send = std::make_shared<SocketSend>(
+        SocketSend{socket_handle, std::move(input_buff), flags, std::move(dest_addr_buff)});
+    RunTransfer(ctx, socket_handle, POLLOUT, "soc:sendto",
+                [send](bool blocking) { return send->Continue(blocking); },
+                [send](Kernel::HLERequestContext& ctx) {
+                    IPC::RequestBuilder rb(ctx, 0x0A, 2, 0);
+                    rb.Push(RESULT_SUCCESS);
+                    rb.Push(send->Result());
+                });
 }
 
 void SOC_U::RecvFromOther(Kernel::HLERequestContext& ctx) {
@@ -604,43 +789,23 @@ void SOC_U::RecvFromOther(Kernel::HLERequestContext& ctx) {
     rp.PopPID();
     auto& buffer = rp.PopMappedBuffer();
 
-    CTRSockAddr ctr_src_addr;
-    std::vector<u8> output_buff(len);
-    std::vector<u8> addr_buff(sizeof(ctr_src_addr));
-    sockaddr src_addr;
-    socklen_t src_addr_len = sizeof(src_addr);
-
-    s32 ret = -1;
-    if (addr_len > 0) {
-        ret = ::recvfrom(socket_handle, reinterpret_cast<char*>(output_buff.data()), len, flags,
-                         &src_addr, &src_addr_len);
-        if (ret >= 0 && src_addr_len > 0) {
-            ctr_src_addr = CTRSockAddr::FromPlatform(src_addr);
-            std::memcpy(addr_buff.data(), &ctr_src_addr, sizeof(ctr_src_addr));
-        }
-    } else {
-        ret = ::recvfrom(socket_handle, reinterpret_cast<char*>(output_buff.data()), len, flags,
-                         NULL, 0);
-        addr_buff.resize(0);
-    }
-
-    if (ret == SOCKET_ERROR_VALUE) {
-        ret = TranslateError(GET_ERRNO);
-    } else {
-        buffer.Write(output_buff.data(), 0, ret);
-    }
-
-    IPC::RequestBuilder rb = rp.MakeBuilder(2, 4);
-    rb.Push(RESULT_SUCCESS);
-    rb.Push(ret);
-    rb.PushStaticBuffer(addr_buff, 0);
-    rb.PushMappedBuffer(buffer);
+    auto receive =
+        std::make_shared<SocketReceive>(SocketReceive{socket_handle, len, flags, addr_len > 0});
+    RunTransfer(ctx, socket_handle, POLLIN, "soc:recvfrom_other",
+                [receive](bool blocking) { return receive->Continue(blocking); },
+                [receive, buffer](Kernel::HLERequestContext& ctx) mutable {
+                    if (receive->result > 0)
+                        buffer.Write(receive->data.data(), 0, receive->result);
+
+                    IPC::RequestBuilder rb(ctx, 0x07, 2, 4);
+                    rb.Push(RESULT_SUCCESS);
+                    rb.Push(receive->result);
+                    rb.PushStaticBuffer(receive->src_addr, 0);
+                    rb.PushMappedBuffer(buffer);
+                });
 }
 
 void SOC_U::RecvFrom(Kernel::HLERequestContext& ctx) {
-    // TODO(Subv): Calling this function on a blocking socket will block the emu thread,
-    // preventing graceful shutdown when closing the emulator, this can be fixed by always
-    // performing nonblocking operations and spinlock until the data is available
     IPC::RequestParser rp(ctx, 0x08, 4, 2);
     u32 socket_handle = rp.Pop<u32>();
     u32 len = rp.Pop<u32>();
@@ -648,42 +813,22 @@ void SOC_U::RecvFrom(Kernel::HLERequestContext& ctx) {
     u32 addr_len = rp.Pop<u32>();
     rp.PopPID();
 
-    CTRSockAddr ctr_src_addr;
-    std::vector<u8> output_buff(len);
-    std::vector<u8> addr_buff(sizeof(ctr_src_addr));
-    sockaddr src_addr;
-    socklen_t src_addr_len = sizeof(src_addr);
-
-    s32 ret = -1;
-    if (addr_len > 0) {
-        // Only get src adr if input adr available
-        ret = ::recvfrom(socket_handle, reinterpret_cast<char*>(output_buff.data()), len, flags,
-                         &src_addr, &src_addr_len);
-        if (ret >= 0 && src_addr_len > 0) {
-            ctr_src_addr = CTRSockAddr::FromPlatform(src_addr);
-            std::memcpy(addr_buff.data(), &ctr_src_addr, sizeof(ctr_src_addr));
-        }
-    } else {
-        ret = ::recvfrom(socket_handle, reinterpret_cast<char*>(output_buff.data()), len, flags,
-                         NULL, 0);
-        addr_buff.resize(0);
-    }
-
-    s32 total_received = ret;
-    if (ret == SOCKET_ERROR_VALUE) {
-        ret = TranslateError(GET_ERRNO);
-        total_received = 0;
-    }
-
-    // Write only the data we received to avoid overwriting parts of the buffer with zeros
-    output_buff.resize(total_received);
-
-    IPC::RequestBuilder rb = rp.MakeBuilder(3, 4);
-    rb.Push(RESULT_SUCCESS);
-    rb.Push(ret);
-    rb.Push(total_received);
-    rb.PushStaticBuffer(output_buff, 0);
-    rb.PushStaticBuffer(addr_buff, 1);
+    auto receive =
+        std::make_shared<SocketReceive>(SocketReceive{socket_handle, len, flags, addr_len > 0});
+    RunTransfer(ctx, socket_handle, POLLIN, "soc:recvfrom",
+                [receive](bool blocking) { return receive->Continue(blocking); },
+                [receive](Kernel::HLERequestContext& ctx) {
+                    // Only the data we received is written, to avoid overwriting parts of the
+                    // buffer with zeros
+                    const s32 total_received = static_cast<s32>(receive->data.size());
+
+                    IPC::RequestBuilder rb(ctx, 0x08, 3, 4);
+                    rb.Push(RESULT_SUCCESS);
+                    rb.Push(receive->result);
+                    rb.Push(total_received);
+                    rb.PushStaticBuffer(receive->data, 0);
+                    rb.PushStaticBuffer(receive->src_addr, 1);
+                });
 }
 
 void SOC_U::Poll(Kernel::HLERequestContext& ctx) {
@@ -702,22 +847,41 @@ void SOC_U::Poll(Kernel::HLERequestContext& ctx) {
     std::vector<pollfd> platform_pollfd(nfds);
     std::transform(ctr_fds.begin(), ctr_fds.end(), platform_pollfd.begin(), CTRPollFD::ToPlatform);
 
-    s32 ret = ::poll(platform_pollfd.data(), nfds, timeout);
+    // The host is only ever polled without a timeout, waiting is done by sleeping the client
+    auto do_poll = [nfds, platform_pollfd](Kernel::HLERequestContext& ctx) mutable {
+        s32 ret = ::poll(platform_pollfd.data(), nfds, 0);
 
-    // Now update the output pollfd structure
-    std::transform(platform_pollfd.begin(), platform_pollfd.end(), ctr_fds.begin(),
-                   CTRPollFD::FromPlatform);
+        // Now update the output pollfd structure
+        std::vector<CTRPollFD> ctr_fds(nfds);
+        std::transform(platform_pollfd.begin(), platform_pollfd.end(), ctr_fds.begin(),
+                       CTRPollFD::FromPlatform);
 
-    std::vector<u8> output_fds(nfds * sizeof(CTRPollFD));
-    std::memcpy(output_fds.data(), ctr_fds.data(), nfds * sizeof(CTRPollFD));
+        std::vector<u8> output_fds(nfds * sizeof(CTRPollFD));
+        std::memcpy(output_fds.data(), ctr_fds.data(), nfds * sizeof(CTRPollFD));
 
-    if (ret == SOCKET_ERROR_VALUE)
-        ret = TranslateError(GET_ERRNO);
+        if (ret == SOCKET_ERROR_VALUE)
+            ret = TranslateError(GET_ERRNO);
 
-    IPC::RequestBuilder rb = rp.MakeBuilder(2, 2);
-    rb.Push(RESULT_SUCCESS);
-    rb.Push(ret);
-    rb.PushStaticBuffer(output_fds, 0);
+        IPC::RequestBuilder rb(ctx, 0x14, 2, 2);
+        rb.Push(RESULT_SUCCESS);
+        rb.Push(ret);
+        rb.PushStaticBuffer(output_fds, 0);
+    };
+
+    std::vector<pollfd> ready_pollfd = platform_pollfd;
+    s32 ready = ::poll(ready_pollfd.data(), nfds, 0);
+    if (ready == 0 && timeout != 0) {
+        std::vector<WaitedSocket> sockets(nfds);
+        std::transform(platform_pollfd.begin(), platform_pollfd.end(), sockets.begin(),
+                       [](const pollfd& fd) {
+                           return WaitedSocket{static_cast<u32>(fd.fd), fd.events};
+                       });
+        // A negative timeout waits indefinitely, which SleepClientThread expresses as zero
+        const auto sleep_timeout = std::chrono::milliseconds(std::max(timeout, 0));
+        SleepUntilReady(ctx, std::move(sockets), sleep_timeout, "soc:poll", do_poll);
+        return;
+    }
+    do_poll(ctx);
 }
 
 void SOC_U::GetSockName(Kernel::HLERequestContext& ctx) {
@@ -782,9 +946,6 @@ void SOC_U::GetPeerName(Kernel::HLERequestContext& ctx) {
 }
 
 void SOC_U::Connect(Kernel::HLERequestContext& ctx) {
-    // TODO(Subv): Calling this function on a blocking socket will block the emu thread,
-    // preventing graceful shutdown when closing the emulator, this can be fixed by always
-    // performing nonblocking operations and spinlock until the data is available
     IPC::RequestParser rp(ctx, 0x06, 2, 4);
     u32 socket_handle = rp.Pop<u32>();
     u32 input_addr_len = rp.Pop<u32>();
@@ -796,8 +957,31 @@ void SOC_U::Connect(Kernel::HLERequestContext& ctx) {
 
     sockaddr input_addr = CTRSockAddr::ToPlatform(ctr_input_addr);
     s32 ret = ::connect(socket_handle, &input_addr, sizeof(input_addr));
-    if (ret != 0)
-        ret = TranslateError(GET_ERRNO);
+    if (ret != 0) {
+        const int error = GET_ERRNO;
+        const bool in_progress = error == ERRNO(EINPROGRESS) || error == ERRNO(EWOULDBLOCK);
+        if (in_progress && IsBlocking(socket_handle)) {
+            // The host connects in the background, report its outcome once it is known
+            SleepUntilReady(ctx, {{socket_handle, POLLOUT}}, std::chrono::nanoseconds(0),
+                            "soc:connect", [socket_handle](Kernel::HLERequestContext& ctx) {
+                                int connect_error = 0;
+                                socklen_t error_len = sizeof(connect_error);
+                                s32 ret = ::getsockopt(socket_handle, SOL_SOCKET, SO_ERROR,
+                                                       reinterpret_cast<char*>(&connect_error),
+                                                       &error_len);
+                                if (ret != 0)
+                                    ret = TranslateError(GET_ERRNO);
+                                else if (connect_error != 0)
+                                    ret = TranslateError(connect_error);
+
+                                IPC::RequestBuilder rb(ctx, 0x06, 2, 0);
+                                rb.Push(RESULT_SUCCESS);
+                                rb.Push(ret);
+                            });
+            return;
+        }
+        ret = TranslateError(error);
+    }
 
     IPC::RequestBuilder rb = rp.MakeBuilder(2, 0);
     rb.Push(RESULT_SUCCESS);
@@ -818,6 +1002,13 @@ void SOC_U::InitializeSockets(Kernel::HLERequestContext& ctx) {
 void SOC_U::ShutdownSockets(Kernel::HLERequestContext& ctx) {
     // TODO(Subv): Implement
     IPC::RequestParser rp(ctx, 0x19, 0, 0);
+    // Unlike on emulator shutdown, the client threads still waiting on a socket are woken up
+    const auto sockets = std::move(open_sockets);
+    open_sockets.clear();
+    for (const auto& [socket_handle, socket] : sockets) {
+        closesocket(socket.socket_fd);
+        EndSocketWaits(socket.socket_fd);
+    }
     CleanupSockets();
 
     IPC::RequestBuilder rb = rp.MakeBuilder(1, 0);
@@ -977,7 +1168,7 @@ void SOC_U::GetNameInfoImpl(Kernel::HLERequestContext& ctx) {
     rb.PushStaticBuffer(serv, 1);
 }
 
-SOC_U::SOC_U() : ServiceFramework("soc:U") {
+SOC_U::SOC_U(Core::System& system) : ServiceFramework("soc:U"), system(system) {
     static const FunctionInfo functions[] = {
         {0x00010044, &SOC_U::InitializeSockets, "InitializeSockets"},
         {0x000200C2, &SOC_U::Socket, "Socket"},
@@ -1016,6 +1207,10 @@ SOC_U::SOC_U() : ServiceFramework("soc:U") {
 
     RegisterHandlers(functions);
 
+    poll_event = system.CoreTiming().RegisterEvent(
+        "SOC_U::PollSocketWaits",
+        [this](u64 userdata, s64 cycles_late) { PollSocketWaits(cycles_late); });
+
 #ifdef _WIN32
     WSADATA data;
     WSAStartup(MAKEWORD(2, 2), &data);
@@ -1031,7 +1226,7 @@ SOC_U::~SOC_U() {
 
 void InstallInterfaces(Core::System& system) {
     auto& service_manager = system.ServiceManager();
-    std::make_shared<SOC_U>()->InstallAsService(service_manager);
+    std::make_shared<SOC_U>(system)->InstallAsService(service_manager);
 }
 
 } // namespace Service::SOC
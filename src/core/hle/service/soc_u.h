@@ -4,11 +4,20 @@
 
 #pragma once
 
+#include <chrono>
+#include <functional>
+#include <string>
 #include <unordered_map>
+#include <vector>
 #include "core/hle/service/service.h"
 
 namespace Core {
 class System;
+struct TimingEventType;
+} // namespace Core
+
+namespace Kernel {
+class Event;
 }
 
 namespace Service::SOC {
@@ -16,12 +25,57 @@ namespace Service::SOC {
 /// Holds information about a particular socket
 struct SocketHolder {
     u32 socket_fd; ///< The socket descriptor
-    bool blocking; ///< Whether the socket is blocking or not, it is only read on Windows.
+    bool blocking; ///< Whether the guest sees the socket as blocking, the host one never is
+};
+
+/// A guest send on a nonblocking host socket, which may take several attempts to complete
+struct SocketSend {
+    u32 socket_fd;
+    std::vector<u8> data;
+    u32 flags;
+    std::vector<u8> dest_addr; ///< The destination CTRSockAddr, empty for connected sockets
+
+    u32 sent = 0;  ///< Number of bytes of data that were sent so far
+    s32 error = 0; ///< The 3DS error of the last failed attempt, zero if there was none
+
+    /**
+     * Sends what is left of the data.
+     * @param blocking Whether the guest socket is blocking, in which case the send only ends once
+     *                 all the data was sent or an error other than the socket not being ready
+     *                 occurred
+     * @returns true if the send ended, false if it should be continued once the socket is writable
+     */
+    bool Continue(bool blocking);
+
+    /// Returns the number of bytes sent, or the error if nothing was sent
+    s32 Result() const;
+};
+
+/// A guest receive on a nonblocking host socket, which may take several attempts to complete
+struct SocketReceive {
+    u32 socket_fd;
+    u32 len;
+    u32 flags;
+    bool want_src_addr; ///< Whether the source address should be returned in src_addr
+
+    s32 result = 0;           ///< The number of bytes received or a 3DS error
+    std::vector<u8> data;     ///< The received data
+    std::vector<u8> src_addr; ///< The source CTRSockAddr, empty if it was not requested
+
+    /**
+     * Receives whatever data is available, like a host recvfrom call.
+     * @param blocking Whether the guest socket is blocking, in which case the receive only ends
+     *                 once some data was received or an error other than the socket not being
+     *                 ready occurred
+     * @returns true if the receive ended, false if it should be continued once the socket is
+     *          readable
+     */
+    bool Continue(bool blocking);
 };
 
 class SOC_U final : public ServiceFramework<SOC_U> {
 public:
-    SOC_U();
+    explicit SOC_U(Core::System& system);
     ~SOC_U();
 
 private:
@@ -50,11 +104,65 @@ private:
     void GetAddrInfoImpl(Kernel::HLERequestContext& ctx);
     void GetNameInfoImpl(Kernel::HLERequestContext& ctx);
 
-    /// Close all open sockets
+    /// Close all open sockets, and stop waiting for them without waking the client threads
     void CleanupSockets();
 
+    /// Whether operations on the socket should wait for it to become ready
+    bool IsBlocking(u32 socket_handle) const;
+
+    struct WaitedSocket {
+        u32 socket_fd; ///< The socket descriptor
+        s16 events;    ///< Host poll events that end the wait
+    };
+
+    /**
+     * Puts the client thread to sleep until one of the sockets is ready, then calls on_ready to
+     * perform the operation and write the response.
+     * @param timeout Time after which on_ready is called anyway, zero to wait indefinitely
+     * @param try_transfer If set, called whenever the sockets are ready and the thread is only
+     *                     woken up once it returns true
+     */
+    void SleepUntilReady(Kernel::HLERequestContext& ctx, std::vector<WaitedSocket> sockets,
+                         std::chrono::nanoseconds timeout, const std::string& reason,
+                         std::function<void(Kernel::HLERequestContext&)> on_ready,
+                         std::function<bool()> try_transfer = nullptr);
+
+    /**
+     * Tries a transfer on the socket right away. If a blocking socket could not complete it, the
+     * client thread sleeps and the transfer is continued whenever the socket is ready, until it
+     * completes. Either way on_done writes the response once the transfer ended.
+     * @param try_transfer Continues the transfer, returns whether it ended. Its argument tells
+     *                     whether the guest socket is blocking.
+     */
+    void RunTransfer(Kernel::HLERequestContext& ctx, u32 socket_handle, s16 events,
+                     const std::string& reason, std::function<bool(bool)> try_transfer,
+                     std::function<void(Kernel::HLERequestContext&)> on_done);
+
+    /// Wakes the client threads whose sockets became ready
+    void PollSocketWaits(s64 cycles_late);
+
+    /**
+     * Ends the waits on a socket that was just closed. The client threads are woken up, and their
+     * transfers fail on the closed descriptor.
+     */
+    void EndSocketWaits(u32 socket_fd);
+
+    Core::System& system;
+
     /// Holds info about the currently open sockets
     std::unordered_map<u32, SocketHolder> open_sockets;
+
+    struct SocketWait {
+        u64 id;
+        std::vector<WaitedSocket> sockets;
+        std::shared_ptr<Kernel::Event> event; ///< Wakes the sleeping client thread
+        std::function<bool()> try_transfer; ///< Empty if the wait ends once a socket is ready
+    };
+    std::vector<SocketWait> socket_waits;
+    u64 next_wait_id = 0;
+
+    Core::TimingEventType* poll_event;
+    bool is_poll_scheduled = false;
 };
 
 void InstallInterfaces(Core::System& system);
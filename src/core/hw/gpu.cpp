@@ -17,6 +17,7 @@
 #include "core/hw/gpu.h"
 #include "core/hw/hw.h"
 #include "core/memory.h"
+#include "core/rpc/rpc_server.h"
 #include "core/tracer/recorder.h"
 #include "video_core/command_processor.h"
 #include "video_core/debug_utils/debug_utils.h"
@@ -523,8 +524,16 @@ static void VBlankCallback(u64 userdata, s64 cycles_late) {
     Service::GSP::SignalInterrupt(Service::GSP::InterruptId::PDC0);
     Service::GSP::SignalInterrupt(Service::GSP::InterruptId::PDC1);
 
+    auto& system = Core::System::GetInstance();
+    system.RPCServer().NotifyVBlank();
+
+    if (system.perf_reporter) {
+        system.perf_reporter->NotifyVBlank(*system.perf_stats,
+                                           system.CoreTiming().GetGlobalTimeUs());
+    }
+
     // Reschedule recurrent event
-    Core::System::GetInstance().CoreTiming().ScheduleEvent(frame_ticks - cycles_late, vblank_event);
+    system.CoreTiming().ScheduleEvent(frame_ticks - cycles_late, vblank_event);
 }
 
 /// Initialize hardware
@@ -93,6 +93,9 @@ void MemorySystem::MapPages(PageTable& page_table, u32 base, u32 size, u8* memor
 
         page_table.attributes[base] = type;
         page_table.pointers[base] = memory;
+        if (!page_table.watched_pointers.empty()) {
+            page_table.watched_pointers.erase(base);
+        }
 
         // If the memory to map is already rasterizer-cached, mark the page
         if (type == PageType::Memory && impl->cache_marker.IsCached(base * PAGE_SIZE)) {
@@ -162,6 +165,21 @@ static MMIORegionPointer GetMMIOHandler(const PageTable& page_table, VAddr vaddr
     return nullptr; // Should never happen
 }
 
+/**
+ * Gets the backing memory of a page mapped to regular memory, even if its pointer has been removed
+ * because it is watched by the debugger.
+ */
+static u8* GetMemoryPagePointer(const PageTable& page_table, std::size_t page_index) {
+    u8* page_pointer = page_table.pointers[page_index];
+    if (page_pointer == nullptr) {
+        const auto watched = page_table.watched_pointers.find(static_cast<u32>(page_index));
+        if (watched != page_table.watched_pointers.end()) {
+            page_pointer = watched->second;
+        }
+    }
+    return page_pointer;
+}
+
 template <typename T>
 T ReadMMIO(MMIORegionPointer mmio_handler, VAddr addr);
 
@@ -180,9 +198,15 @@ T MemorySystem::Read(const VAddr vaddr) {
     case PageType::Unmapped:
         LOG_ERROR(HW_Memory, "unmapped Read{} @ 0x{:08X}", sizeof(T) * 8, vaddr);
         return 0;
-    case PageType::Memory:
-        ASSERT_MSG(false, "Mapped memory page without a pointer @ {:08X}", vaddr);
-        break;
+    case PageType::Memory: {
+        // Pages watched by the debugger have their pointer removed to route the accesses here
+        page_pointer = GetMemoryPagePointer(*impl->current_page_table, vaddr >> PAGE_BITS);
+        ASSERT_MSG(page_pointer, "Mapped memory page without a pointer @ {:08X}", vaddr);
+
+        T value;
+        std::memcpy(&value, &page_pointer[vaddr & PAGE_MASK], sizeof(T));
+        return value;
+    }
     case PageType::RasterizerCachedMemory: {
         RasterizerFlushVirtualRegion(vaddr, sizeof(T), FlushMode::Flush);
 
@@ -215,9 +239,13 @@ void MemorySystem::Write(const VAddr vaddr, const T data) {
         LOG_ERROR(HW_Memory, "unmapped Write{} 0x{:08X} @ 0x{:08X}", sizeof(data) * 8, (u32)data,
                   vaddr);
         return;
-    case PageType::Memory:
-        ASSERT_MSG(false, "Mapped memory page without a pointer @ {:08X}", vaddr);
+    case PageType::Memory: {
+        // Pages watched by the debugger have their pointer removed to route the accesses here
+        page_pointer = GetMemoryPagePointer(*impl->current_page_table, vaddr >> PAGE_BITS);
+        ASSERT_MSG(page_pointer, "Mapped memory page without a pointer @ {:08X}", vaddr);
+        std::memcpy(&page_pointer[vaddr & PAGE_MASK], &data, sizeof(T));
         break;
+    }
     case PageType::RasterizerCachedMemory: {
         RasterizerFlushVirtualRegion(vaddr, sizeof(T), FlushMode::Invalidate);
         std::memcpy(GetPointerForRasterizerCache(vaddr), &data, sizeof(T));
@@ -234,7 +262,7 @@ void MemorySystem::Write(const VAddr vaddr, const T data) {
 bool IsValidVirtualAddress(const Kernel::Process& process, const VAddr vaddr) {
     auto& page_table = process.vm_manager.page_table;
 
-    const u8* page_pointer = page_table.pointers[vaddr >> PAGE_BITS];
+    const u8* page_pointer = GetMemoryPagePointer(page_table, vaddr >> PAGE_BITS);
     if (page_pointer)
         return true;
 
@@ -257,7 +285,7 @@ bool MemorySystem::IsValidPhysicalAddress(const PAddr paddr) {
 }
 
 u8* MemorySystem::GetPointer(const VAddr vaddr) {
-    u8* page_pointer = impl->current_page_table->pointers[vaddr >> PAGE_BITS];
+    u8* page_pointer = GetMemoryPagePointer(*impl->current_page_table, vaddr >> PAGE_BITS);
     if (page_pointer) {
         return page_pointer + (vaddr & PAGE_MASK);
     }
@@ -389,8 +417,11 @@ void MemorySystem::RasterizerMarkRegionCached(PAddr start, u32 size, bool cached
                         break;
                     case PageType::RasterizerCachedMemory: {
                         page_type = PageType::Memory;
-                        page_table->pointers[vaddr >> PAGE_BITS] =
-                            GetPointerForRasterizerCache(vaddr & ~PAGE_MASK);
+                        // Watched pages keep going through the slow path
+                        if (page_table->watched_pointers.count(vaddr >> PAGE_BITS) == 0) {
+                            page_table->pointers[vaddr >> PAGE_BITS] =
+                                GetPointerForRasterizerCache(vaddr & ~PAGE_MASK);
+                        }
                         break;
                     }
                     default:
@@ -402,6 +433,38 @@ void MemorySystem::RasterizerMarkRegionCached(PAddr start, u32 size, bool cached
     }
 }
 
+void MemorySystem::SetRegionWatched(Kernel::Process& process, VAddr start, u32 size,
+                                    bool watched) {
+    if (size == 0) {
+        return;
+    }
+
+    auto& page_table = process.vm_manager.page_table;
+    const u32 first_page = start >> PAGE_BITS;
+    const u32 last_page = (start + size - 1) >> PAGE_BITS;
+    for (u32 page_index = first_page; page_index <= last_page; ++page_index) {
+        if (watched) {
+            // Accesses to the other page types take the slow path anyway
+            if (page_table.attributes[page_index] == PageType::Memory &&
+                page_table.pointers[page_index] != nullptr) {
+                page_table.watched_pointers.emplace(page_index, page_table.pointers[page_index]);
+                page_table.pointers[page_index] = nullptr;
+            }
+            continue;
+        }
+
+        const auto iter = page_table.watched_pointers.find(page_index);
+        if (iter == page_table.watched_pointers.end()) {
+            continue;
+        }
+        // A page that is rasterizer cached right now gets its pointer back once it is flushed
+        if (page_table.attributes[page_index] == PageType::Memory) {
+            page_table.pointers[page_index] = iter->second;
+        }
+        page_table.watched_pointers.erase(iter);
+    }
+}
+
 void RasterizerFlushRegion(PAddr start, u32 size) {
     if (VideoCore::g_renderer == nullptr) {
         return;
@@ -504,9 +567,10 @@ void MemorySystem::ReadBlock(const Kernel::Process& process, const VAddr src_add
             break;
         }
         case PageType::Memory: {
-            DEBUG_ASSERT(page_table.pointers[page_index]);
+            const u8* page_pointer = GetMemoryPagePointer(page_table, page_index);
+            DEBUG_ASSERT(page_pointer);
 
-            const u8* src_ptr = page_table.pointers[page_index] + page_offset;
+            const u8* src_ptr = page_pointer + page_offset;
             std::memcpy(dest_buffer, src_ptr, copy_amount);
             break;
         }
@@ -568,9 +632,10 @@ void MemorySystem::WriteBlock(const Kernel::Process& process, const VAddr dest_a
             break;
         }
         case PageType::Memory: {
-            DEBUG_ASSERT(page_table.pointers[page_index]);
+            u8* page_pointer = GetMemoryPagePointer(page_table, page_index);
+            DEBUG_ASSERT(page_pointer);
 
-            u8* dest_ptr = page_table.pointers[page_index] + page_offset;
+            u8* dest_ptr = page_pointer + page_offset;
             std::memcpy(dest_ptr, src_buffer, copy_amount);
             break;
         }
@@ -618,9 +683,10 @@ void MemorySystem::ZeroBlock(const Kernel::Process& process, const VAddr dest_ad
             break;
         }
         case PageType::Memory: {
-            DEBUG_ASSERT(page_table.pointers[page_index]);
+            u8* page_pointer = GetMemoryPagePointer(page_table, page_index);
+            DEBUG_ASSERT(page_pointer);
 
-            u8* dest_ptr = page_table.pointers[page_index] + page_offset;
+            u8* dest_ptr = page_pointer + page_offset;
             std::memset(dest_ptr, 0, copy_amount);
             break;
         }
@@ -672,8 +738,9 @@ void MemorySystem::CopyBlock(const Kernel::Process& dest_process,
             break;
         }
         case PageType::Memory: {
-            DEBUG_ASSERT(page_table.pointers[page_index]);
-            const u8* src_ptr = page_table.pointers[page_index] + page_offset;
+            const u8* page_pointer = GetMemoryPagePointer(page_table, page_index);
+            DEBUG_ASSERT(page_pointer);
+            const u8* src_ptr = page_pointer + page_offset;
             WriteBlock(dest_process, dest_addr, src_ptr, copy_amount);
             break;
         }
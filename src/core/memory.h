@@ -8,6 +8,7 @@
 #include <cstddef>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include "common/common_types.h"
 #include "core/mmio.h"
@@ -78,6 +79,13 @@ struct PageTable {
      * the corresponding entry in `pointers` MUST be set to null.
      */
     std::array<PageType, PAGE_TABLE_NUM_ENTRIES> attributes;
+
+    /**
+     * Backing memory of `Memory` pages that are watched by the debugger. Their entries in
+     * `pointers` are null, so that every access to them takes the slow path, where the CPU backends
+     * check for watchpoints.
+     */
+    std::unordered_map<u32, u8*> watched_pointers;
 };
 
 /// Physical memory regions as seen from the ARM11
@@ -287,6 +295,12 @@ public:
      */
     void RasterizerMarkRegionCached(PAddr start, u32 size, bool cached);
 
+    /**
+     * Marks each page touching the region in the page table of the process as watched by the
+     * debugger, or removes the mark. Only pages mapped to regular memory are affected.
+     */
+    void SetRegionWatched(Kernel::Process& process, VAddr start, u32 size, bool watched);
+
     /// Registers page table for rasterizer cache marking
     void RegisterPageTable(PageTable* page_table);
 
@@ -2,7 +2,9 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
 #include <cstring>
+#include <optional>
 #include <string>
 #include <vector>
 #include <boost/optional.hpp>
@@ -15,6 +17,7 @@
 #include "common/string_util.h"
 #include "common/swap.h"
 #include "common/timer.h"
+#include "common/zstd_compression.h"
 #include "core/core.h"
 #include "core/hle/service/hid/hid.h"
 #include "core/hle/service/ir/extra_hid.h"
@@ -109,20 +112,63 @@ struct ControllerState {
 static_assert(sizeof(ControllerState) == 7, "ControllerState should be 7 bytes");
 #pragma pack(pop)
 
-constexpr std::array<u8, 4> header_magic_bytes{{'C', 'T', 'M', 0x1B}};
+/// Movies recorded before the input was split into chunks, they only hold raw records
+constexpr std::array<u8, 4> legacy_header_magic_bytes{{'C', 'T', 'M', 0x1B}};
+/// Changed with the chunked format, so that older versions of Citra reject these movies
+constexpr std::array<u8, 4> header_magic_bytes{{'C', 'T', 'M', 0x1C}};
+
+enum class InputFormat : u32 {
+    Raw = 0,     ///< The records follow the header uncompressed
+    Chunked = 1, ///< The records are split into zstd compressed chunks, followed by an index
+};
+
+/// Number of input records that are compressed together, about half a minute of input
+constexpr u32 RecordsPerChunk = 8192;
 
 #pragma pack(push, 1)
 struct CTMHeader {
-    std::array<u8, 4> filetype;  /// Unique Identifier to check the file type (always "CTM"0x1B)
+    std::array<u8, 4> filetype;  /// Unique Identifier to check the file type (always "CTM"0x1C)
     u64_le program_id;           /// ID of the ROM being executed. Also called title_id
     std::array<u8, 20> revision; /// Git hash of the revision this movie was created with
     u64_le clock_init_time;      /// The init time of the system clock
+    u32_le input_format;         /// How the input records are stored, see InputFormat
+    u64_le index_offset;         /// Offset of the chunk index, 0 if the recording was not finished
+    u32_le num_chunks;           /// Number of entries in the chunk index
+    u64_le num_records;          /// Number of input records, 0 if the recording was not finished
 
-    std::array<u8, 216> reserved; /// Make heading 256 bytes so it has consistent size
+    std::array<u8, 192> reserved; /// Make heading 256 bytes so it has consistent size
 };
 static_assert(sizeof(CTMHeader) == 256, "CTMHeader should be 256 bytes");
+
+/// Precedes the compressed records of every chunk
+struct ChunkHeader {
+    u32_le compressed_size;
+    u32_le num_records;
+};
+static_assert(sizeof(ChunkHeader) == 8, "ChunkHeader should be 8 bytes");
+
+struct ChunkIndexEntry {
+    u64_le offset;       /// Offset of the ChunkHeader in the file
+    u64_le first_record; /// Index of the first input record in the chunk
+};
+static_assert(sizeof(ChunkIndexEntry) == 16, "ChunkIndexEntry should be 16 bytes");
 #pragma pack(pop)
 
+/// Returns how the input of the movie is stored, or nothing if the movie is not supported
+static std::optional<InputFormat> GetInputFormat(const CTMHeader& header) {
+    if (header.filetype == legacy_header_magic_bytes) {
+        // The input format was still reserved, and always zero, when these movies were recorded
+        if (header.input_format == static_cast<u32>(InputFormat::Raw)) {
+            return InputFormat::Raw;
+        }
+    } else if (header.filetype == header_magic_bytes) {
+        if (header.input_format == static_cast<u32>(InputFormat::Chunked)) {
+            return InputFormat::Chunked;
+        }
+    }
+    return std::nullopt;
+}
+
 bool Movie::IsPlayingInput() const {
     return play_mode == PlayMode::Playing;
 }
@@ -131,6 +177,14 @@ bool Movie::IsRecordingInput() const {
 }
 
 void Movie::CheckInputEnd() {
+    // Continue with the next chunk, if there is one
+    while (current_byte + sizeof(ControllerState) > recorded_input.size() &&
+           current_chunk + 1 < chunk_index.size()) {
+        if (!LoadChunk(current_chunk + 1)) {
+            break;
+        }
+    }
+
     if (current_byte + sizeof(ControllerState) > recorded_input.size()) {
         LOG_INFO(Movie, "Playback finished");
         play_mode = PlayMode::None;
@@ -266,6 +320,10 @@ void Movie::Record(const ControllerState& controller_state) {
     recorded_input.resize(current_byte + sizeof(ControllerState));
     std::memcpy(&recorded_input[current_byte], &controller_state, sizeof(ControllerState));
     current_byte += sizeof(ControllerState);
+
+    if (current_byte == RecordsPerChunk * sizeof(ControllerState)) {
+        FlushChunk();
+    }
 }
 
 void Movie::Record(const Service::HID::PadState& pad_state, const s16& circle_pad_x,
@@ -359,14 +417,14 @@ u64 Movie::GetOverrideInitTime() const {
 }
 
 Movie::ValidationResult Movie::ValidateHeader(const CTMHeader& header, u64 program_id) const {
-    if (header_magic_bytes != header.filetype) {
+    if (!GetInputFormat(header)) {
         LOG_ERROR(Movie, "Playback file does not have valid header");
         return ValidationResult::Invalid;
     }
 
     std::string revision = fmt::format("{:02x}", fmt::join(header.revision, ""));
 
-    if (!program_id)
+    if (!program_id && Core::System::GetInstance().IsPoweredOn())
         Core::System::GetInstance().GetAppLoader().ReadProgramId(program_id);
     if (program_id != header.program_id) {
         LOG_WARNING(Movie, "This movie was recorded using a ROM with a different program id");
@@ -382,30 +440,136 @@ Movie::ValidationResult Movie::ValidateHeader(const CTMHeader& header, u64 progr
     return ValidationResult::OK;
 }
 
-void Movie::SaveMovie() {
-    LOG_INFO(Movie, "Saving recorded movie to '{}'", record_movie_file);
-    FileUtil::IOFile save_record(record_movie_file, "wb");
-
-    if (!save_record.IsGood()) {
-        LOG_ERROR(Movie, "Unable to open file to save movie");
-        return;
-    }
-
+static CTMHeader MakeHeader(u64 init_time) {
     CTMHeader header = {};
     header.filetype = header_magic_bytes;
     header.clock_init_time = init_time;
+    header.input_format = static_cast<u32>(InputFormat::Chunked);
 
-    Core::System::GetInstance().GetAppLoader().ReadProgramId(header.program_id);
+    if (Core::System::GetInstance().IsPoweredOn())
+        Core::System::GetInstance().GetAppLoader().ReadProgramId(header.program_id);
 
     std::string rev_bytes;
     CryptoPP::StringSource(Common::g_scm_rev, true,
                            new CryptoPP::HexDecoder(new CryptoPP::StringSink(rev_bytes)));
     std::memcpy(header.revision.data(), rev_bytes.data(), sizeof(CTMHeader::revision));
+    return header;
+}
+
+void Movie::FlushChunk() {
+    if (recorded_input.empty() || !movie_file_handle) {
+        return;
+    }
+
+    const std::vector<u8> compressed =
+        Common::Compression::CompressDataZSTDDefault(recorded_input.data(), recorded_input.size());
+    const u32 num_records = static_cast<u32>(recorded_input.size() / sizeof(ControllerState));
+
+    ChunkIndexEntry entry{};
+    entry.offset = movie_file_handle->Tell();
+    entry.first_record = chunk_first_record;
+    chunk_index.push_back(entry);
+
+    ChunkHeader chunk_header{};
+    chunk_header.compressed_size = static_cast<u32>(compressed.size());
+    chunk_header.num_records = num_records;
+    movie_file_handle->WriteBytes(&chunk_header, sizeof(ChunkHeader));
+    movie_file_handle->WriteBytes(compressed.data(), compressed.size());
+
+    if (!movie_file_handle->IsGood()) {
+        LOG_ERROR(Movie, "Error writing movie");
+    }
+
+    chunk_first_record += num_records;
+    recorded_input.clear();
+    current_byte = 0;
+}
+
+bool Movie::ReadChunkIndex(const CTMHeader& header) {
+    chunk_index.clear();
+    FileUtil::IOFile& file = *movie_file_handle;
+
+    if (header.index_offset != 0) {
+        if (header.index_offset + header.num_chunks * sizeof(ChunkIndexEntry) > file.GetSize()) {
+            return false;
+        }
+        chunk_index.resize(header.num_chunks);
+        total_records = header.num_records;
+        file.Seek(header.index_offset, SEEK_SET);
+        return file.ReadArray(chunk_index.data(), chunk_index.size()) == chunk_index.size();
+    }
+
+    // The recording was interrupted before the index was written, rebuild it from the chunks
+    LOG_WARNING(Movie, "Movie has no chunk index, recovering the recorded chunks");
+    const u64 file_size = file.GetSize();
+    u64 offset = sizeof(CTMHeader);
+    u64 first_record = 0;
+    ChunkHeader chunk_header;
+    while (offset + sizeof(ChunkHeader) <= file_size) {
+        file.Seek(offset, SEEK_SET);
+        if (file.ReadBytes(&chunk_header, sizeof(ChunkHeader)) != sizeof(ChunkHeader) ||
+            offset + sizeof(ChunkHeader) + chunk_header.compressed_size > file_size) {
+            break;
+        }
+
+        ChunkIndexEntry entry{};
+        entry.offset = offset;
+        entry.first_record = first_record;
+        chunk_index.push_back(entry);
+
+        offset += sizeof(ChunkHeader) + chunk_header.compressed_size;
+        first_record += chunk_header.num_records;
+    }
+    total_records = first_record;
+    return true;
+}
+
+bool Movie::LoadChunk(std::size_t chunk) {
+    FileUtil::IOFile& file = *movie_file_handle;
+    file.Seek(chunk_index[chunk].offset, SEEK_SET);
+
+    ChunkHeader chunk_header{};
+    std::vector<u8> compressed;
+    if (file.ReadBytes(&chunk_header, sizeof(ChunkHeader)) == sizeof(ChunkHeader) &&
+        chunk_header.compressed_size <= file.GetSize()) {
+        compressed.resize(chunk_header.compressed_size);
+        compressed.resize(file.ReadBytes(compressed.data(), compressed.size()));
+    }
+
+    recorded_input = Common::Compression::DecompressDataZSTD(compressed);
+    current_chunk = chunk;
+    current_byte = 0;
+
+    if (chunk_header.num_records == 0 || chunk_header.num_records > RecordsPerChunk ||
+        compressed.size() != chunk_header.compressed_size ||
+        recorded_input.size() != chunk_header.num_records * sizeof(ControllerState)) {
+        LOG_ERROR(Movie, "Movie chunk {} is corrupted", chunk);
+        recorded_input.clear();
+        return false;
+    }
+    return true;
+}
 
-    save_record.WriteBytes(&header, sizeof(CTMHeader));
-    save_record.WriteBytes(recorded_input.data(), recorded_input.size());
+void Movie::SaveMovie() {
+    LOG_INFO(Movie, "Saving recorded movie to '{}'", record_movie_file);
 
-    if (!save_record.IsGood()) {
+    if (!movie_file_handle || !movie_file_handle->IsGood()) {
+        LOG_ERROR(Movie, "Unable to open file to save movie");
+        return;
+    }
+
+    FlushChunk();
+
+    // The index and the header pointing to it are only written once the recording is complete
+    CTMHeader header = MakeHeader(init_time);
+    header.index_offset = movie_file_handle->Tell();
+    header.num_chunks = static_cast<u32>(chunk_index.size());
+    header.num_records = chunk_first_record;
+    movie_file_handle->WriteArray(chunk_index.data(), chunk_index.size());
+    movie_file_handle->Seek(0, SEEK_SET);
+    movie_file_handle->WriteBytes(&header, sizeof(CTMHeader));
+
+    if (!movie_file_handle->IsGood()) {
         LOG_ERROR(Movie, "Error saving movie");
     }
 }
@@ -413,28 +577,91 @@ void Movie::SaveMovie() {
 void Movie::StartPlayback(const std::string& movie_file,
                           std::function<void()> completion_callback) {
     LOG_INFO(Movie, "Loading Movie for playback");
-    FileUtil::IOFile save_record(movie_file, "rb");
+    movie_file_handle = std::make_unique<FileUtil::IOFile>(movie_file, "rb");
+    FileUtil::IOFile& save_record = *movie_file_handle;
     const u64 size = save_record.GetSize();
 
-    if (save_record.IsGood() && size > sizeof(CTMHeader)) {
-        CTMHeader header;
-        save_record.ReadArray(&header, 1);
-        if (ValidateHeader(header) != ValidationResult::Invalid) {
-            play_mode = PlayMode::Playing;
-            recorded_input.resize(size - sizeof(CTMHeader));
-            save_record.ReadArray(recorded_input.data(), recorded_input.size());
-            current_byte = 0;
-            playback_completion_callback = completion_callback;
-        }
-    } else {
+    if (!save_record.IsGood() || size <= sizeof(CTMHeader)) {
         LOG_ERROR(Movie, "Failed to playback movie: Unable to open '{}'", movie_file);
+        movie_file_handle.reset();
+        return;
     }
+
+    CTMHeader header;
+    save_record.ReadArray(&header, 1);
+    if (ValidateHeader(header) == ValidationResult::Invalid) {
+        movie_file_handle.reset();
+        return;
+    }
+
+    if (GetInputFormat(header) == InputFormat::Raw) {
+        // Movies recorded before the input was split into chunks are loaded at once
+        chunk_index.clear();
+        recorded_input.resize(size - sizeof(CTMHeader));
+        save_record.ReadArray(recorded_input.data(), recorded_input.size());
+        total_records = recorded_input.size() / sizeof(ControllerState);
+        current_byte = 0;
+    } else if (!ReadChunkIndex(header) || chunk_index.empty() || !LoadChunk(0)) {
+        LOG_ERROR(Movie, "Failed to playback movie: '{}' has no valid input", movie_file);
+        movie_file_handle.reset();
+        return;
+    }
+
+    play_mode = PlayMode::Playing;
+    playback_completion_callback = completion_callback;
 }
 
 void Movie::StartRecording(const std::string& movie_file) {
     LOG_INFO(Movie, "Enabling Movie recording");
-    play_mode = PlayMode::Recording;
     record_movie_file = movie_file;
+
+    // The input is streamed to the file while recording, so that it doesn't pile up in memory
+    movie_file_handle = std::make_unique<FileUtil::IOFile>(movie_file, "wb");
+    if (!movie_file_handle->IsGood()) {
+        LOG_ERROR(Movie, "Unable to open file to record movie");
+        movie_file_handle.reset();
+        return;
+    }
+    const CTMHeader header = MakeHeader(init_time);
+    movie_file_handle->WriteBytes(&header, sizeof(CTMHeader));
+
+    play_mode = PlayMode::Recording;
+    recorded_input.clear();
+    chunk_index.clear();
+    chunk_first_record = 0;
+    current_byte = 0;
+}
+
+bool Movie::SeekToRecord(u64 record) {
+    if (!IsPlayingInput() || record >= total_records) {
+        return false;
+    }
+
+    if (chunk_index.empty()) {
+        current_byte = record * sizeof(ControllerState);
+        return true;
+    }
+
+    // Find the last chunk that starts at or before the record
+    auto itr = std::upper_bound(
+        chunk_index.begin(), chunk_index.end(), record,
+        [](u64 record, const ChunkIndexEntry& entry) { return record < entry.first_record; });
+    const std::size_t chunk = std::distance(chunk_index.begin(), itr) - 1;
+    const std::size_t byte = (record - chunk_index[chunk].first_record) * sizeof(ControllerState);
+    if (chunk != current_chunk) {
+        const std::size_t previous_chunk = current_chunk;
+        const std::size_t previous_byte = current_byte;
+        if (!LoadChunk(chunk) || byte + sizeof(ControllerState) > recorded_input.size()) {
+            // Keep playing from where playback was, that chunk was loaded fine before
+            LoadChunk(previous_chunk);
+            current_byte = previous_byte;
+            return false;
+        }
+    } else if (byte + sizeof(ControllerState) > recorded_input.size()) {
+        return false;
+    }
+    current_byte = byte;
+    return true;
 }
 
 static boost::optional<CTMHeader> ReadHeader(const std::string& movie_file) {
@@ -448,7 +675,7 @@ static boost::optional<CTMHeader> ReadHeader(const std::string& movie_file) {
     CTMHeader header;
     save_record.ReadArray(&header, 1);
 
-    if (header_magic_bytes != header.filetype) {
+    if (!GetInputFormat(header)) {
         return boost::none;
     }
 
@@ -492,7 +719,12 @@ void Movie::Shutdown() {
     }
 
     play_mode = PlayMode::None;
+    movie_file_handle.reset();
     recorded_input.resize(0);
+    chunk_index.clear();
+    current_chunk = 0;
+    chunk_first_record = 0;
+    total_records = 0;
     record_movie_file.clear();
     current_byte = 0;
     init_time = 0;
@@ -5,8 +5,15 @@
 #pragma once
 
 #include <functional>
+#include <memory>
+#include <string>
+#include <vector>
 #include "common/common_types.h"
 
+namespace FileUtil {
+class IOFile;
+}
+
 namespace Service {
 namespace HID {
 struct AccelerometerDataEntry;
@@ -22,6 +29,7 @@ union PadState;
 
 namespace Core {
 struct CTMHeader;
+struct ChunkIndexEntry;
 struct ControllerState;
 enum class PlayMode;
 
@@ -59,6 +67,13 @@ public:
 
     void Shutdown();
 
+    /**
+     * Moves playback to the given input record. Playback only stays in sync if the state of the
+     * emulated system matches the new position.
+     * @returns Whether the record exists and playback was moved to it
+     */
+    bool SeekToRecord(u64 record);
+
     /**
      * When recording: Takes a copy of the given input states so they can be used for playback
      * When playing: Replaces the given input states with the ones stored in the playback file
@@ -124,11 +139,26 @@ private:
 
     ValidationResult ValidateHeader(const CTMHeader& header, u64 program_id = 0) const;
 
+    /// Compresses the records of the current chunk and appends them to the movie file
+    void FlushChunk();
+    /// Reads the chunk index of a movie file, rebuilding it if the recording was not finished
+    bool ReadChunkIndex(const CTMHeader& header);
+    /// Loads the records of the given chunk for playback
+    bool LoadChunk(std::size_t chunk);
+
     void SaveMovie();
 
     PlayMode play_mode;
     std::string record_movie_file;
+    std::unique_ptr<FileUtil::IOFile> movie_file_handle;
+    /// Input records of the current chunk. Movies without chunks are held here entirely.
     std::vector<u8> recorded_input;
+    std::vector<ChunkIndexEntry> chunk_index;
+    std::size_t current_chunk = 0;
+    /// Number of records in the chunks that were written before the current one
+    u64 chunk_first_record = 0;
+    /// Number of records in the movie that is played back
+    u64 total_records = 0;
     u64 init_time;
     std::function<void()> playback_completion_callback;
     std::size_t current_byte = 0;
@@ -0,0 +1,191 @@
+// Copyright 2020 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <fmt/format.h>
+#include "common/common_paths.h"
+#include "common/detached_tasks.h"
+#include "common/file_util.h"
+#include "common/logging/log.h"
+#include "common/scm_rev.h"
+#include "common/zstd_compression.h"
+#include "core/loader/loader.h"
+#include "core/perf_reporter.h"
+#include "core/perf_stats.h"
+#include "core/telemetry_session.h"
+#include "video_core/video_core.h"
+
+#ifdef ENABLE_WEB_SERVICE
+#include "web_service/perf_report.h"
+#endif
+
+namespace Core {
+
+constexpr u32 RecordMagic = Loader::MakeMagic('C', 'P', 'R', 'F');
+constexpr u32 RecordVersion = 1;
+constexpr char RecordExtension[] = ".zst";
+
+static u64 GetTimestamp() {
+    return static_cast<u64>(std::chrono::duration_cast<std::chrono::milliseconds>(
+                                std::chrono::system_clock::now().time_since_epoch())
+                                .count());
+}
+
+/// Lists the records in the spool directory, oldest first
+static std::vector<std::string> GetSpooledRecords(const std::string& spool_dir) {
+    std::vector<std::string> records;
+    FileUtil::ForeachDirectoryEntry(
+        nullptr, spool_dir,
+        [&records](u64*, const std::string& directory, const std::string& virtual_name) {
+            const std::size_t extension_length = std::strlen(RecordExtension);
+            if (virtual_name.size() > extension_length &&
+                virtual_name.compare(virtual_name.size() - extension_length, extension_length,
+                                     RecordExtension) == 0) {
+                records.push_back(directory + virtual_name);
+            }
+            return true;
+        });
+    // The file names start with the zero-padded creation time
+    std::sort(records.begin(), records.end());
+    return records;
+}
+
+PerfReporter::PerfReporter(u64 title_id, std::string report_url_)
+    : report_url(std::move(report_url_)),
+      spool_dir(FileUtil::GetUserPath(FileUtil::UserPath::LogDir) + "perf_reports" DIR_SEP) {
+    FileUtil::CreateFullPath(spool_dir);
+
+    header.magic = RecordMagic;
+    header.version = RecordVersion;
+    header.telemetry_id = GetTelemetryId();
+    header.title_id = title_id;
+    std::strncpy(header.git_revision.data(), Common::g_scm_rev, header.git_revision.size());
+    header.sample_size = sizeof(Sample);
+
+    samples.reserve(SamplesPerRecord);
+    last_shaders_compiled = VideoCore::g_shaders_compiled;
+    last_shader_cache_hits = VideoCore::g_shader_cache_hits;
+    last_shader_cache_misses = VideoCore::g_shader_cache_misses;
+
+    UploadSpooledRecords();
+}
+
+PerfReporter::~PerfReporter() {
+    if (!samples.empty()) {
+        SpoolRecord();
+        UploadSpooledRecords();
+    }
+}
+
+void PerfReporter::NotifyVBlank(PerfStats& perf_stats,
+                                std::chrono::microseconds current_system_time_us) {
+    if (++frames_since_sample < SampleFrames) {
+        return;
+    }
+    frames_since_sample = 0;
+
+    TakeSample(perf_stats, current_system_time_us);
+    if (samples.size() == SamplesPerRecord) {
+        SpoolRecord();
+        UploadSpooledRecords();
+    }
+}
+
+void PerfReporter::TakeSample(PerfStats& perf_stats,
+                              std::chrono::microseconds current_system_time_us) {
+    const auto frame_sample = perf_stats.GetAndResetFrameSample(current_system_time_us);
+
+    // The counters only ever grow, so the differences are correct even after they wrapped around
+    const u32 shaders_compiled = VideoCore::g_shaders_compiled;
+    const u32 shader_cache_hits = VideoCore::g_shader_cache_hits;
+    const u32 shader_cache_misses = VideoCore::g_shader_cache_misses;
+
+    Sample sample{};
+    sample.timestamp = GetTimestamp();
+    sample.system_frames = frame_sample.system_frames;
+    sample.game_frames = frame_sample.game_frames;
+    sample.interval = static_cast<float>(frame_sample.interval);
+    sample.emulation_speed = static_cast<float>(frame_sample.emulation_speed);
+    sample.frametime_p50 = static_cast<float>(frame_sample.frametime_p50);
+    sample.frametime_p90 = static_cast<float>(frame_sample.frametime_p90);
+    sample.frametime_p99 = static_cast<float>(frame_sample.frametime_p99);
+    sample.frametime_max = static_cast<float>(frame_sample.frametime_max);
+    sample.shaders_compiled = shaders_compiled - last_shaders_compiled;
+    sample.shader_cache_hits = shader_cache_hits - last_shader_cache_hits;
+    sample.shader_cache_misses = shader_cache_misses - last_shader_cache_misses;
+    samples.push_back(sample);
+
+    last_shaders_compiled = shaders_compiled;
+    last_shader_cache_hits = shader_cache_hits;
+    last_shader_cache_misses = shader_cache_misses;
+}
+
+void PerfReporter::SpoolRecord() {
+    header.sample_count = static_cast<u32>(samples.size());
+
+    std::vector<u8> record(sizeof(RecordHeader) + samples.size() * sizeof(Sample));
+    std::memcpy(record.data(), &header, sizeof(RecordHeader));
+    std::memcpy(record.data() + sizeof(RecordHeader), samples.data(),
+                samples.size() * sizeof(Sample));
+    samples.clear();
+
+    const std::vector<u8> compressed =
+        Common::Compression::CompressDataZSTDDefault(record.data(), record.size());
+    if (compressed.empty()) {
+        LOG_ERROR(Core, "Failed to compress performance report");
+        return;
+    }
+
+    // Write to a temporary file first, so that an upload never sees a partially written record
+    const std::string path =
+        fmt::format("{}{:016}_{:016X}{}", spool_dir, GetTimestamp(), header.title_id,
+                    RecordExtension);
+    const std::string temp_path = path + ".tmp";
+    {
+        FileUtil::IOFile file(temp_path, "wb");
+        if (!file.IsOpen() || file.WriteBytes(compressed.data(), compressed.size()) !=
+                                  compressed.size()) {
+            LOG_ERROR(Core, "Failed to write performance report {}", temp_path);
+            return;
+        }
+    }
+    FileUtil::Rename(temp_path, path);
+
+    const auto records = GetSpooledRecords(spool_dir);
+    if (records.size() > MaxSpooledRecords) {
+        LOG_WARNING(Core, "Too many performance reports spooled, dropping the oldest {}",
+                    records.size() - MaxSpooledRecords);
+        std::for_each(records.begin(), records.end() - MaxSpooledRecords,
+                      [](const std::string& record) { FileUtil::Delete(record); });
+    }
+}
+
+void PerfReporter::UploadSpooledRecords() const {
+#ifdef ENABLE_WEB_SERVICE
+    if (report_url.empty()) {
+        return;
+    }
+    Common::DetachedTasks::AddTask([spool_dir{spool_dir}, report_url{report_url}] {
+        // Only one task uploads at a time, the others find the records already uploaded
+        static std::mutex upload_mutex;
+        std::lock_guard lock{upload_mutex};
+
+        for (const auto& record : GetSpooledRecords(spool_dir)) {
+            std::string data;
+            if (FileUtil::ReadFileToString(false, record, data) == 0) {
+                continue;
+            }
+            if (!WebService::SubmitPerfReport(report_url, data)) {
+                // The server is unreachable, retry with the next record
+                return;
+            }
+            FileUtil::Delete(record);
+        }
+    });
+#endif
+}
+
+} // namespace Core
@@ -0,0 +1,104 @@
+// Copyright 2020 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <string>
+#include <vector>
+#include "common/common_funcs.h"
+#include "common/common_types.h"
+#include "common/swap.h"
+
+namespace Core {
+
+class PerfStats;
+
+/**
+ * Periodically samples the performance of the emulation, complementing the one-time fields of the
+ * TelemetrySession. A sample is taken every SampleFrames system frames, and the samples are batched
+ * into compressed records which are spooled to disk. The records are uploaded in the background,
+ * records which failed to upload are retried with the next record or in a later session.
+ */
+class PerfReporter {
+public:
+    /// Every record starts with this header, followed by sample_count samples
+    struct RecordHeader {
+        u32_le magic;
+        u32_le version;
+        u64_le telemetry_id;
+        u64_le title_id;
+        std::array<char, 40> git_revision;
+        u32_le sample_count;
+        u32_le sample_size;
+    };
+    static_assert(sizeof(RecordHeader) == 72, "RecordHeader has incorrect size");
+
+    struct Sample {
+        /// Wall clock time at the end of the sample, in milliseconds since the epoch
+        u64_le timestamp;
+        u32_le system_frames;
+        u32_le game_frames;
+        /// Walltime covered by the sample, in seconds
+        float_le interval;
+        float_le emulation_speed;
+        /// Percentiles of the walltime per system frame, in milliseconds
+        float_le frametime_p50;
+        float_le frametime_p90;
+        float_le frametime_p99;
+        float_le frametime_max;
+        /// Shader cache activity during the sample
+        u32_le shaders_compiled;
+        u32_le shader_cache_hits;
+        u32_le shader_cache_misses;
+        INSERT_PADDING_WORDS(1);
+    };
+    static_assert(sizeof(Sample) == 56, "Sample has incorrect size");
+
+    /**
+     * Creates a reporter for the running title, and starts uploading the records left over from
+     * previous sessions.
+     * @param title_id Title ID of the running title
+     * @param report_url URL of the server the records are uploaded to, the records are only
+     *     spooled if it is empty
+     */
+    PerfReporter(u64 title_id, std::string report_url);
+    ~PerfReporter();
+
+    /**
+     * Counts a system frame, and takes a sample once enough frames have passed.
+     * @param perf_stats The performance statistics of the running session
+     * @param current_system_time_us Current emulated time
+     */
+    void NotifyVBlank(PerfStats& perf_stats, std::chrono::microseconds current_system_time_us);
+
+private:
+    /// Number of system frames per sample, about ten seconds at full speed
+    static constexpr u32 SampleFrames = 600;
+    /// Number of samples per record, about five minutes at full speed
+    static constexpr std::size_t SamplesPerRecord = 30;
+    /// Oldest records are dropped beyond this, so that an unreachable server can't fill the disk
+    static constexpr std::size_t MaxSpooledRecords = 64;
+
+    void TakeSample(PerfStats& perf_stats, std::chrono::microseconds current_system_time_us);
+
+    /// Compresses the pending samples into a record and writes it to the spool directory
+    void SpoolRecord();
+
+    /// Uploads the spooled records in the background
+    void UploadSpooledRecords() const;
+
+    RecordHeader header{};
+    std::vector<Sample> samples;
+    std::string report_url;
+    std::string spool_dir;
+
+    u32 frames_since_sample = 0;
+    u32 last_shaders_compiled = 0;
+    u32 last_shader_cache_hits = 0;
+    u32 last_shader_cache_misses = 0;
+};
+
+} // namespace Core
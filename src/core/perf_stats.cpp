@@ -24,6 +24,9 @@ using std::chrono::microseconds;
 // booting that we shouldn't account for
 constexpr std::size_t IgnoreFrames = 5;
 
+// A minute of frames, far more than the performance reports sample at once
+constexpr std::size_t MaxSampleFrames = 3600;
+
 namespace Core {
 
 PerfStats::PerfStats(u64 title_id) : title_id(title_id) {}
@@ -60,6 +63,10 @@ void PerfStats::EndSystemFrame() {
         perf_history[current_index++] =
             std::chrono::duration<double, std::milli>(frame_time).count();
     }
+    sample_system_frames += 1;
+    if (sample_frametimes.size() < MaxSampleFrames) {
+        sample_frametimes.push_back(std::chrono::duration<float, std::milli>(frame_time).count());
+    }
     accumulated_frametime += frame_time;
     system_frames += 1;
 
@@ -71,6 +78,7 @@ void PerfStats::EndGameFrame() {
     std::lock_guard lock{object_mutex};
 
     game_frames += 1;
+    sample_game_frames += 1;
 }
 
 double PerfStats::GetMeanFrametime() {
@@ -110,6 +118,41 @@ PerfStats::Results PerfStats::GetAndResetStats(microseconds current_system_time_
     return results;
 }
 
+PerfStats::FrameSample PerfStats::GetAndResetFrameSample(microseconds current_system_time_us) {
+    std::lock_guard lock(object_mutex);
+
+    const auto now = Clock::now();
+    const auto interval = duration_cast<DoubleSecs>(now - sample_reset_point).count();
+    const auto system_us_per_second =
+        (current_system_time_us - sample_reset_point_system_us) / interval;
+
+    FrameSample sample{};
+    sample.interval = interval;
+    sample.emulation_speed = system_us_per_second.count() / 1'000'000.0;
+    sample.system_frames = sample_system_frames;
+    sample.game_frames = sample_game_frames;
+    if (!sample_frametimes.empty()) {
+        std::sort(sample_frametimes.begin(), sample_frametimes.end());
+        const auto percentile = [this](double fraction) -> double {
+            const auto index = static_cast<std::size_t>(fraction * sample_frametimes.size());
+            return sample_frametimes[std::min(index, sample_frametimes.size() - 1)];
+        };
+        sample.frametime_p50 = percentile(0.50);
+        sample.frametime_p90 = percentile(0.90);
+        sample.frametime_p99 = percentile(0.99);
+        sample.frametime_max = sample_frametimes.back();
+    }
+
+    // Reset counters
+    sample_reset_point = now;
+    sample_reset_point_system_us = current_system_time_us;
+    sample_frametimes.clear();
+    sample_system_frames = 0;
+    sample_game_frames = 0;
+
+    return sample;
+}
+
 double PerfStats::GetLastFrameTimeScale() {
     std::lock_guard lock{object_mutex};
 
@@ -125,7 +168,7 @@ void FrameLimiter::DoFrameLimiting(microseconds current_system_time_us) {
         return;
     }
 
-    if (!Settings::values.use_frame_limit) {
+    if (!Settings::values.use_frame_limit || Settings::values.use_turbo_mode) {
         return;
     }
 
@@ -9,6 +9,7 @@
 #include <chrono>
 #include <cstddef>
 #include <mutex>
+#include <vector>
 #include "common/common_types.h"
 #include "common/thread.h"
 
@@ -37,12 +38,35 @@ public:
         double emulation_speed;
     };
 
+    /// Performance of the system frames since the previous sample, used by the PerfReporter
+    struct FrameSample {
+        /// Walltime covered by the sample, in seconds
+        double interval;
+        /// Ratio of walltime / emulated time elapsed
+        double emulation_speed;
+        /// Number of system frames (LCD VBlanks) in the sample
+        u32 system_frames;
+        /// Number of game frames (GSP frame submissions) in the sample
+        u32 game_frames;
+        /// Percentiles of the walltime per system frame, in milliseconds, excluding any waits
+        double frametime_p50;
+        double frametime_p90;
+        double frametime_p99;
+        double frametime_max;
+    };
+
     void BeginSystemFrame();
     void EndSystemFrame();
     void EndGameFrame();
 
     Results GetAndResetStats(std::chrono::microseconds current_system_time_us);
 
+    /**
+     * Gets the performance of the frames since the previous call. This is independent of
+     * GetAndResetStats, so that the periodic reports don't interfere with the frontend.
+     */
+    FrameSample GetAndResetFrameSample(std::chrono::microseconds current_system_time_us);
+
     /**
      * Returns the Arthimetic Mean of all frametime values stored in the performance history.
      */
@@ -83,6 +107,18 @@ private:
     Clock::time_point frame_begin = reset_point;
     /// Total visible duration (including frame-limiting, etc.) of the previous system frame
     Clock::duration previous_frame_length = Clock::duration::zero();
+
+    /// Frametimes in milliseconds of the system frames since the last frame sample. Only the
+    /// first MaxSampleFrames frames are kept, in case no one takes the samples.
+    std::vector<float> sample_frametimes;
+    /// Cumulative number of system frames since the last frame sample
+    u32 sample_system_frames = 0;
+    /// Cumulative number of game frames since the last frame sample
+    u32 sample_game_frames = 0;
+    /// Point when the last frame sample was taken
+    Clock::time_point sample_reset_point = reset_point;
+    /// System time when the last frame sample was taken
+    std::chrono::microseconds sample_reset_point_system_us{0};
 };
 
 class FrameLimiter {
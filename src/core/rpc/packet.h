@@ -4,8 +4,9 @@
 
 #pragma once
 
-#include <array>
 #include <functional>
+#include <string>
+#include <vector>
 #include "common/common_types.h"
 
 namespace RPC {
@@ -14,6 +15,11 @@ enum class PacketType {
     Undefined = 0,
     ReadMemory,
     WriteMemory,
+    // Version 2
+    ReadMemoryBatch,
+    WriteMemoryBatch,
+    Subscribe,
+    Unsubscribe,
 };
 
 struct PacketHeader {
@@ -23,15 +29,22 @@ struct PacketHeader {
     u32 packet_size;
 };
 
-constexpr u32 CURRENT_VERSION = 1;
+constexpr u32 CURRENT_VERSION = 2;
 constexpr u32 MIN_PACKET_SIZE = sizeof(PacketHeader);
-constexpr u32 MAX_PACKET_DATA_SIZE = 32;
-constexpr u32 MAX_PACKET_SIZE = MIN_PACKET_SIZE + MAX_PACKET_DATA_SIZE;
+/// Largest payload of a UDP datagram over IPv4
+constexpr u32 MAX_PACKET_SIZE = 65507;
+constexpr u32 MAX_PACKET_DATA_SIZE = MAX_PACKET_SIZE - MIN_PACKET_SIZE;
 constexpr u32 MAX_READ_SIZE = MAX_PACKET_DATA_SIZE;
+/// Maximum number of subscriptions that are served at the same time
+constexpr u32 MAX_SUBSCRIPTIONS = 16;
+/// Number of VBlanks after which a subscription expires, about ten seconds at full speed. Clients
+/// renew a subscription by sending its Subscribe request again, with the same id.
+constexpr u32 SUBSCRIPTION_LEASE_FRAMES = 600;
 
 class Packet {
 public:
-    Packet(const PacketHeader& header, u8* data, std::function<void(Packet&)> send_reply_callback);
+    Packet(const PacketHeader& header, u8* data, std::string client_endpoint,
+           std::function<void(Packet&)> send_reply_callback);
 
     u32 GetVersion() const {
         return header.version;
@@ -53,12 +66,23 @@ public:
         return header;
     }
 
-    std::array<u8, MAX_PACKET_DATA_SIZE>& GetPacketData() {
+    /// Identifies the client that sent the packet
+    const std::string& GetClientEndpoint() const {
+        return client_endpoint;
+    }
+
+    std::vector<u8>& GetPacketData() {
+        return packet_data;
+    }
+
+    const std::vector<u8>& GetPacketData() const {
         return packet_data;
     }
 
+    /// Sets the size of the data, resizing the buffer returned by GetPacketData accordingly
     void SetPacketDataSize(u32 size) {
         header.packet_size = size;
+        packet_data.resize(size);
     }
 
     void SendReply() {
@@ -70,7 +94,8 @@ private:
     void HandleWriteMemory(u32 address, const u8* data, u32 data_size);
 
     struct PacketHeader header;
-    std::array<u8, MAX_PACKET_DATA_SIZE> packet_data;
+    std::vector<u8> packet_data;
+    std::string client_endpoint;
 
     std::function<void(Packet&)> send_reply_callback;
 };
@@ -1,3 +1,6 @@
+#include <algorithm>
+#include <cstring>
+#include <tuple>
 #include "common/logging/log.h"
 #include "core/arm/arm_interface.h"
 #include "core/core.h"
@@ -29,31 +32,185 @@ void RPCServer::HandleReadMemory(Packet& packet, u32 address, u32 data_size) {
         return;
     }
 
-    // Note: Memory read occurs asynchronously from the state of the emulator
+    packet.SetPacketDataSize(data_size);
     Core::System::GetInstance().Memory().ReadBlock(
         *Core::System::GetInstance().Kernel().GetCurrentProcess(), address,
         packet.GetPacketData().data(), data_size);
-    packet.SetPacketDataSize(data_size);
     packet.SendReply();
 }
 
+/// Only allow writing to certain memory regions, the whole range has to be inside one of them
+static bool IsWritableRange(u32 address, u32 data_size) {
+    const u64 end = static_cast<u64>(address) + data_size;
+    const auto is_inside = [address, end](u32 region_start, u32 region_end) {
+        return address >= region_start && end <= region_end;
+    };
+    return is_inside(Memory::PROCESS_IMAGE_VADDR, Memory::PROCESS_IMAGE_VADDR_END) ||
+           is_inside(Memory::HEAP_VADDR, Memory::HEAP_VADDR_END) ||
+           is_inside(Memory::N3DS_EXTRA_RAM_VADDR, Memory::N3DS_EXTRA_RAM_VADDR_END);
+}
+
+static void WriteMemory(u32 address, const u8* data, u32 data_size) {
+    if (!IsWritableRange(address, data_size)) {
+        return;
+    }
+    Core::System::GetInstance().Memory().WriteBlock(
+        *Core::System::GetInstance().Kernel().GetCurrentProcess(), address, data, data_size);
+    // If the memory happens to be executable code, make sure the changes become visible
+
+    // Is current core correct here?
+    Core::System::GetInstance().InvalidateCacheRange(address, data_size);
+}
+
 void RPCServer::HandleWriteMemory(Packet& packet, u32 address, const u8* data, u32 data_size) {
-    // Only allow writing to certain memory regions
-    if ((address >= Memory::PROCESS_IMAGE_VADDR && address <= Memory::PROCESS_IMAGE_VADDR_END) ||
-        (address >= Memory::HEAP_VADDR && address <= Memory::HEAP_VADDR_END) ||
-        (address >= Memory::N3DS_EXTRA_RAM_VADDR && address <= Memory::N3DS_EXTRA_RAM_VADDR_END)) {
-        // Note: Memory write occurs asynchronously from the state of the emulator
-        Core::System::GetInstance().Memory().WriteBlock(
-            *Core::System::GetInstance().Kernel().GetCurrentProcess(), address, data, data_size);
-        // If the memory happens to be executable code, make sure the changes become visible
-
-        // Is current core correct here?
-        Core::System::GetInstance().InvalidateCacheRange(address, data_size);
+    WriteMemory(address, data, data_size);
+    packet.SetPacketDataSize(0);
+    packet.SendReply();
+}
+
+std::optional<RPCServer::MemoryRanges> RPCServer::ParseMemoryRanges(const Packet& packet) {
+    const u32 packet_size = packet.GetPacketDataSize();
+    if (packet_size == 0 || packet_size % (sizeof(u32) * 2) != 0) {
+        return std::nullopt;
+    }
+
+    MemoryRanges ranges(packet_size / (sizeof(u32) * 2));
+    u64 total_size = 0;
+    for (std::size_t i = 0; i < ranges.size(); ++i) {
+        const u8* range_data = packet.GetPacketData().data() + i * sizeof(u32) * 2;
+        std::memcpy(&ranges[i].first, range_data, sizeof(u32));
+        std::memcpy(&ranges[i].second, range_data + sizeof(u32), sizeof(u32));
+        total_size += ranges[i].second;
+    }
+
+    // The data of all ranges has to fit into a single reply
+    if (total_size == 0 || total_size > MAX_READ_SIZE) {
+        return std::nullopt;
+    }
+    return ranges;
+}
+
+void RPCServer::ReadMemoryRanges(Packet& packet, const MemoryRanges& ranges) {
+    u32 total_size = 0;
+    for (const auto& [address, size] : ranges) {
+        total_size += size;
+    }
+    packet.SetPacketDataSize(total_size);
+
+    auto& system = Core::System::GetInstance();
+    const auto& process = *system.Kernel().GetCurrentProcess();
+    u8* data = packet.GetPacketData().data();
+    for (const auto& [address, size] : ranges) {
+        system.Memory().ReadBlock(process, address, data, size);
+        data += size;
+    }
+}
+
+void RPCServer::HandleReadMemoryBatch(Packet& packet, const MemoryRanges& ranges) {
+    ReadMemoryRanges(packet, ranges);
+    packet.SendReply();
+}
+
+bool RPCServer::HandleWriteMemoryBatch(Packet& packet) {
+    // Every write is an address and a size followed by the data itself
+    const u8* data = packet.GetPacketData().data();
+    const u8* const end = data + packet.GetPacketDataSize();
+    std::vector<std::tuple<u32, const u8*, u32>> writes;
+    while (data != end) {
+        if (static_cast<std::size_t>(end - data) < sizeof(u32) * 2) {
+            return false;
+        }
+        u32 address = 0;
+        u32 data_size = 0;
+        std::memcpy(&address, data, sizeof(address));
+        std::memcpy(&data_size, data + sizeof(address), sizeof(data_size));
+        data += sizeof(u32) * 2;
+        if (data_size == 0 || data_size > static_cast<std::size_t>(end - data)) {
+            return false;
+        }
+        writes.emplace_back(address, data, data_size);
+        data += data_size;
+    }
+
+    // Only apply the writes once the whole packet has been validated
+    for (const auto& [address, write_data, data_size] : writes) {
+        WriteMemory(address, write_data, data_size);
+    }
+    packet.SetPacketDataSize(0);
+    packet.SendReply();
+    return true;
+}
+
+std::vector<RPCServer::Subscription>::iterator RPCServer::FindSubscription(const Packet& packet,
+                                                                           u32 id) {
+    return std::find_if(subscriptions.begin(), subscriptions.end(),
+                        [&packet, id](const Subscription& subscription) {
+                            return subscription.packet->GetId() == id &&
+                                   subscription.packet->GetClientEndpoint() ==
+                                       packet.GetClientEndpoint();
+                        });
+}
+
+bool RPCServer::HandleSubscribe(std::unique_ptr<Packet>& packet, MemoryRanges ranges) {
+    // Subscribing again with the same id renews the lease, and replaces the ranges
+    const auto existing = FindSubscription(*packet, packet->GetId());
+    if (existing == subscriptions.end() && subscriptions.size() >= MAX_SUBSCRIPTIONS) {
+        LOG_WARNING(RPC_Server, "Too many subscriptions, rejecting id={}", packet->GetId());
+        return false;
+    }
+
+    // The first reply acknowledges the subscription with the current contents of the ranges
+    ReadMemoryRanges(*packet, ranges);
+    packet->SendReply();
+
+    Subscription subscription{std::move(packet), std::move(ranges),
+                              frame_count + SUBSCRIPTION_LEASE_FRAMES};
+    if (existing != subscriptions.end()) {
+        *existing = std::move(subscription);
+    } else {
+        subscriptions.push_back(std::move(subscription));
+    }
+    return true;
+}
+
+void RPCServer::HandleUnsubscribe(Packet& packet, u32 subscription_id) {
+    const auto itr = FindSubscription(packet, subscription_id);
+    if (itr != subscriptions.end()) {
+        subscriptions.erase(itr);
     }
     packet.SetPacketDataSize(0);
     packet.SendReply();
 }
 
+void RPCServer::NotifyVBlank() {
+    // Only handle the requests that arrived before this VBlank, so that a client flooding the
+    // server can't stall the emulation thread
+    for (std::size_t pending = request_queue.Size(); pending > 0; --pending) {
+        std::unique_ptr<Packet> request_packet;
+        request_queue.Pop(request_packet);
+        HandleSingleRequest(std::move(request_packet));
+    }
+
+    // Drop the subscriptions of clients that stopped renewing them, so that scripts which exited
+    // without unsubscribing don't use up the subscription slots
+    ++frame_count;
+    subscriptions.erase(std::remove_if(subscriptions.begin(), subscriptions.end(),
+                                       [this](const Subscription& subscription) {
+                                           if (subscription.expiry_frame > frame_count) {
+                                               return false;
+                                           }
+                                           LOG_DEBUG(RPC_Server, "Subscription id={} expired",
+                                                     subscription.packet->GetId());
+                                           return true;
+                                       }),
+                        subscriptions.end());
+
+    for (auto& subscription : subscriptions) {
+        ReadMemoryRanges(*subscription.packet, subscription.ranges);
+        subscription.packet->SendReply();
+    }
+}
+
 bool RPCServer::ValidatePacket(const PacketHeader& packet_header) {
     if (packet_header.version <= CURRENT_VERSION) {
         switch (packet_header.packet_type) {
@@ -63,6 +220,18 @@ bool RPCServer::ValidatePacket(const PacketHeader& packet_header) {
                 return true;
             }
             break;
+        case PacketType::ReadMemoryBatch:
+        case PacketType::WriteMemoryBatch:
+        case PacketType::Subscribe:
+            if (packet_header.version >= 2 && packet_header.packet_size >= (sizeof(u32) * 2)) {
+                return true;
+            }
+            break;
+        case PacketType::Unsubscribe:
+            if (packet_header.version >= 2 && packet_header.packet_size == sizeof(u32)) {
+                return true;
+            }
+            break;
         default:
             break;
         }
@@ -74,27 +243,51 @@ void RPCServer::HandleSingleRequest(std::unique_ptr<Packet> request_packet) {
     bool success = false;
 
     if (ValidatePacket(request_packet->GetHeader())) {
-        // Currently, all request types use the address/data_size wire format
-        u32 address = 0;
-        u32 data_size = 0;
-        std::memcpy(&address, request_packet->GetPacketData().data(), sizeof(address));
-        std::memcpy(&data_size, request_packet->GetPacketData().data() + sizeof(address),
-                    sizeof(data_size));
+        const u8* packet_data = request_packet->GetPacketData().data();
 
         switch (request_packet->GetPacketType()) {
         case PacketType::ReadMemory:
-            if (data_size > 0 && data_size <= MAX_READ_SIZE) {
-                HandleReadMemory(*request_packet, address, data_size);
+        case PacketType::WriteMemory: {
+            // Single requests use the address/data_size wire format
+            u32 address = 0;
+            u32 data_size = 0;
+            std::memcpy(&address, packet_data, sizeof(address));
+            std::memcpy(&data_size, packet_data + sizeof(address), sizeof(data_size));
+
+            if (request_packet->GetPacketType() == PacketType::ReadMemory) {
+                if (data_size > 0 && data_size <= MAX_READ_SIZE) {
+                    HandleReadMemory(*request_packet, address, data_size);
+                    success = true;
+                }
+            } else if (data_size > 0 &&
+                       data_size <= request_packet->GetPacketDataSize() - (sizeof(u32) * 2)) {
+                const u8* data = packet_data + (sizeof(u32) * 2);
+                HandleWriteMemory(*request_packet, address, data, data_size);
                 success = true;
             }
             break;
-        case PacketType::WriteMemory:
-            if (data_size > 0 && data_size <= MAX_PACKET_DATA_SIZE - (sizeof(u32) * 2)) {
-                const u8* data = request_packet->GetPacketData().data() + (sizeof(u32) * 2);
-                HandleWriteMemory(*request_packet, address, data, data_size);
+        }
+        case PacketType::ReadMemoryBatch:
+            if (auto ranges = ParseMemoryRanges(*request_packet)) {
+                HandleReadMemoryBatch(*request_packet, *ranges);
                 success = true;
             }
             break;
+        case PacketType::WriteMemoryBatch:
+            success = HandleWriteMemoryBatch(*request_packet);
+            break;
+        case PacketType::Subscribe:
+            if (auto ranges = ParseMemoryRanges(*request_packet)) {
+                success = HandleSubscribe(request_packet, std::move(*ranges));
+            }
+            break;
+        case PacketType::Unsubscribe: {
+            u32 subscription_id = 0;
+            std::memcpy(&subscription_id, packet_data, sizeof(subscription_id));
+            HandleUnsubscribe(*request_packet, subscription_id);
+            success = true;
+            break;
+        }
         default:
             break;
         }
@@ -107,29 +300,18 @@ void RPCServer::HandleSingleRequest(std::unique_ptr<Packet> request_packet) {
     }
 }
 
-void RPCServer::HandleRequestsLoop() {
-    std::unique_ptr<RPC::Packet> request_packet;
-
-    LOG_INFO(RPC_Server, "Request handler started.");
-
-    while ((request_packet = request_queue.PopWait())) {
-        HandleSingleRequest(std::move(request_packet));
-    }
-}
-
 void RPCServer::QueueRequest(std::unique_ptr<RPC::Packet> request) {
     request_queue.Push(std::move(request));
 }
 
 void RPCServer::Start() {
-    const auto threadFunction = [this]() { HandleRequestsLoop(); };
-    request_handler_thread = std::thread(threadFunction);
     server.Start();
 }
 
 void RPCServer::Stop() {
+    // The subscriptions reply through the server
+    subscriptions.clear();
     server.Stop();
-    request_handler_thread.join();
 }
 
 }; // namespace RPC
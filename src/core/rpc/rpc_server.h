@@ -4,10 +4,10 @@
 
 #pragma once
 
-#include <condition_variable>
 #include <memory>
-#include <mutex>
-#include <thread>
+#include <optional>
+#include <utility>
+#include <vector>
 #include "common/threadsafe_queue.h"
 #include "core/rpc/server.h"
 
@@ -21,20 +21,52 @@ public:
     RPCServer();
     ~RPCServer();
 
+    /// Queues a request received by the server, it is handled at the next VBlank
     void QueueRequest(std::unique_ptr<RPC::Packet> request);
 
+    /**
+     * Handles the queued requests, then sends the watched memory ranges to the subscribed clients.
+     * Called at each VBlank on the emulation thread, so that the requests never race with the
+     * emulated CPU and each batch sees a consistent snapshot of one frame.
+     */
+    void NotifyVBlank();
+
 private:
+    /// A list of (address, size) pairs
+    using MemoryRanges = std::vector<std::pair<u32, u32>>;
+
     void Start();
     void Stop();
     void HandleReadMemory(Packet& packet, u32 address, u32 data_size);
     void HandleWriteMemory(Packet& packet, u32 address, const u8* data, u32 data_size);
+    void HandleReadMemoryBatch(Packet& packet, const MemoryRanges& ranges);
+    bool HandleWriteMemoryBatch(Packet& packet);
+    bool HandleSubscribe(std::unique_ptr<Packet>& packet, MemoryRanges ranges);
+    void HandleUnsubscribe(Packet& packet, u32 subscription_id);
     bool ValidatePacket(const PacketHeader& packet_header);
     void HandleSingleRequest(std::unique_ptr<Packet> request);
-    void HandleRequestsLoop();
+
+    /// Parses the (address, size) pairs of a batched read or subscription request
+    static std::optional<MemoryRanges> ParseMemoryRanges(const Packet& packet);
+    /// Copies the ranges into the data of the packet, one after another
+    static void ReadMemoryRanges(Packet& packet, const MemoryRanges& ranges);
+
+    struct Subscription {
+        /// The Subscribe request, which is replied to with every update
+        std::unique_ptr<Packet> packet;
+        MemoryRanges ranges;
+        /// The subscription is dropped at this VBlank unless the client renews it first
+        u64 expiry_frame;
+    };
+
+    /// Returns the subscription with the id that was made by the sender of the packet
+    std::vector<Subscription>::iterator FindSubscription(const Packet& packet, u32 id);
 
     Server server;
     Common::SPSCQueue<std::unique_ptr<Packet>> request_queue;
-    std::thread request_handler_thread;
+    std::vector<Subscription> subscriptions;
+    /// Number of VBlanks so far, used for the subscription leases
+    u64 frame_count = 0;
 };
 
 } // namespace RPC
@@ -25,17 +25,12 @@ void Server::Start() {
 
 void Server::Stop() {
     udp_server.reset();
-    NewRequestCallback(nullptr); // Notify the RPC server to end
 }
 
 void Server::NewRequestCallback(std::unique_ptr<RPC::Packet> new_request) {
-    if (new_request) {
-        LOG_INFO(RPC_Server, "Received request version={} id={} type={} size={}",
-                 new_request->GetVersion(), new_request->GetId(),
-                 static_cast<u32>(new_request->GetPacketType()), new_request->GetPacketDataSize());
-    } else {
-        LOG_INFO(RPC_Server, "Received end packet");
-    }
+    LOG_TRACE(RPC_Server, "Received request version={} id={} type={} size={}",
+              new_request->GetVersion(), new_request->GetId(),
+              static_cast<u32>(new_request->GetPacketType()), new_request->GetPacketDataSize());
     rpc_server.QueueRequest(std::move(new_request));
 }
 
@@ -2,8 +2,10 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <array>
 #include <thread>
 #include <boost/asio.hpp>
+#include <fmt/format.h>
 #include "common/common_types.h"
 #include "common/logging/log.h"
 #include "core/rpc/packet.h"
@@ -46,8 +48,10 @@ private:
                 u8* data = request_buffer.data() + MIN_PACKET_SIZE;
                 std::function<void(Packet&)> send_reply_callback =
                     std::bind(&Impl::SendReply, this, remote_endpoint, std::placeholders::_1);
-                std::unique_ptr<Packet> new_packet =
-                    std::make_unique<Packet>(header, data, send_reply_callback);
+                std::string client_endpoint = fmt::format(
+                    "{}:{}", remote_endpoint.address().to_string(), remote_endpoint.port());
+                std::unique_ptr<Packet> new_packet = std::make_unique<Packet>(
+                    header, data, std::move(client_endpoint), send_reply_callback);
 
                 // Send the request to the upper layer for handling
                 new_request_callback(std::move(new_packet));
@@ -72,10 +76,10 @@ private:
         if (error) {
             LOG_WARNING(RPC_Server, "Failed to send reply: {}", error.message());
         } else {
-            LOG_INFO(RPC_Server, "Sent reply version({}) id=({}) type=({}) size=({})",
-                     reply_packet.GetVersion(), reply_packet.GetId(),
-                     static_cast<u32>(reply_packet.GetPacketType()),
-                     reply_packet.GetPacketDataSize());
+            LOG_TRACE(RPC_Server, "Sent reply version({}) id=({}) type=({}) size=({})",
+                      reply_packet.GetVersion(), reply_packet.GetId(),
+                      static_cast<u32>(reply_packet.GetPacketType()),
+                      reply_packet.GetPacketDataSize());
         }
     }
 
@@ -128,6 +128,7 @@ struct Values {
 
     // Core
     bool use_cpu_jit;
+    bool use_multi_core;
     int cpu_clock_percentage;
 
     // Data Storage
@@ -148,6 +149,10 @@ struct Values {
     u16 resolution_factor;
     bool use_frame_limit;
     u16 frame_limit;
+    /// Runs as fast as possible, only presents every turbo_present_interval-th frame and drops
+    /// the audio output. Emulation itself is not affected.
+    bool use_turbo_mode;
+    u16 turbo_present_interval;
     u16 texture_filter_factor;
     std::string texture_filter_name;
 
@@ -204,6 +209,8 @@ struct Values {
 
     // WebService
     bool enable_telemetry;
+    bool enable_perf_reports;
+    std::string perf_report_url;
     std::string web_api_url;
     std::string citra_username;
     std::string citra_token;
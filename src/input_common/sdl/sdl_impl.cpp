@@ -3,6 +3,7 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <array>
 #include <atomic>
 #include <cmath>
 #include <functional>
@@ -19,6 +20,7 @@
 #include "common/logging/log.h"
 #include "common/math_util.h"
 #include "common/param_package.h"
+#include "common/seqlock.h"
 #include "common/threadsafe_queue.h"
 #include "core/frontend/input.h"
 #include "input_common/sdl/sdl_impl.h"
@@ -55,28 +57,37 @@ public:
         : guid{std::move(guid_)}, port{port_}, sdl_joystick{joystick, deleter} {}
 
     void SetButton(int button, bool value) {
-        std::lock_guard lock{mutex};
-        state.buttons[button] = value;
+        if (button < 0 || button >= MaxButtons)
+            return;
+        state.Modify([&](State& new_state) { new_state.buttons[button] = value; });
     }
 
     bool GetButton(int button) const {
-        std::lock_guard lock{mutex};
-        return state.buttons.at(button);
+        if (button < 0 || button >= MaxButtons)
+            return false;
+        return state.Read().buttons[button];
     }
 
     void SetAxis(int axis, Sint16 value) {
-        std::lock_guard lock{mutex};
-        state.axes[axis] = value;
+        if (axis < 0 || axis >= MaxAxes)
+            return;
+        state.Modify([&](State& new_state) { new_state.axes[axis] = value; });
     }
 
     float GetAxis(int axis) const {
-        std::lock_guard lock{mutex};
-        return state.axes.at(axis) / 32767.0f;
+        if (axis < 0 || axis >= MaxAxes)
+            return 0.0f;
+        return state.Read().axes[axis] / 32767.0f;
     }
 
     std::tuple<float, float> GetAnalog(int axis_x, int axis_y) const {
-        float x = GetAxis(axis_x);
-        float y = GetAxis(axis_y);
+        if (axis_x < 0 || axis_x >= MaxAxes || axis_y < 0 || axis_y >= MaxAxes)
+            return std::make_tuple(0.0f, 0.0f);
+
+        // Read both axes from the same snapshot, so they belong to the same stick position
+        const State snapshot = state.Read();
+        float x = snapshot.axes[axis_x] / 32767.0f;
+        float y = snapshot.axes[axis_y] / 32767.0f;
         y = -y; // 3DS uses an y-axis inverse from SDL
 
         // Make sure the coordinates are in the unit circle,
@@ -92,13 +103,15 @@ public:
     }
 
     void SetHat(int hat, Uint8 direction) {
-        std::lock_guard lock{mutex};
-        state.hats[hat] = direction;
+        if (hat < 0 || hat >= MaxHats)
+            return;
+        state.Modify([&](State& new_state) { new_state.hats[hat] = direction; });
     }
 
     bool GetHatDirection(int hat, Uint8 direction) const {
-        std::lock_guard lock{mutex};
-        return (state.hats.at(hat) & direction) != 0;
+        if (hat < 0 || hat >= MaxHats)
+            return false;
+        return (state.Read().hats[hat] & direction) != 0;
     }
     /**
      * The guid of the joystick
@@ -125,15 +138,21 @@ public:
     }
 
 private:
+    static constexpr int MaxButtons = 64;
+    static constexpr int MaxAxes = 16;
+    static constexpr int MaxHats = 8;
+
     struct State {
-        std::unordered_map<int, bool> buttons;
-        std::unordered_map<int, Sint16> axes;
-        std::unordered_map<int, Uint8> hats;
-    } state;
+        std::array<bool, MaxButtons> buttons;
+        std::array<Sint16, MaxAxes> axes;
+        std::array<Uint8, MaxHats> hats;
+    };
+
+    /// Written by the SDL event thread, read by the emulation thread without locking
+    Common::SeqLock<State> state;
     std::string guid;
     int port;
     std::unique_ptr<SDL_Joystick, decltype(&SDL_JoystickClose)> sdl_joystick;
-    mutable std::mutex mutex;
 };
 
 /**
@@ -166,8 +166,6 @@ void Client::OnPadData(Response::PadData data) {
     {
         std::lock_guard guard(status->update_mutex);
 
-        status->motion_status = {accel, gyro};
-
         // TODO: add a setting for "click" touch. Click touch refers to a device that differentiates
         // between a simple "tap" and a hard press that causes the touch screen to click.
         bool is_active = data.touch_1.is_active != 0;
@@ -187,7 +185,7 @@ void Client::OnPadData(Response::PadData data) {
                 static_cast<float>(max_y - min_y);
         }
 
-        status->touch_status = {x, y, is_active};
+        status->inputs.Write({accel, gyro, x, y, is_active});
     }
 }
 
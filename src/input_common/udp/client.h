@@ -12,6 +12,7 @@
 #include <thread>
 #include <tuple>
 #include "common/common_types.h"
+#include "common/seqlock.h"
 #include "common/thread.h"
 #include "common/vector_math.h"
 
@@ -29,9 +30,19 @@ struct Version;
 } // namespace Response
 
 struct DeviceStatus {
+    struct Inputs {
+        Common::Vec3<float> accel;
+        Common::Vec3<float> gyro;
+        float touch_x;
+        float touch_y;
+        bool touch_pressed;
+    };
+
+    /// Written by the client thread, read by the emulation thread without locking
+    Common::SeqLock<Inputs> inputs;
+
+    /// Guards touch_calibration
     std::mutex update_mutex;
-    std::tuple<Common::Vec3<float>, Common::Vec3<float>> motion_status;
-    std::tuple<float, float, bool> touch_status;
 
     // calibration data for scaling the device's touch area to 3ds
     struct CalibrationData {
@@ -16,8 +16,8 @@ class UDPTouchDevice final : public Input::TouchDevice {
 public:
     explicit UDPTouchDevice(std::shared_ptr<DeviceStatus> status_) : status(std::move(status_)) {}
     std::tuple<float, float, bool> GetStatus() const override {
-        std::lock_guard guard(status->update_mutex);
-        return status->touch_status;
+        const auto inputs = status->inputs.Read();
+        return {inputs.touch_x, inputs.touch_y, inputs.touch_pressed};
     }
 
 private:
@@ -28,8 +28,8 @@ class UDPMotionDevice final : public Input::MotionDevice {
 public:
     explicit UDPMotionDevice(std::shared_ptr<DeviceStatus> status_) : status(std::move(status_)) {}
     std::tuple<Common::Vec3<float>, Common::Vec3<float>> GetStatus() const override {
-        std::lock_guard guard(status->update_mutex);
-        return status->motion_status;
+        const auto inputs = status->inputs.Read();
+        return {inputs.accel, inputs.gyro};
     }
 
 private:
@@ -0,0 +1,93 @@
+// Copyright 2020 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <array>
+#include <atomic>
+#include <thread>
+#include <catch2/catch.hpp>
+#include "common/common_types.h"
+#include "common/seqlock.h"
+
+namespace Common {
+
+namespace {
+/// Larger than a word, so that a torn read would mix fields of different writes
+struct Value {
+    std::array<u32, 5> fields{};
+};
+
+Value MakeValue(u32 n) {
+    Value value;
+    value.fields.fill(n);
+    return value;
+}
+} // Anonymous namespace
+
+TEST_CASE("SeqLock: Read returns the written value", "[common]") {
+    SeqLock<Value> lock;
+    REQUIRE(lock.Read().fields == MakeValue(0).fields);
+
+    lock.Write(MakeValue(42));
+    REQUIRE(lock.Read().fields == MakeValue(42).fields);
+
+    lock.Modify([](Value& value) { value.fields[2] = 7; });
+    const Value value = lock.Read();
+    REQUIRE(value.fields[1] == 42);
+    REQUIRE(value.fields[2] == 7);
+}
+
+TEST_CASE("SeqLock: Concurrent reader sees consistent values", "[common]") {
+    constexpr u32 NumWrites = 200000;
+
+    SeqLock<Value> lock;
+    std::atomic<bool> done{false};
+
+    std::thread writer([&] {
+        for (u32 n = 1; n <= NumWrites; ++n) {
+            lock.Write(MakeValue(n));
+        }
+        done = true;
+    });
+
+    bool torn = false;
+    bool went_backwards = false;
+    u32 last = 0;
+    while (!done) {
+        const Value value = lock.Read();
+        for (u32 field : value.fields) {
+            torn |= field != value.fields[0];
+        }
+        went_backwards |= value.fields[0] < last;
+        last = value.fields[0];
+    }
+    writer.join();
+
+    REQUIRE_FALSE(torn);
+    REQUIRE_FALSE(went_backwards);
+    REQUIRE(lock.Read().fields == MakeValue(NumWrites).fields);
+}
+
+TEST_CASE("SeqLock: Concurrent Modify calls are not lost", "[common]") {
+    constexpr u32 NumIncrements = 100000;
+
+    SeqLock<Value> lock;
+    const auto increment = [&lock] {
+        for (u32 i = 0; i < NumIncrements; ++i) {
+            lock.Modify([](Value& value) {
+                for (u32& field : value.fields) {
+                    ++field;
+                }
+            });
+        }
+    };
+
+    std::thread first(increment);
+    std::thread second(increment);
+    first.join();
+    second.join();
+
+    REQUIRE(lock.Read().fields == MakeValue(2 * NumIncrements).fields);
+}
+
+} // namespace Common
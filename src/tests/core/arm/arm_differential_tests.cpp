@@ -0,0 +1,342 @@
+// Copyright 2020 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+// Differential tests between the two CPU backends. Random ARM and Thumb instruction streams are
+// run on both ARM_DynCom and ARM_Dynarmic, then the resulting registers and memory writes are
+// compared. These are hidden from the default run, use `tests [arm_differential]` to fuzz the
+// backends and `tests [arm_benchmark]` to compare their throughput.
+
+#include <array>
+#include <chrono>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include <catch2/catch.hpp>
+#include <fmt/format.h>
+#include "core/arm/dynarmic/arm_dynarmic.h"
+#include "core/arm/dyncom/arm_dyncom.h"
+#include "core/core_timing.h"
+#include "tests/core/arm/arm_test_common.h"
+
+namespace ArmTests {
+
+namespace {
+
+// Every program gets its own code and data pages, so translated code never has to be invalidated
+// and no program sees the stores of an earlier one
+constexpr VAddr CodeBase = 0x00100000;
+constexpr VAddr CodeSpacing = 0x1000;
+constexpr VAddr DataBase = 0x00800000;
+constexpr VAddr DataSpacing = 0x2000;
+
+// NZCVQ, GE and T, the CPSR bits the generated instructions can change
+constexpr u32 CpsrMask = 0xF80F0020;
+
+constexpr u32 ArmSelfBranch = 0xEAFFFFFE; // b +#0
+constexpr u32 ThumbSelfBranch = 0xE7FE;   // b +#0
+
+struct TestProgram {
+    bool thumb;
+    /// Instruction words, or halfwords in Thumb mode. The program ends in a branch to itself.
+    std::vector<u32> code;
+    std::array<u32, 15> regs;
+    u32 cpsr;
+};
+
+struct TestResult {
+    std::array<u32, 16> regs;
+    u32 cpsr;
+    std::vector<WriteRecord> writes;
+};
+
+class InstructionGenerator {
+public:
+    explicit InstructionGenerator(u32 seed) : rng(seed) {}
+
+    u32 Bits(u32 count) {
+        return static_cast<u32>(rng()) & ((1U << count) - 1);
+    }
+
+    /// Any register but SP, LR and PC
+    u32 Reg() {
+        return static_cast<u32>(rng() % 13);
+    }
+
+    /// Any condition but the unconditional instruction space
+    u32 Cond() {
+        return static_cast<u32>(rng() % 15) << 28;
+    }
+
+    u32 ArmDataProcessing() {
+        const u32 opcode = Bits(4);
+        // TST, TEQ, CMP and CMN without the S bit encode other instructions
+        const bool is_compare = opcode >= 0x8 && opcode <= 0xB;
+        const bool is_move = opcode == 0xD || opcode == 0xF;
+        const u32 s = is_compare ? 1 : Bits(1);
+        const u32 rn = is_move ? 0 : Reg();
+        const u32 rd = is_compare ? 0 : Reg();
+        u32 inst = Cond() | opcode << 21 | s << 20 | rn << 16 | rd << 12;
+
+        switch (Bits(2)) {
+        case 0: // Register, shifted by register
+            return inst | Reg() << 8 | Bits(2) << 5 | 1 << 4 | Reg();
+        case 1: // Register, shifted by immediate
+            return inst | Bits(5) << 7 | Bits(2) << 5 | Reg();
+        default: // Rotated immediate
+            return inst | 1 << 25 | Bits(12);
+        }
+    }
+
+    u32 ArmMultiply() {
+        const u32 rm = Reg();
+        const u32 rs = Reg();
+        const u32 s = Bits(1);
+        switch (Bits(2)) {
+        case 0: // MUL
+            return Cond() | s << 20 | Reg() << 16 | rs << 8 | 0x90 | rm;
+        case 1: // MLA
+            return Cond() | 1 << 21 | s << 20 | Reg() << 16 | Reg() << 12 | rs << 8 | 0x90 | rm;
+        default: { // UMULL, UMLAL, SMULL, SMLAL
+            const u32 rd_lo = Reg();
+            u32 rd_hi = Reg();
+            while (rd_hi == rd_lo) {
+                rd_hi = Reg();
+            }
+            return Cond() | 1 << 23 | Bits(2) << 21 | s << 20 | rd_hi << 16 | rd_lo << 12 |
+                   rs << 8 | 0x90 | rm;
+        }
+        }
+    }
+
+    u32 ArmMisc() {
+        switch (Bits(2)) {
+        case 0: // CLZ
+            return Cond() | 0x016F0F10 | Reg() << 12 | Reg();
+        case 1: // REV
+            return Cond() | 0x06BF0F30 | Reg() << 12 | Reg();
+        case 2: // UXTB
+            return Cond() | 0x06EF0070 | Reg() << 12 | Bits(2) << 10 | Reg();
+        default: // SXTH
+            return Cond() | 0x06BF0070 | Reg() << 12 | Bits(2) << 10 | Reg();
+        }
+    }
+
+    /// LDR, STR, LDRB or STRB relative to SP, which points into the program's data pages
+    u32 ArmLoadStore() {
+        const u32 byte = Bits(1);
+        const u32 offset = byte ? Bits(12) : Bits(12) & ~3U;
+        return Cond() | 0x05000000 | Bits(1) << 23 | byte << 22 | Bits(1) << 20 | 13 << 16 |
+               Reg() << 12 | offset;
+    }
+
+    u32 ArmInstruction() {
+        switch (rng() % 8) {
+        case 0:
+            return ArmMultiply();
+        case 1:
+            return ArmMisc();
+        case 2:
+            return ArmLoadStore();
+        default:
+            return ArmDataProcessing();
+        }
+    }
+
+    u32 ThumbInstruction() {
+        const u32 rd = Bits(3);
+        const u32 rs = Bits(3);
+        switch (Bits(2)) {
+        case 0: // LSL, LSR, ASR by immediate
+            return static_cast<u32>(rng() % 3) << 11 | Bits(5) << 6 | rs << 3 | rd;
+        case 1: // ADD, SUB with register or 3 bit immediate
+            return 0x1800 | Bits(2) << 9 | Bits(3) << 6 | rs << 3 | rd;
+        case 2: // MOV, CMP, ADD, SUB with 8 bit immediate
+            return 0x2000 | Bits(2) << 11 | rd << 8 | Bits(8);
+        default: // ALU operations
+            return 0x4000 | Bits(4) << 6 | rs << 3 | rd;
+        }
+    }
+
+    TestProgram Program(bool thumb, std::size_t length) {
+        TestProgram program;
+        program.thumb = thumb;
+        for (std::size_t i = 0; i < length; ++i) {
+            program.code.push_back(thumb ? ThumbInstruction() : ArmInstruction());
+        }
+        program.code.push_back(thumb ? ThumbSelfBranch : ArmSelfBranch);
+
+        for (auto& reg : program.regs) {
+            reg = static_cast<u32>(rng());
+        }
+        program.cpsr = USER32MODE | Bits(4) << 28 | (thumb ? 1 << 5 : 0);
+        return program;
+    }
+
+private:
+    std::mt19937 rng;
+};
+
+VAddr CodeAddress(std::size_t index) {
+    return CodeBase + static_cast<VAddr>(index) * CodeSpacing;
+}
+
+VAddr StackPointer(std::size_t index) {
+    return DataBase + static_cast<VAddr>(index) * DataSpacing + DataSpacing / 2;
+}
+
+void WriteProgram(TestEnvironment& test_env, const TestProgram& program, VAddr address) {
+    for (u32 inst : program.code) {
+        if (program.thumb) {
+            test_env.SetMemory16(address, static_cast<u16>(inst));
+            address += 2;
+        } else {
+            test_env.SetMemory32(address, inst);
+            address += 4;
+        }
+    }
+}
+
+void LoadProgram(ARM_Interface& cpu, const TestProgram& program, std::size_t index) {
+    for (std::size_t reg = 0; reg < program.regs.size(); ++reg) {
+        cpu.SetReg(static_cast<int>(reg), program.regs[reg]);
+    }
+    cpu.SetReg(13, StackPointer(index));
+    cpu.SetCPSR(program.cpsr);
+    cpu.SetPC(CodeAddress(index));
+}
+
+template <typename Backend>
+std::vector<TestResult> RunPrograms(const std::vector<TestProgram>& programs) {
+    TestEnvironment test_env(true);
+    auto timer = std::make_shared<Core::Timing::Timer>(1.0);
+    Backend cpu(nullptr, test_env.GetMemory(), USER32MODE, 0, timer);
+    cpu.ClearInstructionCache();
+
+    std::vector<TestResult> results;
+    results.reserve(programs.size());
+    for (std::size_t i = 0; i < programs.size(); ++i) {
+        const TestProgram& program = programs[i];
+        WriteProgram(test_env, program, CodeAddress(i));
+        LoadProgram(cpu, program, i);
+        test_env.ClearWriteRecords();
+
+        // Both backends end up spinning on the final self branch once the program is done
+        timer->Advance(static_cast<s64>(program.code.size()) + 1);
+        cpu.Run();
+
+        TestResult result;
+        for (std::size_t reg = 0; reg < result.regs.size(); ++reg) {
+            result.regs[reg] = cpu.GetReg(static_cast<int>(reg));
+        }
+        result.cpsr = cpu.GetCPSR() & CpsrMask;
+        result.writes = test_env.GetWriteRecords();
+        results.push_back(std::move(result));
+    }
+    return results;
+}
+
+std::string DescribeProgram(const TestProgram& program) {
+    std::string description =
+        fmt::format("{} program, cpsr={:08x}\n", program.thumb ? "Thumb" : "ARM", program.cpsr);
+    for (std::size_t reg = 0; reg < program.regs.size(); ++reg) {
+        description += fmt::format("  r{}={:08x}\n", reg, program.regs[reg]);
+    }
+    for (u32 inst : program.code) {
+        description += program.thumb ? fmt::format("  {:04x}\n", inst)
+                                     : fmt::format("  {:08x}\n", inst);
+    }
+    return description;
+}
+
+std::string DescribeResults(const TestResult& dyncom, const TestResult& dynarmic) {
+    std::string description;
+    for (std::size_t reg = 0; reg < dyncom.regs.size(); ++reg) {
+        description += fmt::format("r{}: {:08x} (dynarmic {:08x})\n", reg, dyncom.regs[reg],
+                                   dynarmic.regs[reg]);
+    }
+    description += fmt::format("cpsr: {:08x} (dynarmic {:08x})\n", dyncom.cpsr, dynarmic.cpsr);
+    description +=
+        fmt::format("writes: {} (dynarmic {})", dyncom.writes.size(), dynarmic.writes.size());
+    return description;
+}
+
+void CompareBackends(bool thumb) {
+    // The seeds are fixed, so failures reproduce
+    constexpr std::size_t NumPrograms = 500;
+    constexpr std::size_t ProgramLength = 24;
+
+    InstructionGenerator generator(thumb ? 0x7475 : 0x41524D);
+    std::vector<TestProgram> programs;
+    for (std::size_t i = 0; i < NumPrograms; ++i) {
+        programs.push_back(generator.Program(thumb, ProgramLength));
+    }
+
+    const auto dyncom_results = RunPrograms<ARM_DynCom>(programs);
+    const auto dynarmic_results = RunPrograms<ARM_Dynarmic>(programs);
+
+    for (std::size_t i = 0; i < NumPrograms; ++i) {
+        const TestResult& dyncom = dyncom_results[i];
+        const TestResult& dynarmic = dynarmic_results[i];
+        if (dyncom.regs != dynarmic.regs || dyncom.cpsr != dynarmic.cpsr ||
+            dyncom.writes != dynarmic.writes) {
+            INFO(DescribeProgram(programs[i]));
+            INFO(DescribeResults(dyncom, dynarmic));
+            FAIL("Backends disagree on program " << i);
+        }
+    }
+}
+
+/// Runs a loop of random ALU instructions and returns the number of instructions per second
+template <typename Backend>
+double MeasureThroughput(const TestProgram& program, s64 num_instructions) {
+    TestEnvironment test_env(false);
+    auto timer = std::make_shared<Core::Timing::Timer>(1.0);
+    Backend cpu(nullptr, test_env.GetMemory(), USER32MODE, 0, timer);
+    cpu.ClearInstructionCache();
+
+    WriteProgram(test_env, program, CodeAddress(0));
+    LoadProgram(cpu, program, 0);
+
+    timer->Advance(num_instructions);
+    const auto start = std::chrono::steady_clock::now();
+    cpu.Run();
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    const s64 executed = num_instructions - timer->GetDowncount();
+    return static_cast<double>(executed) / elapsed.count();
+}
+
+} // Anonymous namespace
+
+TEST_CASE("ARM backends agree on random ARM code", "[arm_differential][.]") {
+    CompareBackends(false);
+}
+
+TEST_CASE("ARM backends agree on random Thumb code", "[arm_differential][.]") {
+    CompareBackends(true);
+}
+
+TEST_CASE("ARM backend throughput", "[arm_benchmark][.]") {
+    constexpr std::size_t LoopLength = 63;
+    constexpr s64 NumInstructions = 50000000;
+
+    InstructionGenerator generator(0x42454E43);
+    TestProgram program;
+    program.thumb = false;
+    for (std::size_t i = 0; i < LoopLength; ++i) {
+        program.code.push_back(generator.ArmDataProcessing());
+    }
+    // Branch back to the start of the loop
+    program.code.push_back(0xEA000000 | ((0U - static_cast<u32>(LoopLength + 2)) & 0xFFFFFF));
+    program.regs.fill(0x12345678);
+    program.cpsr = USER32MODE;
+
+    const double dyncom = MeasureThroughput<ARM_DynCom>(program, NumInstructions);
+    const double dynarmic = MeasureThroughput<ARM_Dynarmic>(program, NumInstructions);
+    WARN(fmt::format("ARM_DynCom: {:.1f} MIPS, ARM_Dynarmic: {:.1f} MIPS", dyncom / 1e6,
+                     dynarmic / 1e6));
+}
+
+} // namespace ArmTests
@@ -0,0 +1,169 @@
+// Copyright 2020 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <array>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <catch2/catch.hpp>
+#include <httplib.h>
+#include "core/hle/service/http_c.h"
+
+namespace Service::HTTP {
+
+namespace {
+
+constexpr std::size_t BodySize = 256 * 1024;
+
+/// Serves requests on the loopback interface in place of a remote host
+class LocalServer {
+public:
+    /// @param on_abort Called while the request to the /abort route is being handled
+    explicit LocalServer(std::function<void()> on_abort = {}) {
+        // The default pool has no threads at all on single core hosts
+        server.new_task_queue = [] { return new httplib::ThreadPool(2); };
+        // Contexts send the absolute URL as the request target
+        server.Get(".*/data", [](const httplib::Request&, httplib::Response& response) {
+            response.set_content(std::string(BodySize, 'x'), "application/octet-stream");
+        });
+        server.Get(".*/slow", [](const httplib::Request&, httplib::Response& response) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(200));
+            response.set_content(std::string(BodySize, 'x'), "application/octet-stream");
+        });
+        server.Get(".*/abort", [on_abort](const httplib::Request&, httplib::Response& response) {
+            if (on_abort) {
+                on_abort();
+            }
+            response.set_content(std::string(BodySize, 'x'), "application/octet-stream");
+        });
+        port = server.bind_to_any_port("127.0.0.1");
+        REQUIRE(port > 0);
+        thread = std::thread([this] { server.listen_after_bind(); });
+
+        // stop() does nothing until the server is running
+        while (!server.is_running()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    ~LocalServer() {
+        server.stop();
+        thread.join();
+    }
+
+    std::string Url(const std::string& path, const std::string& host = "127.0.0.1") const {
+        return "http://" + host + ":" + std::to_string(port) + path;
+    }
+
+private:
+    httplib::Server server;
+    std::thread thread;
+    int port;
+};
+
+void InitContext(Context& context, std::string url) {
+    context.url = std::move(url);
+    context.method = RequestMethod::Get;
+    context.current_download_size_bytes = 0;
+    context.total_download_size_bytes = 0;
+}
+
+} // Anonymous namespace
+
+TEST_CASE("RequestExecutor: Requests to a local server complete", "[core][service]") {
+    LocalServer server;
+    RequestExecutor executor(2);
+
+    std::array<Context, 4> contexts;
+    std::array<std::future<void>, 4> futures;
+    for (std::size_t i = 0; i < contexts.size(); ++i) {
+        InitContext(contexts[i], server.Url("/data"));
+        futures[i] = executor.Submit(contexts[i]);
+    }
+    for (auto& future : futures) {
+        future.wait();
+    }
+
+    for (auto& context : contexts) {
+        REQUIRE(context.state == RequestState::ReadyToDownloadContent);
+        REQUIRE(context.response.status == 200);
+        REQUIRE(context.response_body.size() == BodySize);
+    }
+
+    const auto stats = executor.GetStats();
+    REQUIRE(stats.completed_requests == contexts.size());
+    REQUIRE(stats.failed_requests == 0);
+    REQUIRE(stats.received_bytes == contexts.size() * BodySize);
+    REQUIRE(stats.max_latency <= stats.total_latency);
+}
+
+TEST_CASE("RequestExecutor: Failed requests are counted", "[core][service]") {
+    std::string url;
+    {
+        // Take a port that nothing listens on anymore
+        LocalServer server;
+        url = server.Url("/data");
+    }
+    RequestExecutor executor(1);
+
+    Context context;
+    InitContext(context, url);
+    executor.Submit(context).wait();
+
+    REQUIRE(context.state == RequestState::TimedOut);
+    const auto stats = executor.GetStats();
+    REQUIRE(stats.completed_requests == 0);
+    REQUIRE(stats.failed_requests == 1);
+    REQUIRE(stats.received_bytes == 0);
+}
+
+TEST_CASE("RequestExecutor: Cancelled requests are not sent", "[core][service]") {
+    LocalServer server;
+    RequestExecutor executor(1);
+
+    Context context;
+    InitContext(context, server.Url("/data"));
+    context.cancel_requested = true;
+    executor.Submit(context).wait();
+
+    REQUIRE(context.state == RequestState::TimedOut);
+    REQUIRE(context.response_body.empty());
+    REQUIRE(executor.GetStats().failed_requests == 1);
+}
+
+TEST_CASE("RequestExecutor: A failed request doesn't fail the rest of its batch",
+          "[core][service]") {
+    std::array<Context, 4> contexts;
+    // The request is cancelled while it is sent, as if its context was closed
+    LocalServer server([&contexts] { contexts[1].cancel_requested = true; });
+    RequestExecutor executor(1);
+
+    // Keeps the only thread busy on another host, so that the other requests are sent as a batch
+    InitContext(contexts[0], server.Url("/slow", "localhost"));
+    InitContext(contexts[1], server.Url("/abort"));
+    InitContext(contexts[2], server.Url("/data"));
+    InitContext(contexts[3], server.Url("/data"));
+    std::array<std::future<void>, 4> futures;
+    for (std::size_t i = 0; i < contexts.size(); ++i) {
+        futures[i] = executor.Submit(contexts[i]);
+    }
+    for (auto& future : futures) {
+        future.wait();
+    }
+
+    REQUIRE(contexts[0].state == RequestState::ReadyToDownloadContent);
+    REQUIRE(contexts[1].state == RequestState::TimedOut);
+    for (std::size_t i = 2; i < contexts.size(); ++i) {
+        REQUIRE(contexts[i].state == RequestState::ReadyToDownloadContent);
+        REQUIRE(contexts[i].response_body.size() == BodySize);
+    }
+
+    const auto stats = executor.GetStats();
+    REQUIRE(stats.completed_requests == 3);
+    REQUIRE(stats.failed_requests == 1);
+}
+
+} // namespace Service::HTTP
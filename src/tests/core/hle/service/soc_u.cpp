@@ -0,0 +1,162 @@
+// Copyright 2020 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <cstring>
+#include <vector>
+#include <catch2/catch.hpp>
+#include "common/common_types.h"
+#include "core/hle/service/soc_u.h"
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace Service::SOC {
+
+namespace {
+
+#ifdef _WIN32
+void CloseSocket(u32 socket_fd) {
+    closesocket(socket_fd);
+}
+#else
+void CloseSocket(u32 socket_fd) {
+    close(socket_fd);
+}
+#endif
+
+void SetNonBlocking(u32 socket_fd) {
+#ifdef _WIN32
+    unsigned long nonblocking = 1;
+    ioctlsocket(socket_fd, FIONBIO, &nonblocking);
+#else
+    fcntl(socket_fd, F_SETFL, fcntl(socket_fd, F_GETFL, 0) | O_NONBLOCK);
+#endif
+}
+
+/// A connected pair of nonblocking TCP sockets on the loopback interface
+struct LoopbackPair {
+    LoopbackPair() {
+#ifdef _WIN32
+        WSADATA data;
+        WSAStartup(MAKEWORD(2, 2), &data);
+#endif
+        const u32 listener = static_cast<u32>(socket(AF_INET, SOCK_STREAM, 0));
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = 0;
+        REQUIRE(bind(listener, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0);
+        REQUIRE(listen(listener, 1) == 0);
+        socklen_t addr_len = sizeof(addr);
+        REQUIRE(getsockname(listener, reinterpret_cast<sockaddr*>(&addr), &addr_len) == 0);
+
+        sender = static_cast<u32>(socket(AF_INET, SOCK_STREAM, 0));
+        // Keep the send buffer small so that large sends can only complete in several parts
+        int buffer_size = 4096;
+        setsockopt(sender, SOL_SOCKET, SO_SNDBUF, reinterpret_cast<const char*>(&buffer_size),
+                   sizeof(buffer_size));
+        REQUIRE(connect(sender, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0);
+        receiver = static_cast<u32>(accept(listener, nullptr, nullptr));
+        CloseSocket(listener);
+
+        // Host sockets never block, like the ones SOC_U creates
+        SetNonBlocking(sender);
+        SetNonBlocking(receiver);
+    }
+
+    ~LoopbackPair() {
+        CloseSocket(sender);
+        CloseSocket(receiver);
+#ifdef _WIN32
+        WSACleanup();
+#endif
+    }
+
+    /// Reads everything that is currently available on the receiving end
+    void Drain(std::vector<u8>& received) const {
+        std::vector<u8> buffer(0x10000);
+        s32 ret;
+        while ((ret = recv(receiver, reinterpret_cast<char*>(buffer.data()),
+                           static_cast<int>(buffer.size()), 0)) > 0) {
+            received.insert(received.end(), buffer.begin(), buffer.begin() + ret);
+        }
+    }
+
+    u32 sender;
+    u32 receiver;
+};
+
+std::vector<u8> MakeData(std::size_t size) {
+    std::vector<u8> data(size);
+    for (std::size_t i = 0; i < size; ++i)
+        data[i] = static_cast<u8>(i * 7 + i / 251);
+    return data;
+}
+
+} // Anonymous namespace
+
+TEST_CASE("SOC_U: Blocking send continues until all data was sent", "[core][service]") {
+    LoopbackPair pair;
+    const std::vector<u8> data = MakeData(8 * 1024 * 1024);
+    SocketSend send{pair.sender, data, 0, {}};
+
+    std::vector<u8> received;
+    u32 attempts = 1;
+    while (!send.Continue(true)) {
+        // The socket would have blocked, the guest thread is still asleep at this point
+        REQUIRE(send.sent < data.size());
+        pair.Drain(received);
+        ++attempts;
+    }
+    REQUIRE(attempts > 1);
+    REQUIRE(send.Result() == static_cast<s32>(data.size()));
+
+    while (received.size() < data.size())
+        pair.Drain(received);
+    REQUIRE(received == data);
+}
+
+TEST_CASE("SOC_U: Nonblocking send reports a short count", "[core][service]") {
+    LoopbackPair pair;
+    const std::vector<u8> data = MakeData(8 * 1024 * 1024);
+    SocketSend send{pair.sender, data, 0, {}};
+
+    REQUIRE(send.Continue(false));
+    REQUIRE(send.Result() > 0);
+    REQUIRE(send.Result() < static_cast<s32>(data.size()));
+}
+
+TEST_CASE("SOC_U: Blocking receive waits for data", "[core][service]") {
+    LoopbackPair pair;
+    SocketReceive receive{pair.receiver, 16, 0, false};
+
+    REQUIRE_FALSE(receive.Continue(true));
+
+    const char message[] = "loopback";
+    REQUIRE(send(pair.sender, message, sizeof(message), 0) == sizeof(message));
+    while (!receive.Continue(true)) {
+    }
+    REQUIRE(receive.result == static_cast<s32>(sizeof(message)));
+    REQUIRE(receive.data.size() == sizeof(message));
+    REQUIRE(std::memcmp(receive.data.data(), message, sizeof(message)) == 0);
+    REQUIRE(receive.src_addr.empty());
+}
+
+TEST_CASE("SOC_U: Nonblocking receive reports that it would block", "[core][service]") {
+    LoopbackPair pair;
+    SocketReceive receive{pair.receiver, 16, 0, true};
+
+    REQUIRE(receive.Continue(false));
+    REQUIRE(receive.result < 0);
+    REQUIRE(receive.data.empty());
+}
+
+} // namespace Service::SOC
@@ -2,6 +2,7 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <cstring>
 #include <catch2/catch.hpp>
 #include "core/core.h"
 #include "core/core_timing.h"
@@ -54,3 +55,42 @@ TEST_CASE("Memory::IsValidVirtualAddress", "[core][memory]") {
         CHECK(Memory::IsValidVirtualAddress(*process, Memory::CONFIG_MEMORY_VADDR) == false);
     }
 }
+
+TEST_CASE("Memory::SetRegionWatched", "[core][memory]") {
+    Core::Timing timing(1, 100);
+    Memory::MemorySystem memory;
+    Kernel::KernelSystem kernel(memory, timing, [] {}, 0, 1, 0);
+    auto process = kernel.CreateProcess(kernel.CreateCodeSet("", 0));
+    kernel.MapSharedPages(process->vm_manager);
+    auto& page_table = process->vm_manager.page_table;
+    const std::size_t page_index = Memory::SHARED_PAGE_VADDR >> Memory::PAGE_BITS;
+    u8* const page_pointer = page_table.pointers[page_index];
+    REQUIRE(page_pointer != nullptr);
+
+    SECTION("watched pages lose their pointer but stay accessible") {
+        memory.SetRegionWatched(*process, Memory::SHARED_PAGE_VADDR + 4, 4, true);
+        CHECK(page_table.pointers[page_index] == nullptr);
+        CHECK(Memory::IsValidVirtualAddress(*process, Memory::SHARED_PAGE_VADDR));
+
+        const u32 value = 0x12345678;
+        memory.WriteBlock(*process, Memory::SHARED_PAGE_VADDR + 4, &value, sizeof(value));
+        u32 read_value = 0;
+        memory.ReadBlock(*process, Memory::SHARED_PAGE_VADDR + 4, &read_value, sizeof(read_value));
+        CHECK(read_value == value);
+        CHECK(std::memcmp(page_pointer + 4, &value, sizeof(value)) == 0);
+    }
+
+    SECTION("unwatching a page restores its pointer") {
+        memory.SetRegionWatched(*process, Memory::SHARED_PAGE_VADDR, 4, true);
+        memory.SetRegionWatched(*process, Memory::SHARED_PAGE_VADDR, 4, false);
+        CHECK(page_table.pointers[page_index] == page_pointer);
+        CHECK(page_table.watched_pointers.empty());
+    }
+
+    SECTION("remapping a page drops its watch") {
+        memory.SetRegionWatched(*process, Memory::SHARED_PAGE_VADDR, 4, true);
+        process->vm_manager.UnmapRange(Memory::SHARED_PAGE_VADDR, Memory::SHARED_PAGE_SIZE);
+        CHECK(page_table.watched_pointers.empty());
+        CHECK(Memory::IsValidVirtualAddress(*process, Memory::SHARED_PAGE_VADDR) == false);
+    }
+}
@@ -0,0 +1,106 @@
+// Copyright 2020 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <string>
+#include <catch2/catch.hpp>
+#include "common/common_types.h"
+#include "common/file_util.h"
+#include "core/hle/service/hid/hid.h"
+#include "core/movie.h"
+
+namespace Core {
+
+namespace {
+
+/// Spans three chunks of input records
+constexpr s16 NumRecords = 20000;
+
+/// Offset of the input format in the movie header
+constexpr u64 InputFormatOffset = 40;
+
+/// Records a movie in which the circle pad x position of every record is its index
+void RecordMovie(const std::string& path, s16 num_records) {
+    auto& movie = Movie::GetInstance();
+    movie.PrepareForRecording();
+    movie.StartRecording(path);
+    REQUIRE(movie.IsRecordingInput());
+    for (s16 i = 0; i < num_records; ++i) {
+        Service::HID::PadState pad_state{};
+        s16 circle_pad_x = i;
+        s16 circle_pad_y = -i;
+        movie.HandlePadAndCircleStatus(pad_state, circle_pad_x, circle_pad_y);
+    }
+    movie.Shutdown();
+}
+
+/// Plays back the next record and returns its index
+s16 PlayRecord() {
+    Service::HID::PadState pad_state{};
+    s16 circle_pad_x = -1;
+    s16 circle_pad_y = 0;
+    Movie::GetInstance().HandlePadAndCircleStatus(pad_state, circle_pad_x, circle_pad_y);
+    return circle_pad_x;
+}
+
+void PatchMovie(const std::string& path, u64 offset, u8 value) {
+    FileUtil::IOFile file(path, "r+b");
+    file.Seek(offset, SEEK_SET);
+    file.WriteBytes(&value, sizeof(value));
+}
+
+} // Anonymous namespace
+
+TEST_CASE("Movie: SeekToRecord moves playback between chunks", "[core]") {
+    const std::string path = "movie_seek_test.ctm";
+    RecordMovie(path, NumRecords);
+
+    auto& movie = Movie::GetInstance();
+    movie.StartPlayback(path);
+    REQUIRE(movie.IsPlayingInput());
+    REQUIRE(PlayRecord() == 0);
+
+    REQUIRE(movie.SeekToRecord(17000));
+    REQUIRE(PlayRecord() == 17000);
+    REQUIRE(movie.SeekToRecord(5));
+    REQUIRE(PlayRecord() == 5);
+
+    // Playback continues into the next chunk after a seek
+    REQUIRE(movie.SeekToRecord(8191));
+    REQUIRE(PlayRecord() == 8191);
+    REQUIRE(PlayRecord() == 8192);
+
+    // Seeking past the end fails and leaves playback where it was
+    REQUIRE_FALSE(movie.SeekToRecord(NumRecords));
+    REQUIRE(PlayRecord() == 8193);
+
+    REQUIRE(movie.SeekToRecord(NumRecords - 1));
+    REQUIRE(PlayRecord() == NumRecords - 1);
+    REQUIRE_FALSE(movie.IsPlayingInput());
+    REQUIRE_FALSE(movie.SeekToRecord(0));
+
+    movie.Shutdown();
+    FileUtil::Delete(path);
+}
+
+TEST_CASE("Movie: Unknown input formats are rejected", "[core]") {
+    const std::string path = "movie_format_test.ctm";
+    RecordMovie(path, 100);
+
+    auto& movie = Movie::GetInstance();
+    SECTION("unknown input format") {
+        PatchMovie(path, InputFormatOffset, 2);
+    }
+    SECTION("chunked input with the magic of raw movies") {
+        PatchMovie(path, 3, 0x1B);
+    }
+
+    REQUIRE(movie.ValidateMovie(path) == Movie::ValidationResult::Invalid);
+    movie.StartPlayback(path);
+    REQUIRE_FALSE(movie.IsPlayingInput());
+
+    movie.Shutdown();
+    FileUtil::Delete(path);
+}
+
+} // namespace Core
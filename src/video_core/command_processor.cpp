@@ -123,8 +123,12 @@ static void WritePicaReg(u32 id, u32 value, u32 mask) {
     u32 old_value = regs.reg_array[id];
 
     const u32 write_mask = expand_bits_to_bytes[mask];
+    const u32 new_value = (old_value & ~write_mask) | (value & write_mask);
 
-    regs.reg_array[id] = (old_value & ~write_mask) | (value & write_mask);
+    // Let the rasterizer submit any queued draws that were recorded with the old value
+    VideoCore::g_renderer->Rasterizer()->NotifyPicaRegisterWrite(id, new_value);
+
+    regs.reg_array[id] = new_value;
 
     // Double check for is_pica_tracing to avoid call overhead
     if (DebugUtils::IsPicaTracing()) {
@@ -660,6 +664,8 @@ void ProcessCommandList(const u32* list, u32 size) {
             WritePicaReg(cmd, *g_state.cmd_list.current_ptr++, header.parameter_mask);
         }
     }
+
+    VideoCore::g_renderer->Rasterizer()->NotifyCommandListEnd();
 }
 
 } // namespace Pica::CommandProcessor
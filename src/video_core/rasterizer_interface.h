@@ -27,6 +27,13 @@ enum class LoadCallbackStage {
 };
 using DiskResourceLoadCallback = std::function<void(LoadCallbackStage, std::size_t, std::size_t)>;
 
+/// GPU time spent in the host draw calls, measured while draw timing is enabled
+struct DrawTimeStats {
+    u64 draw_count = 0;
+    u64 total_ns = 0;
+    u64 max_ns = 0;
+};
+
 class RasterizerInterface {
 public:
     virtual ~RasterizerInterface() {}
@@ -39,9 +46,15 @@ public:
     /// Draw the current batch of triangles
     virtual void DrawTriangles() = 0;
 
+    /// Notify rasterizer that the specified PICA register is about to be written with value
+    virtual void NotifyPicaRegisterWrite(u32 id, u32 value) {}
+
     /// Notify rasterizer that the specified PICA register has been changed
     virtual void NotifyPicaRegisterChanged(u32 id) = 0;
 
+    /// Notify rasterizer that a command list has been processed completely
+    virtual void NotifyCommandListEnd() {}
+
     /// Notify rasterizer that all caches should be flushed to 3DS memory
     virtual void FlushAll() = 0;
 
@@ -84,5 +97,15 @@ public:
 
     virtual void LoadDiskResources(const std::atomic_bool& stop_loading,
                                    const DiskResourceLoadCallback& callback) {}
+
+    /// Measure the GPU time of every host draw call, if supported. Returns whether it is supported
+    virtual bool SetDrawTimingEnabled(bool enabled) {
+        return false;
+    }
+
+    /// Gets the GPU time of the draws since draw timing was enabled, waiting for the pending ones
+    virtual DrawTimeStats GetDrawTimeStats() {
+        return {};
+    }
 };
 } // namespace VideoCore
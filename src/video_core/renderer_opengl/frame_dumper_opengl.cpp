@@ -2,14 +2,62 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <string>
 #include <glad/glad.h>
 #include "core/frontend/emu_window.h"
 #include "core/frontend/scope_acquire_context.h"
 #include "video_core/renderer_opengl/frame_dumper_opengl.h"
+#include "video_core/renderer_opengl/gl_shader_util.h"
+#include "video_core/renderer_opengl/gl_vars.h"
 #include "video_core/renderer_opengl/renderer_opengl.h"
 
 namespace OpenGL {
 
+static const char conversion_vertex_shader[] = R"(
+void main() {
+    // Single triangle covering the whole viewport
+    vec2 position = vec2(float((gl_VertexID & 1) << 2), float((gl_VertexID & 2) << 1)) - 1.0;
+    gl_Position = vec4(position, 0.0, 1.0);
+}
+)";
+
+// Converts the frame to planar YUV420 (BT.601, limited range, matching swscale's defaults). The
+// target is a single channel texture frame_size.y * 3 / 2 rows high: the luma plane on top, then
+// the U and V planes back to back, with every target row holding two rows of a chroma plane. This
+// way the readback has exactly the memory layout FFmpeg expects.
+static const char conversion_fragment_shader[] = R"(
+#ifdef CITRA_GLES
+precision highp int;
+#endif
+
+layout(location = 0) out float color;
+
+uniform sampler2D source;
+uniform ivec2 frame_size;
+
+const vec3 luma = vec3(0.256788, 0.504129, 0.097906);
+const vec3 chroma_u = vec3(-0.148224, -0.290992, 0.439216);
+const vec3 chroma_v = vec3(0.439216, -0.367788, -0.071427);
+
+void main() {
+    ivec2 coord = ivec2(gl_FragCoord.xy);
+    if (coord.y < frame_size.y) {
+        color = dot(texelFetch(source, coord, 0).rgb, luma) + 16.0 / 255.0;
+        return;
+    }
+
+    int chroma_width = frame_size.x / 2;
+    int chroma_size = chroma_width * (frame_size.y / 2);
+    int index = (coord.y - frame_size.y) * frame_size.x + coord.x;
+    int plane_index = index % chroma_size;
+    ivec2 chroma_coord = ivec2(plane_index % chroma_width, plane_index / chroma_width);
+
+    // Sampling at the center of the 2x2 block averages the four pixels it covers
+    vec3 rgb = texture(source, (vec2(chroma_coord) * 2.0 + 1.0) / vec2(frame_size)).rgb;
+    color = dot(rgb, index < chroma_size ? chroma_u : chroma_v) + 128.0 / 255.0;
+}
+)";
+
 FrameDumperOpenGL::FrameDumperOpenGL(VideoDumper::Backend& video_dumper_,
                                      Frontend::EmuWindow& emu_window)
     : video_dumper(video_dumper_), context(emu_window.CreateSharedContext()) {}
@@ -36,13 +84,19 @@ void FrameDumperOpenGL::StartDumping() {
 
 void FrameDumperOpenGL::StopDumping() {
     stop_requested.store(true, std::memory_order_relaxed);
+
+    // Wait for the frames still in flight to reach the backend before it is flushed
+    if (present_thread.joinable())
+        present_thread.join();
 }
 
 void FrameDumperOpenGL::PresentLoop() {
     Frontend::ScopeAcquireContext scope{*context};
+
+    layout = GetLayout();
+    pixel_format = video_dumper.GetPixelFormat();
     InitializeOpenGLObjects();
 
-    const auto& layout = GetLayout();
     while (!stop_requested.exchange(false)) {
         auto frame = mailbox->TryGetPresentFrame(200);
         if (!frame) {
@@ -53,46 +107,162 @@ void FrameDumperOpenGL::PresentLoop() {
             LOG_DEBUG(Render_OpenGL, "Reloading present frame");
             mailbox->ReloadPresentFrame(frame, layout.width, layout.height);
         }
-        glWaitSync(frame->render_fence, 0, GL_TIMEOUT_IGNORED);
+        ReadFrame(frame);
+    }
+
+    while (pending_readbacks > 0) {
+        FinishReadback(true);
+    }
+
+    CleanupOpenGLObjects();
+}
+
+void FrameDumperOpenGL::ReadFrame(Frontend::Frame* frame) {
+    if (pending_readbacks == NumReadbacks) {
+        FinishReadback(true);
+    }
+    auto& readback = readbacks[(oldest_readback + pending_readbacks) % NumReadbacks];
+
+    glWaitSync(frame->render_fence, 0, GL_TIMEOUT_IGNORED);
 
-        glBindFramebuffer(GL_READ_FRAMEBUFFER, frame->present.handle);
-        glBindBuffer(GL_PIXEL_PACK_BUFFER, pbos[current_pbo].handle);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, frame->present.handle);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.pbo.handle);
+    if (pixel_format == VideoDumper::PixelFormat::YUV420P) {
+        // Copy the frame to a texture that can be sampled, which frees the frame for reuse
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, conversion_source_fbo.handle);
+        glBlitFramebuffer(0, 0, layout.width, layout.height, 0, 0, layout.width, layout.height,
+                          GL_COLOR_BUFFER_BIT, GL_NEAREST);
+
+        // Insert fence for the main thread to block on
+        frame->present_fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, conversion_target_fbo.handle);
+        glViewport(0, 0, layout.width, layout.height * 3 / 2);
+        glUseProgram(conversion_program.handle);
+        glBindVertexArray(conversion_vao.handle);
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D, conversion_source.handle);
+        glDrawArrays(GL_TRIANGLES, 0, 3);
+
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, conversion_target_fbo.handle);
+        glReadPixels(0, 0, layout.width, layout.height * 3 / 2, GL_RED, GL_UNSIGNED_BYTE, 0);
+    } else {
         glReadPixels(0, 0, layout.width, layout.height, GL_BGRA, GL_UNSIGNED_INT_8_8_8_8_REV, 0);
 
         // Insert fence for the main thread to block on
         frame->present_fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
-        glFlush();
-
-        // Bind the previous PBO and read the pixels
-        glBindBuffer(GL_PIXEL_PACK_BUFFER, pbos[next_pbo].handle);
-        GLubyte* pixels = static_cast<GLubyte*>(glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY));
-        VideoDumper::VideoFrame frame_data{layout.width, layout.height, pixels};
-        video_dumper.AddVideoFrame(std::move(frame_data));
-        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
-        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
-
-        current_pbo = (current_pbo + 1) % 2;
-        next_pbo = (current_pbo + 1) % 2;
     }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
 
-    CleanupOpenGLObjects();
+    readback.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    glFlush();
+    pending_readbacks++;
+
+    // Pass on everything the GPU has already finished, without waiting on the rest
+    while (pending_readbacks > 0 && FinishReadback(false)) {
+    }
+}
+
+bool FrameDumperOpenGL::FinishReadback(bool wait) {
+    auto& readback = readbacks[oldest_readback];
+
+    const GLenum result =
+        glClientWaitSync(readback.fence, wait ? GL_SYNC_FLUSH_COMMANDS_BIT : 0,
+                         wait ? GL_TIMEOUT_IGNORED : 0);
+    if (result == GL_TIMEOUT_EXPIRED) {
+        return false;
+    }
+    glDeleteSync(readback.fence);
+    readback.fence = nullptr;
+
+    const std::size_t size =
+        VideoDumper::VideoFrame::GetDataSize(layout.width, layout.height, pixel_format);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.pbo.handle);
+    auto pixels =
+        static_cast<u8*>(glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, size, GL_MAP_READ_BIT));
+    VideoDumper::VideoFrame frame_data{layout.width, layout.height, pixels, pixel_format};
+    glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    oldest_readback = (oldest_readback + 1) % NumReadbacks;
+    pending_readbacks--;
+
+    // This only blocks once the encoder queue is full
+    video_dumper.AddVideoFrame(std::move(frame_data));
+    return true;
 }
 
 void FrameDumperOpenGL::InitializeOpenGLObjects() {
-    const auto& layout = GetLayout();
-    for (auto& buffer : pbos) {
-        buffer.Create();
-        glBindBuffer(GL_PIXEL_PACK_BUFFER, buffer.handle);
-        glBufferData(GL_PIXEL_PACK_BUFFER, layout.width * layout.height * 4, nullptr,
-                     GL_STREAM_READ);
-        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    const std::size_t size =
+        VideoDumper::VideoFrame::GetDataSize(layout.width, layout.height, pixel_format);
+    for (auto& readback : readbacks) {
+        readback.pbo.Create();
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.pbo.handle);
+        glBufferData(GL_PIXEL_PACK_BUFFER, size, nullptr, GL_STREAM_READ);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    oldest_readback = 0;
+    pending_readbacks = 0;
+
+    if (pixel_format != VideoDumper::PixelFormat::YUV420P) {
+        return;
+    }
+
+    const auto create_target = [](OGLTexture& texture, OGLFramebuffer& framebuffer,
+                                  GLint internal_format, GLenum format, GLsizei width,
+                                  GLsizei height) {
+        texture.Create();
+        glBindTexture(GL_TEXTURE_2D, texture.handle);
+        glTexImage2D(GL_TEXTURE_2D, 0, internal_format, width, height, 0, format,
+                     GL_UNSIGNED_BYTE, nullptr);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+        framebuffer.Create();
+        glBindFramebuffer(GL_FRAMEBUFFER, framebuffer.handle);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture.handle,
+                               0);
+        if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+            LOG_CRITICAL(Render_OpenGL, "Failed to create video dumping conversion FBO!");
+        }
+    };
+    create_target(conversion_source, conversion_source_fbo, GL_RGBA8, GL_RGBA, layout.width,
+                  layout.height);
+    create_target(conversion_target, conversion_target_fbo, GL_R8, GL_RED, layout.width,
+                  layout.height * 3 / 2);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    std::string shader_data;
+    if (GLES) {
+        shader_data += fragment_shader_precision_OES;
     }
+    shader_data += conversion_fragment_shader;
+    conversion_program.Create(conversion_vertex_shader, shader_data.c_str());
+    glUseProgram(conversion_program.handle);
+    glUniform1i(glGetUniformLocation(conversion_program.handle, "source"), 0);
+    glUniform2i(glGetUniformLocation(conversion_program.handle, "frame_size"), layout.width,
+                layout.height);
+
+    // Rows of the single channel target are not necessarily 4 byte aligned
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+
+    conversion_vao.Create();
 }
 
 void FrameDumperOpenGL::CleanupOpenGLObjects() {
-    for (auto& buffer : pbos) {
-        buffer.Release();
+    for (auto& readback : readbacks) {
+        readback.pbo.Release();
     }
+    conversion_program.Release();
+    conversion_vao.Release();
+    conversion_target_fbo.Release();
+    conversion_target.Release();
+    conversion_source_fbo.Release();
+    conversion_source.Release();
 }
 
 } // namespace OpenGL
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <array>
 #include <atomic>
 #include <memory>
 #include <thread>
@@ -39,19 +40,48 @@ public:
     std::unique_ptr<Frontend::TextureMailbox> mailbox;
 
 private:
+    /// A pixel pack buffer and the fence signalled once the readback into it has completed
+    struct Readback {
+        OGLBuffer pbo;
+        GLsync fence{};
+    };
+
+    /// Number of frames that can be in flight between the GPU and the encoder
+    static constexpr std::size_t NumReadbacks = 3;
+
     void InitializeOpenGLObjects();
     void CleanupOpenGLObjects();
     void PresentLoop();
 
+    /// Converts the frame to the backend's pixel format and queues an asynchronous readback
+    void ReadFrame(Frontend::Frame* frame);
+
+    /**
+     * Hands the oldest pending readback to the video dumping backend.
+     * @param wait Whether to block until the GPU is done, otherwise returns false if it is not
+     */
+    bool FinishReadback(bool wait);
+
     VideoDumper::Backend& video_dumper;
     std::unique_ptr<Frontend::GraphicsContext> context;
     std::thread present_thread;
     std::atomic_bool stop_requested{false};
 
-    // PBOs used to dump frames faster
-    std::array<OGLBuffer, 2> pbos;
-    GLuint current_pbo = 1;
-    GLuint next_pbo = 0;
+    Layout::FramebufferLayout layout;
+    VideoDumper::PixelFormat pixel_format = VideoDumper::PixelFormat::BGRA;
+
+    // Ring of PBOs used to download frames without stalling on the GPU
+    std::array<Readback, NumReadbacks> readbacks;
+    std::size_t oldest_readback = 0;
+    std::size_t pending_readbacks = 0;
+
+    // Objects used to convert frames to YUV420P on the GPU before they are read back
+    OGLTexture conversion_source;
+    OGLFramebuffer conversion_source_fbo;
+    OGLTexture conversion_target;
+    OGLFramebuffer conversion_target_fbo;
+    OGLProgram conversion_program;
+    OGLVertexArray conversion_vao;
 };
 
 } // namespace OpenGL
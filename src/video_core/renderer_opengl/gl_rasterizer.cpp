@@ -88,18 +88,7 @@ RasterizerOpenGL::RasterizerOpenGL(Frontend::EmuWindow& window)
     sw_vao.Create();
     hw_vao.Create();
 
-    uniform_block_data.dirty = true;
-
-    uniform_block_data.lighting_lut_dirty.fill(true);
-    uniform_block_data.lighting_lut_dirty_any = true;
-
-    uniform_block_data.fog_lut_dirty = true;
-
-    uniform_block_data.proctex_noise_lut_dirty = true;
-    uniform_block_data.proctex_color_map_dirty = true;
-    uniform_block_data.proctex_alpha_map_dirty = true;
-    uniform_block_data.proctex_lut_dirty = true;
-    uniform_block_data.proctex_diff_lut_dirty = true;
+    uniform_block_data.dirty.set();
 
     glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &uniform_buffer_alignment);
     uniform_size_aligned_vs =
@@ -176,6 +165,74 @@ void RasterizerOpenGL::LoadDiskResources(const std::atomic_bool& stop_loading,
     shader_program_manager->LoadDiskCache(stop_loading, callback);
 }
 
+bool RasterizerOpenGL::SetDrawTimingEnabled(bool enabled) {
+    // Timer queries are only core in desktop OpenGL
+    if (enabled && (GLES || !(GLAD_GL_VERSION_3_3 || GLAD_GL_ARB_timer_query))) {
+        LOG_WARNING(Render_OpenGL, "Draw timing is not supported without GL_ARB_timer_query");
+        return false;
+    }
+    if (enabled && !draw_timing_enabled) {
+        draw_time_stats = {};
+    }
+    draw_timing_enabled = enabled;
+    return true;
+}
+
+VideoCore::DrawTimeStats RasterizerOpenGL::GetDrawTimeStats() {
+    FlushPendingDraw();
+    CollectDrawTimings(true);
+    return draw_time_stats;
+}
+
+void RasterizerOpenGL::BeginDrawTiming() {
+    if (!draw_timing_enabled) {
+        return;
+    }
+    // Reap the finished queries now and then, so that their number stays bounded
+    if (pending_draw_queries.size() >= 256) {
+        CollectDrawTimings(false);
+    }
+
+    OGLQuery query;
+    if (free_draw_queries.empty()) {
+        query.Create();
+    } else {
+        query = std::move(free_draw_queries.back());
+        free_draw_queries.pop_back();
+    }
+    glBeginQuery(GL_TIME_ELAPSED, query.handle);
+    pending_draw_queries.push_back(std::move(query));
+}
+
+void RasterizerOpenGL::EndDrawTiming() {
+    if (draw_timing_enabled) {
+        glEndQuery(GL_TIME_ELAPSED);
+    }
+}
+
+void RasterizerOpenGL::CollectDrawTimings(bool wait) {
+    while (!pending_draw_queries.empty()) {
+        OGLQuery& query = pending_draw_queries.front();
+        // Queries finish in submission order, so the first one still running ends the scan
+        if (!wait) {
+            GLuint available = GL_FALSE;
+            glGetQueryObjectuiv(query.handle, GL_QUERY_RESULT_AVAILABLE, &available);
+            if (available == GL_FALSE) {
+                break;
+            }
+        }
+        GLuint64 elapsed_ns = 0;
+        glGetQueryObjectui64v(query.handle, GL_QUERY_RESULT, &elapsed_ns);
+
+        ++draw_time_stats.draw_count;
+        draw_time_stats.total_ns += elapsed_ns;
+        draw_time_stats.max_ns = std::max<u64>(draw_time_stats.max_ns, elapsed_ns);
+
+        free_draw_queries.push_back(std::move(query));
+        pending_draw_queries.pop_front();
+    }
+}
+
 void RasterizerOpenGL::SyncEntireState() {
     // Sync fixed function OpenGL state
     SyncClipEnabled();
@@ -399,6 +456,8 @@ bool RasterizerOpenGL::SetupGeometryShader() {
 }
 
 bool RasterizerOpenGL::AccelerateDrawBatch(bool is_indexed) {
+    FlushPendingDraw();
+
     const auto& regs = Pica::g_state.regs;
     if (regs.pipeline.use_gs != Pica::PipelineRegs::UseGS::No) {
         if (regs.pipeline.gs_config.mode != Pica::PipelineRegs::GSMode::Point) {
@@ -472,12 +531,16 @@ bool RasterizerOpenGL::AccelerateDrawBatchInternal(bool is_indexed) {
         std::memcpy(buffer_ptr, index_data, index_buffer_size);
         index_buffer.Unmap(index_buffer_size);
 
+        BeginDrawTiming();
         glDrawRangeElementsBaseVertex(
             primitive_mode, vs_input_index_min, vs_input_index_max, regs.pipeline.num_vertices,
             index_u16 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_BYTE,
             reinterpret_cast<const void*>(buffer_offset), -static_cast<GLint>(vs_input_index_min));
+        EndDrawTiming();
     } else {
+        BeginDrawTiming();
         glDrawArrays(primitive_mode, 0, regs.pipeline.num_vertices);
+        EndDrawTiming();
     }
     return true;
 }
@@ -485,6 +548,73 @@ bool RasterizerOpenGL::AccelerateDrawBatchInternal(bool is_indexed) {
 void RasterizerOpenGL::DrawTriangles() {
     if (vertex_batch.empty())
         return;
+
+    // Consecutive draws are merged into a single host draw call for as long as nothing they depend
+    // on changes. NotifyPicaRegisterWrite and the cache management functions submit the batch
+    // before that happens, and NotifyCommandListEnd at the latest.
+    if (CanDeferDraw()) {
+        draw_pending = true;
+        return;
+    }
+
+    draw_pending = false;
+    Draw(false, false);
+}
+
+bool RasterizerOpenGL::CanDeferDraw() const {
+    const auto& regs = Pica::g_state.regs;
+
+    if (vertex_batch.size() * sizeof(HardwareVertex) >= VERTEX_BUFFER_SIZE) {
+        return false;
+    }
+
+    // Shadow rendering relies on the memory barrier issued after every draw
+    if (regs.framebuffer.output_merger.fragment_operation_mode ==
+        Pica::FramebufferRegs::FragmentOperationMode::Shadow) {
+        return false;
+    }
+
+    // Draws sampling from the framebuffer they render to need a texture barrier in between
+    const auto& framebuffer = regs.framebuffer.framebuffer;
+    const PAddr color_start = framebuffer.GetColorBufferPhysicalAddress();
+    const PAddr color_end = color_start + framebuffer.GetWidth() * framebuffer.GetHeight() * 4;
+    const auto pica_textures = regs.texturing.GetTextures();
+    for (unsigned texture_index = 0; texture_index < pica_textures.size(); ++texture_index) {
+        const auto& texture = pica_textures[texture_index];
+        if (!texture.enabled) {
+            continue;
+        }
+
+        // Cube and shadow textures span several surfaces, don't bother tracking them
+        using TextureType = Pica::TexturingRegs::TextureConfig::TextureType;
+        if (texture_index == 0 && texture.config.type != TextureType::Texture2D &&
+            texture.config.type != TextureType::Projection2D) {
+            return false;
+        }
+
+        const PAddr texture_start = texture.config.GetPhysicalAddress();
+        const PAddr texture_end =
+            texture_start + texture.config.width * texture.config.height *
+                                Pica::TexturingRegs::NibblesPerPixel(texture.format) / 2;
+        if (texture_start < color_end && color_start < texture_end) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void RasterizerOpenGL::NotifyCommandListEnd() {
+    // A queued draw hasn't looked up its surfaces yet, so their pages aren't marked as cached and
+    // CPU writes to them wouldn't submit it. The CPU only runs between command lists, so never
+    // keep a draw queued past the end of one.
+    FlushPendingDraw();
+}
+
+void RasterizerOpenGL::FlushPendingDraw() {
+    if (!draw_pending)
+        return;
+    draw_pending = false;
     Draw(false, false);
 }
 
@@ -599,7 +729,7 @@ bool RasterizerOpenGL::Draw(bool accelerate, bool is_indexed) {
 
     if (uniform_block_data.data.framebuffer_scale != res_scale) {
         uniform_block_data.data.framebuffer_scale = res_scale;
-        uniform_block_data.dirty = true;
+        uniform_block_data.dirty.set(FSUniforms);
     }
 
     // Scissor checks are window-, not viewport-relative, which means that if the cached texture
@@ -624,7 +754,7 @@ bool RasterizerOpenGL::Draw(bool accelerate, bool is_indexed) {
         uniform_block_data.data.scissor_x2 = scissor_x2;
         uniform_block_data.data.scissor_y1 = scissor_y1;
         uniform_block_data.data.scissor_y2 = scissor_y2;
-        uniform_block_data.dirty = true;
+        uniform_block_data.dirty.set(FSUniforms);
     }
 
     bool need_texture_barrier = false;
@@ -806,7 +936,9 @@ bool RasterizerOpenGL::Draw(bool accelerate, bool is_indexed) {
                 vertex_buffer.Map(vertex_size, sizeof(HardwareVertex));
             std::memcpy(vbo, vertex_batch.data() + base_vertex, vertex_size);
             vertex_buffer.Unmap(vertex_size);
+            BeginDrawTiming();
             glDrawArrays(GL_TRIANGLES, offset / sizeof(HardwareVertex), (GLsizei)vertices);
+            EndDrawTiming();
         }
     }
 
@@ -856,6 +988,34 @@ bool RasterizerOpenGL::Draw(bool accelerate, bool is_indexed) {
     return succeeded;
 }
 
+static bool IsPicaLUTDataRegister(u32 id) {
+    return (id >= PICA_REG_INDEX(texturing.fog_lut_data[0]) &&
+            id <= PICA_REG_INDEX(texturing.fog_lut_data[7])) ||
+           (id >= PICA_REG_INDEX(texturing.proctex_lut_data[0]) &&
+            id <= PICA_REG_INDEX(texturing.proctex_lut_data[7])) ||
+           (id >= PICA_REG_INDEX(lighting.lut_data[0]) &&
+            id <= PICA_REG_INDEX(lighting.lut_data[7]));
+}
+
+void RasterizerOpenGL::NotifyPicaRegisterWrite(u32 id, u32 value) {
+    if (!draw_pending)
+        return;
+
+    // Queued triangles already went through the software vertex pipeline, so only the
+    // registers preceding the pipeline configuration can affect how they are drawn
+    if (id >= PICA_REG_INDEX(pipeline))
+        return;
+
+    // Writing the same value again keeps the effective state, except for the LUT data ports. The
+    // registers before the rasterizer configuration (e.g. trigger_irq) always submit the batch,
+    // as the guest expects its rendering to be finished once the interrupt fires.
+    if (id >= PICA_REG_INDEX(rasterizer) && Pica::g_state.regs.reg_array[id] == value &&
+        !IsPicaLUTDataRegister(id))
+        return;
+
+    FlushPendingDraw();
+}
+
 void RasterizerOpenGL::NotifyPicaRegisterChanged(u32 id) {
     const auto& regs = Pica::g_state.regs;
 
@@ -918,7 +1078,7 @@ void RasterizerOpenGL::NotifyPicaRegisterChanged(u32 id) {
     case PICA_REG_INDEX(texturing.fog_lut_data[5]):
     case PICA_REG_INDEX(texturing.fog_lut_data[6]):
     case PICA_REG_INDEX(texturing.fog_lut_data[7]):
-        uniform_block_data.fog_lut_dirty = true;
+        uniform_block_data.dirty.set(FogLUT);
         break;
 
     // ProcTex state
@@ -946,19 +1106,19 @@ void RasterizerOpenGL::NotifyPicaRegisterChanged(u32 id) {
         using Pica::TexturingRegs;
         switch (regs.texturing.proctex_lut_config.ref_table.Value()) {
         case TexturingRegs::ProcTexLutTable::Noise:
-            uniform_block_data.proctex_noise_lut_dirty = true;
+            uniform_block_data.dirty.set(ProcTexNoiseLUT);
             break;
         case TexturingRegs::ProcTexLutTable::ColorMap:
-            uniform_block_data.proctex_color_map_dirty = true;
+            uniform_block_data.dirty.set(ProcTexColorMap);
             break;
         case TexturingRegs::ProcTexLutTable::AlphaMap:
-            uniform_block_data.proctex_alpha_map_dirty = true;
+            uniform_block_data.dirty.set(ProcTexAlphaMap);
             break;
         case TexturingRegs::ProcTexLutTable::Color:
-            uniform_block_data.proctex_lut_dirty = true;
+            uniform_block_data.dirty.set(ProcTexLUT);
             break;
         case TexturingRegs::ProcTexLutTable::ColorDiff:
-            uniform_block_data.proctex_diff_lut_dirty = true;
+            uniform_block_data.dirty.set(ProcTexDiffLUT);
             break;
         }
         break;
@@ -1329,6 +1489,23 @@ void RasterizerOpenGL::NotifyPicaRegisterChanged(u32 id) {
         SyncGlobalAmbient();
         break;
 
+    // Vertex shader uniforms, only used by the hardware shader path
+    case PICA_REG_INDEX(vs.bool_uniforms):
+    case PICA_REG_INDEX(vs.int_uniforms[0]):
+    case PICA_REG_INDEX(vs.int_uniforms[1]):
+    case PICA_REG_INDEX(vs.int_uniforms[2]):
+    case PICA_REG_INDEX(vs.int_uniforms[3]):
+    case PICA_REG_INDEX(vs.uniform_setup.set_value[0]):
+    case PICA_REG_INDEX(vs.uniform_setup.set_value[1]):
+    case PICA_REG_INDEX(vs.uniform_setup.set_value[2]):
+    case PICA_REG_INDEX(vs.uniform_setup.set_value[3]):
+    case PICA_REG_INDEX(vs.uniform_setup.set_value[4]):
+    case PICA_REG_INDEX(vs.uniform_setup.set_value[5]):
+    case PICA_REG_INDEX(vs.uniform_setup.set_value[6]):
+    case PICA_REG_INDEX(vs.uniform_setup.set_value[7]):
+        uniform_block_data.dirty.set(VSUniforms);
+        break;
+
     // Fragment lighting lookup tables
     case PICA_REG_INDEX(lighting.lut_data[0]):
     case PICA_REG_INDEX(lighting.lut_data[1]):
@@ -1339,8 +1516,7 @@ void RasterizerOpenGL::NotifyPicaRegisterChanged(u32 id) {
     case PICA_REG_INDEX(lighting.lut_data[6]):
     case PICA_REG_INDEX(lighting.lut_data[7]): {
         auto& lut_config = regs.lighting.lut_config;
-        uniform_block_data.lighting_lut_dirty[lut_config.type] = true;
-        uniform_block_data.lighting_lut_dirty_any = true;
+        uniform_block_data.dirty.set(LightingLUTs + lut_config.type);
         break;
     }
     }
@@ -1348,27 +1524,32 @@ void RasterizerOpenGL::NotifyPicaRegisterChanged(u32 id) {
 
 void RasterizerOpenGL::FlushAll() {
     MICROPROFILE_SCOPE(OpenGL_CacheManagement);
+    FlushPendingDraw();
     res_cache.FlushAll();
 }
 
 void RasterizerOpenGL::FlushRegion(PAddr addr, u32 size) {
     MICROPROFILE_SCOPE(OpenGL_CacheManagement);
+    FlushPendingDraw();
     res_cache.FlushRegion(addr, size);
 }
 
 void RasterizerOpenGL::InvalidateRegion(PAddr addr, u32 size) {
     MICROPROFILE_SCOPE(OpenGL_CacheManagement);
+    FlushPendingDraw();
     res_cache.InvalidateRegion(addr, size, nullptr);
 }
 
 void RasterizerOpenGL::FlushAndInvalidateRegion(PAddr addr, u32 size) {
     MICROPROFILE_SCOPE(OpenGL_CacheManagement);
+    FlushPendingDraw();
     res_cache.FlushRegion(addr, size);
     res_cache.InvalidateRegion(addr, size, nullptr);
 }
 
 bool RasterizerOpenGL::AccelerateDisplayTransfer(const GPU::Regs::DisplayTransferConfig& config) {
     MICROPROFILE_SCOPE(OpenGL_Blits);
+    FlushPendingDraw();
 
     SurfaceParams src_params;
     src_params.addr = config.GetPhysicalInputAddress();
@@ -1419,6 +1600,7 @@ bool RasterizerOpenGL::AccelerateDisplayTransfer(const GPU::Regs::DisplayTransfe
 }
 
 bool RasterizerOpenGL::AccelerateTextureCopy(const GPU::Regs::DisplayTransferConfig& config) {
+    FlushPendingDraw();
     u32 copy_size = Common::AlignDown(config.texture_copy.size, 16);
     if (copy_size == 0) {
         return false;
@@ -1504,6 +1686,7 @@ bool RasterizerOpenGL::AccelerateTextureCopy(const GPU::Regs::DisplayTransferCon
 }
 
 bool RasterizerOpenGL::AccelerateFill(const GPU::Regs::MemoryFillConfig& config) {
+    FlushPendingDraw();
     Surface dst_surface = res_cache.GetFillSurface(config);
     if (dst_surface == nullptr)
         return false;
@@ -1519,6 +1702,7 @@ bool RasterizerOpenGL::AccelerateDisplay(const GPU::Regs::FramebufferConfig& con
         return false;
     }
     MICROPROFILE_SCOPE(OpenGL_CacheManagement);
+    FlushPendingDraw();
 
     SurfaceParams src_params;
     src_params.addr = framebuffer_addr;
@@ -1639,7 +1823,7 @@ void RasterizerOpenGL::SyncClipCoef() {
                                   raw_clip_coef.z.ToFloat32(), raw_clip_coef.w.ToFloat32()};
     if (new_clip_coef != uniform_block_data.data.clip_coef) {
         uniform_block_data.data.clip_coef = new_clip_coef;
-        uniform_block_data.dirty = true;
+        uniform_block_data.dirty.set(FSUniforms);
     }
 }
 
@@ -1674,7 +1858,7 @@ void RasterizerOpenGL::SyncDepthScale() {
         Pica::float24::FromRaw(Pica::g_state.regs.rasterizer.viewport_depth_range).ToFloat32();
     if (depth_scale != uniform_block_data.data.depth_scale) {
         uniform_block_data.data.depth_scale = depth_scale;
-        uniform_block_data.dirty = true;
+        uniform_block_data.dirty.set(FSUniforms);
     }
 }
 
@@ -1683,7 +1867,7 @@ void RasterizerOpenGL::SyncDepthOffset() {
         Pica::float24::FromRaw(Pica::g_state.regs.rasterizer.viewport_depth_near_plane).ToFloat32();
     if (depth_offset != uniform_block_data.data.depth_offset) {
         uniform_block_data.data.depth_offset = depth_offset;
-        uniform_block_data.dirty = true;
+        uniform_block_data.dirty.set(FSUniforms);
     }
 }
 
@@ -1723,7 +1907,7 @@ void RasterizerOpenGL::SyncFogColor() {
         regs.texturing.fog_color.g.Value() / 255.0f,
         regs.texturing.fog_color.b.Value() / 255.0f,
     };
-    uniform_block_data.dirty = true;
+    uniform_block_data.dirty.set(FSUniforms);
 }
 
 void RasterizerOpenGL::SyncProcTexNoise() {
@@ -1741,7 +1925,7 @@ void RasterizerOpenGL::SyncProcTexNoise() {
         Pica::float16::FromRaw(regs.proctex_noise_v.phase).ToFloat32(),
     };
 
-    uniform_block_data.dirty = true;
+    uniform_block_data.dirty.set(FSUniforms);
 }
 
 void RasterizerOpenGL::SyncProcTexBias() {
@@ -1750,14 +1934,14 @@ void RasterizerOpenGL::SyncProcTexBias() {
         Pica::float16::FromRaw(regs.proctex.bias_low | (regs.proctex_lut.bias_high << 8))
             .ToFloat32();
 
-    uniform_block_data.dirty = true;
+    uniform_block_data.dirty.set(FSUniforms);
 }
 
 void RasterizerOpenGL::SyncAlphaTest() {
     const auto& regs = Pica::g_state.regs;
     if (regs.framebuffer.output_merger.alpha_test.ref != uniform_block_data.data.alphatest_ref) {
         uniform_block_data.data.alphatest_ref = regs.framebuffer.output_merger.alpha_test.ref;
-        uniform_block_data.dirty = true;
+        uniform_block_data.dirty.set(FSUniforms);
     }
 }
 
@@ -1829,7 +2013,7 @@ void RasterizerOpenGL::SyncCombinerColor() {
         PicaToGL::ColorRGBA8(Pica::g_state.regs.texturing.tev_combiner_buffer_color.raw);
     if (combiner_color != uniform_block_data.data.tev_combiner_buffer_color) {
         uniform_block_data.data.tev_combiner_buffer_color = combiner_color;
-        uniform_block_data.dirty = true;
+        uniform_block_data.dirty.set(FSUniforms);
     }
 }
 
@@ -1838,7 +2022,7 @@ void RasterizerOpenGL::SyncTevConstColor(int stage_index,
     auto const_color = PicaToGL::ColorRGBA8(tev_stage.const_color);
     if (const_color != uniform_block_data.data.const_color[stage_index]) {
         uniform_block_data.data.const_color[stage_index] = const_color;
-        uniform_block_data.dirty = true;
+        uniform_block_data.dirty.set(FSUniforms);
     }
 }
 
@@ -1846,7 +2030,7 @@ void RasterizerOpenGL::SyncGlobalAmbient() {
     auto color = PicaToGL::LightColor(Pica::g_state.regs.lighting.global_ambient);
     if (color != uniform_block_data.data.lighting_global_ambient) {
         uniform_block_data.data.lighting_global_ambient = color;
-        uniform_block_data.dirty = true;
+        uniform_block_data.dirty.set(FSUniforms);
     }
 }
 
@@ -1854,7 +2038,7 @@ void RasterizerOpenGL::SyncLightSpecular0(int light_index) {
     auto color = PicaToGL::LightColor(Pica::g_state.regs.lighting.light[light_index].specular_0);
     if (color != uniform_block_data.data.light_src[light_index].specular_0) {
         uniform_block_data.data.light_src[light_index].specular_0 = color;
-        uniform_block_data.dirty = true;
+        uniform_block_data.dirty.set(FSUniforms);
     }
 }
 
@@ -1862,7 +2046,7 @@ void RasterizerOpenGL::SyncLightSpecular1(int light_index) {
     auto color = PicaToGL::LightColor(Pica::g_state.regs.lighting.light[light_index].specular_1);
     if (color != uniform_block_data.data.light_src[light_index].specular_1) {
         uniform_block_data.data.light_src[light_index].specular_1 = color;
-        uniform_block_data.dirty = true;
+        uniform_block_data.dirty.set(FSUniforms);
     }
 }
 
@@ -1870,7 +2054,7 @@ void RasterizerOpenGL::SyncLightDiffuse(int light_index) {
     auto color = PicaToGL::LightColor(Pica::g_state.regs.lighting.light[light_index].diffuse);
     if (color != uniform_block_data.data.light_src[light_index].diffuse) {
         uniform_block_data.data.light_src[light_index].diffuse = color;
-        uniform_block_data.dirty = true;
+        uniform_block_data.dirty.set(FSUniforms);
     }
 }
 
@@ -1878,7 +2062,7 @@ void RasterizerOpenGL::SyncLightAmbient(int light_index) {
     auto color = PicaToGL::LightColor(Pica::g_state.regs.lighting.light[light_index].ambient);
     if (color != uniform_block_data.data.light_src[light_index].ambient) {
         uniform_block_data.data.light_src[light_index].ambient = color;
-        uniform_block_data.dirty = true;
+        uniform_block_data.dirty.set(FSUniforms);
     }
 }
 
@@ -1890,7 +2074,7 @@ void RasterizerOpenGL::SyncLightPosition(int light_index) {
 
     if (position != uniform_block_data.data.light_src[light_index].position) {
         uniform_block_data.data.light_src[light_index].position = position;
-        uniform_block_data.dirty = true;
+        uniform_block_data.dirty.set(FSUniforms);
     }
 }
 
@@ -1901,7 +2085,7 @@ void RasterizerOpenGL::SyncLightSpotDirection(int light_index) {
 
     if (spot_direction != uniform_block_data.data.light_src[light_index].spot_direction) {
         uniform_block_data.data.light_src[light_index].spot_direction = spot_direction;
-        uniform_block_data.dirty = true;
+        uniform_block_data.dirty.set(FSUniforms);
     }
 }
 
@@ -1912,7 +2096,7 @@ void RasterizerOpenGL::SyncLightDistanceAttenuationBias(int light_index) {
 
     if (dist_atten_bias != uniform_block_data.data.light_src[light_index].dist_atten_bias) {
         uniform_block_data.data.light_src[light_index].dist_atten_bias = dist_atten_bias;
-        uniform_block_data.dirty = true;
+        uniform_block_data.dirty.set(FSUniforms);
     }
 }
 
@@ -1923,7 +2107,7 @@ void RasterizerOpenGL::SyncLightDistanceAttenuationScale(int light_index) {
 
     if (dist_atten_scale != uniform_block_data.data.light_src[light_index].dist_atten_scale) {
         uniform_block_data.data.light_src[light_index].dist_atten_scale = dist_atten_scale;
-        uniform_block_data.dirty = true;
+        uniform_block_data.dirty.set(FSUniforms);
     }
 }
 
@@ -1936,7 +2120,7 @@ void RasterizerOpenGL::SyncShadowBias() {
         linear != uniform_block_data.data.shadow_bias_linear) {
         uniform_block_data.data.shadow_bias_constant = constant;
         uniform_block_data.data.shadow_bias_linear = linear;
-        uniform_block_data.dirty = true;
+        uniform_block_data.dirty.set(FSUniforms);
     }
 }
 
@@ -1944,7 +2128,7 @@ void RasterizerOpenGL::SyncShadowTextureBias() {
     GLint bias = Pica::g_state.regs.texturing.shadow.bias << 1;
     if (bias != uniform_block_data.data.shadow_texture_bias) {
         uniform_block_data.data.shadow_texture_bias = bias;
-        uniform_block_data.dirty = true;
+        uniform_block_data.dirty.set(FSUniforms);
     }
 }
 
@@ -1955,11 +2139,9 @@ void RasterizerOpenGL::SyncAndUploadLUTs() {
                                      sizeof(GLvec4) * 256 +     // proctex
                                      sizeof(GLvec4) * 256;      // proctex diff
 
-    if (!uniform_block_data.lighting_lut_dirty_any && !uniform_block_data.fog_lut_dirty &&
-        !uniform_block_data.proctex_noise_lut_dirty &&
-        !uniform_block_data.proctex_color_map_dirty &&
-        !uniform_block_data.proctex_alpha_map_dirty && !uniform_block_data.proctex_lut_dirty &&
-        !uniform_block_data.proctex_diff_lut_dirty) {
+    // Every dirty bit that precedes the uniform blocks belongs to a LUT
+    auto& dirty = uniform_block_data.dirty;
+    if ((dirty << (NumDirtyFlags - VSUniforms)).none()) {
         return;
     }
 
@@ -1971,33 +2153,29 @@ void RasterizerOpenGL::SyncAndUploadLUTs() {
     std::tie(buffer, offset, invalidate) = texture_buffer.Map(max_size, sizeof(GLvec4));
 
     // Sync the lighting luts
-    if (uniform_block_data.lighting_lut_dirty_any || invalidate) {
-        for (unsigned index = 0; index < uniform_block_data.lighting_lut_dirty.size(); index++) {
-            if (uniform_block_data.lighting_lut_dirty[index] || invalidate) {
-                std::array<GLvec2, 256> new_data;
-                const auto& source_lut = Pica::g_state.lighting.luts[index];
-                std::transform(source_lut.begin(), source_lut.end(), new_data.begin(),
-                               [](const auto& entry) {
-                                   return GLvec2{entry.ToFloat(), entry.DiffToFloat()};
-                               });
-
-                if (new_data != lighting_lut_data[index] || invalidate) {
-                    lighting_lut_data[index] = new_data;
-                    std::memcpy(buffer + bytes_used, new_data.data(),
-                                new_data.size() * sizeof(GLvec2));
-                    uniform_block_data.data.lighting_lut_offset[index / 4][index % 4] =
-                        (offset + bytes_used) / sizeof(GLvec2);
-                    uniform_block_data.dirty = true;
-                    bytes_used += new_data.size() * sizeof(GLvec2);
-                }
-                uniform_block_data.lighting_lut_dirty[index] = false;
+    for (unsigned index = 0; index < Pica::LightingRegs::NumLightingSampler; index++) {
+        if (dirty[LightingLUTs + index] || invalidate) {
+            std::array<GLvec2, 256> new_data;
+            const auto& source_lut = Pica::g_state.lighting.luts[index];
+            std::transform(source_lut.begin(), source_lut.end(), new_data.begin(),
+                           [](const auto& entry) {
+                               return GLvec2{entry.ToFloat(), entry.DiffToFloat()};
+                           });
+
+            if (new_data != lighting_lut_data[index] || invalidate) {
+                lighting_lut_data[index] = new_data;
+                std::memcpy(buffer + bytes_used, new_data.data(), new_data.size() * sizeof(GLvec2));
+                uniform_block_data.data.lighting_lut_offset[index / 4][index % 4] =
+                    (offset + bytes_used) / sizeof(GLvec2);
+                dirty.set(FSUniforms);
+                bytes_used += new_data.size() * sizeof(GLvec2);
             }
+            dirty.reset(LightingLUTs + index);
         }
     }
-    uniform_block_data.lighting_lut_dirty_any = false;
 
     // Sync the fog lut
-    if (uniform_block_data.fog_lut_dirty || invalidate) {
+    if (dirty[FogLUT] || invalidate) {
         std::array<GLvec2, 128> new_data;
 
         std::transform(Pica::g_state.fog.lut.begin(), Pica::g_state.fog.lut.end(), new_data.begin(),
@@ -2009,14 +2187,14 @@ void RasterizerOpenGL::SyncAndUploadLUTs() {
             fog_lut_data = new_data;
             std::memcpy(buffer + bytes_used, new_data.data(), new_data.size() * sizeof(GLvec2));
             uniform_block_data.data.fog_lut_offset = (offset + bytes_used) / sizeof(GLvec2);
-            uniform_block_data.dirty = true;
+            dirty.set(FSUniforms);
             bytes_used += new_data.size() * sizeof(GLvec2);
         }
-        uniform_block_data.fog_lut_dirty = false;
+        dirty.reset(FogLUT);
     }
 
     // helper function for SyncProcTexNoiseLUT/ColorMap/AlphaMap
-    auto SyncProcTexValueLUT = [this, buffer, offset, invalidate, &bytes_used](
+    auto SyncProcTexValueLUT = [buffer, offset, invalidate, &bytes_used, &dirty](
                                    const std::array<Pica::State::ProcTex::ValueEntry, 128>& lut,
                                    std::array<GLvec2, 128>& lut_data, GLint& lut_offset) {
         std::array<GLvec2, 128> new_data;
@@ -2028,34 +2206,34 @@ void RasterizerOpenGL::SyncAndUploadLUTs() {
             lut_data = new_data;
             std::memcpy(buffer + bytes_used, new_data.data(), new_data.size() * sizeof(GLvec2));
             lut_offset = (offset + bytes_used) / sizeof(GLvec2);
-            uniform_block_data.dirty = true;
+            dirty.set(FSUniforms);
             bytes_used += new_data.size() * sizeof(GLvec2);
         }
     };
 
     // Sync the proctex noise lut
-    if (uniform_block_data.proctex_noise_lut_dirty || invalidate) {
+    if (dirty[ProcTexNoiseLUT] || invalidate) {
         SyncProcTexValueLUT(Pica::g_state.proctex.noise_table, proctex_noise_lut_data,
                             uniform_block_data.data.proctex_noise_lut_offset);
-        uniform_block_data.proctex_noise_lut_dirty = false;
+        dirty.reset(ProcTexNoiseLUT);
     }
 
     // Sync the proctex color map
-    if (uniform_block_data.proctex_color_map_dirty || invalidate) {
+    if (dirty[ProcTexColorMap] || invalidate) {
         SyncProcTexValueLUT(Pica::g_state.proctex.color_map_table, proctex_color_map_data,
                             uniform_block_data.data.proctex_color_map_offset);
-        uniform_block_data.proctex_color_map_dirty = false;
+        dirty.reset(ProcTexColorMap);
     }
 
     // Sync the proctex alpha map
-    if (uniform_block_data.proctex_alpha_map_dirty || invalidate) {
+    if (dirty[ProcTexAlphaMap] || invalidate) {
         SyncProcTexValueLUT(Pica::g_state.proctex.alpha_map_table, proctex_alpha_map_data,
                             uniform_block_data.data.proctex_alpha_map_offset);
-        uniform_block_data.proctex_alpha_map_dirty = false;
+        dirty.reset(ProcTexAlphaMap);
     }
 
     // Sync the proctex lut
-    if (uniform_block_data.proctex_lut_dirty || invalidate) {
+    if (dirty[ProcTexLUT] || invalidate) {
         std::array<GLvec4, 256> new_data;
 
         std::transform(Pica::g_state.proctex.color_table.begin(),
@@ -2069,14 +2247,14 @@ void RasterizerOpenGL::SyncAndUploadLUTs() {
             proctex_lut_data = new_data;
             std::memcpy(buffer + bytes_used, new_data.data(), new_data.size() * sizeof(GLvec4));
             uniform_block_data.data.proctex_lut_offset = (offset + bytes_used) / sizeof(GLvec4);
-            uniform_block_data.dirty = true;
+            dirty.set(FSUniforms);
             bytes_used += new_data.size() * sizeof(GLvec4);
         }
-        uniform_block_data.proctex_lut_dirty = false;
+        dirty.reset(ProcTexLUT);
     }
 
     // Sync the proctex difference lut
-    if (uniform_block_data.proctex_diff_lut_dirty || invalidate) {
+    if (dirty[ProcTexDiffLUT] || invalidate) {
         std::array<GLvec4, 256> new_data;
 
         std::transform(Pica::g_state.proctex.color_diff_table.begin(),
@@ -2091,27 +2269,31 @@ void RasterizerOpenGL::SyncAndUploadLUTs() {
             std::memcpy(buffer + bytes_used, new_data.data(), new_data.size() * sizeof(GLvec4));
             uniform_block_data.data.proctex_diff_lut_offset =
                 (offset + bytes_used) / sizeof(GLvec4);
-            uniform_block_data.dirty = true;
+            dirty.set(FSUniforms);
             bytes_used += new_data.size() * sizeof(GLvec4);
         }
-        uniform_block_data.proctex_diff_lut_dirty = false;
+        dirty.reset(ProcTexDiffLUT);
     }
 
     texture_buffer.Unmap(bytes_used);
 }
 
 void RasterizerOpenGL::UploadUniforms(bool accelerate_draw) {
-    // glBindBufferRange below also changes the generic buffer binding point, so we sync the state
-    // first
-    state.draw.uniform_buffer = uniform_buffer.GetHandle();
-    state.Apply();
+    auto& dirty = uniform_block_data.dirty;
 
-    bool sync_vs = accelerate_draw;
-    bool sync_fs = uniform_block_data.dirty;
+    // The vertex shader uniforms are only read by the hardware shader path, so they can stay
+    // dirty until the next accelerated draw
+    bool sync_vs = accelerate_draw && dirty[VSUniforms];
+    bool sync_fs = dirty[FSUniforms];
 
     if (!sync_vs && !sync_fs)
         return;
 
+    // glBindBufferRange below also changes the generic buffer binding point, so we sync the state
+    // first
+    state.draw.uniform_buffer = uniform_buffer.GetHandle();
+    state.Apply();
+
     std::size_t uniform_size = uniform_size_aligned_vs + uniform_size_aligned_fs;
     std::size_t used_bytes = 0;
     u8* uniforms;
@@ -2120,20 +2302,30 @@ void RasterizerOpenGL::UploadUniforms(bool accelerate_draw) {
     std::tie(uniforms, offset, invalidate) =
         uniform_buffer.Map(uniform_size, uniform_buffer_alignment);
 
+    if (invalidate) {
+        // The ranges bound by previous draws are gone along with the old buffer contents
+        sync_vs = accelerate_draw;
+        sync_fs = true;
+        if (!accelerate_draw) {
+            dirty.set(VSUniforms);
+        }
+    }
+
     if (sync_vs) {
         VSUniformData vs_uniforms;
         vs_uniforms.uniforms.SetFromRegs(Pica::g_state.regs.vs, Pica::g_state.vs);
         std::memcpy(uniforms + used_bytes, &vs_uniforms, sizeof(vs_uniforms));
         glBindBufferRange(GL_UNIFORM_BUFFER, static_cast<GLuint>(UniformBindings::VS),
                           uniform_buffer.GetHandle(), offset + used_bytes, sizeof(VSUniformData));
+        dirty.reset(VSUniforms);
         used_bytes += uniform_size_aligned_vs;
     }
 
-    if (sync_fs || invalidate) {
+    if (sync_fs) {
         std::memcpy(uniforms + used_bytes, &uniform_block_data.data, sizeof(UniformData));
         glBindBufferRange(GL_UNIFORM_BUFFER, static_cast<GLuint>(UniformBindings::Common),
                           uniform_buffer.GetHandle(), offset + used_bytes, sizeof(UniformData));
-        uniform_block_data.dirty = false;
+        dirty.reset(FSUniforms);
         used_bytes += uniform_size_aligned_fs;
     }
 
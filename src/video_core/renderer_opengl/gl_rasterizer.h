@@ -5,8 +5,10 @@
 #pragma once
 
 #include <array>
+#include <bitset>
 #include <cstddef>
 #include <cstring>
+#include <deque>
 #include <memory>
 #include <vector>
 #include <glad/glad.h>
@@ -44,10 +46,14 @@ public:
 
     void LoadDiskResources(const std::atomic_bool& stop_loading,
                            const VideoCore::DiskResourceLoadCallback& callback) override;
+    bool SetDrawTimingEnabled(bool enabled) override;
+    VideoCore::DrawTimeStats GetDrawTimeStats() override;
 
     void AddTriangle(const Pica::Shader::OutputVertex& v0, const Pica::Shader::OutputVertex& v1,
                      const Pica::Shader::OutputVertex& v2) override;
     void DrawTriangles() override;
+    void NotifyPicaRegisterWrite(u32 id, u32 value) override;
+    void NotifyCommandListEnd() override;
     void NotifyPicaRegisterChanged(u32 id) override;
     void FlushAll() override;
     void FlushRegion(PAddr addr, u32 size) override;
@@ -239,6 +245,21 @@ private:
     /// Generic draw function for DrawTriangles and AccelerateDrawBatch
     bool Draw(bool accelerate, bool is_indexed);
 
+    /// Checks whether the current vertex batch may stay queued to be merged with later draws
+    bool CanDeferDraw() const;
+
+    /// Submits the queued vertex batch, if any
+    void FlushPendingDraw();
+
+    /// Starts measuring the GPU time of the following host draw call, if draw timing is enabled
+    void BeginDrawTiming();
+
+    /// Stops measuring the GPU time started by BeginDrawTiming
+    void EndDrawTiming();
+
+    /// Adds the results of the finished draw timing queries to draw_time_stats
+    void CollectDrawTimings(bool wait);
+
     /// Internal implementation for AccelerateDrawBatch
     bool AccelerateDrawBatchInternal(bool is_indexed);
 
@@ -271,20 +292,34 @@ private:
     Frontend::EmuWindow& emu_window;
 
     std::vector<HardwareVertex> vertex_batch;
+    /// Whether vertex_batch holds triangles of finished draws that have not been submitted yet
+    bool draw_pending = false;
+
+    bool draw_timing_enabled = false;
+    /// GL_TIME_ELAPSED queries of the submitted draws, oldest first
+    std::deque<OGLQuery> pending_draw_queries;
+    std::vector<OGLQuery> free_draw_queries;
+    VideoCore::DrawTimeStats draw_time_stats;
 
     bool shader_dirty;
 
+    /// Data uploaded to the texture and uniform buffers, each group is tracked by its own dirty bit
+    enum DirtyFlags : std::size_t {
+        LightingLUTs,
+        FogLUT = LightingLUTs + Pica::LightingRegs::NumLightingSampler,
+        ProcTexNoiseLUT,
+        ProcTexColorMap,
+        ProcTexAlphaMap,
+        ProcTexLUT,
+        ProcTexDiffLUT,
+        VSUniforms,
+        FSUniforms,
+        NumDirtyFlags,
+    };
+
     struct {
         UniformData data;
-        std::array<bool, Pica::LightingRegs::NumLightingSampler> lighting_lut_dirty;
-        bool lighting_lut_dirty_any;
-        bool fog_lut_dirty;
-        bool proctex_noise_lut_dirty;
-        bool proctex_color_map_dirty;
-        bool proctex_alpha_map_dirty;
-        bool proctex_lut_dirty;
-        bool proctex_diff_lut_dirty;
-        bool dirty;
+        std::bitset<NumDirtyFlags> dirty;
     } uniform_block_data = {};
 
     std::unique_ptr<ShaderProgramManager> shader_program_manager;
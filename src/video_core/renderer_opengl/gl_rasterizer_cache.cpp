@@ -612,6 +612,21 @@ bool SurfaceParams::CanTexCopy(const SurfaceParams& texcopy_params) const {
     return FromInterval(texcopy_params.GetInterval()).GetInterval() == texcopy_params.GetInterval();
 }
 
+CachedSurface::~CachedSurface() {
+    if (texture.handle != 0) {
+        owner.RecycleHostTexture(std::move(texture), GetHostTextureTag());
+    }
+}
+
+HostTextureTag CachedSurface::GetHostTextureTag() const {
+    // Custom textures replace the surface texture only when the surface is not upscaled
+    if (is_custom && res_scale == 1) {
+        return {GetFormatTuple(PixelFormat::RGBA8).internal_format, custom_tex_info.width,
+                custom_tex_info.height};
+    }
+    return {GetFormatTuple(pixel_format).internal_format, GetScaledWidth(), GetScaledHeight()};
+}
+
 bool CachedSurface::CanFill(const SurfaceParams& dest_surface,
                             SurfaceInterval fill_interval) const {
     if (type == SurfaceType::Fill && IsRegionValid(fill_interval) &&
@@ -951,6 +966,8 @@ void CachedSurface::UploadGLTexture(const Common::Rectangle<u32>& rect, GLuint r
     u64 tex_hash = 0;
     // Required for rect to function properly with custom textures
     Common::Rectangle custom_rect = rect;
+    // Describes the current texture storage, in case a custom texture has to replace it
+    const HostTextureTag old_tag = GetHostTextureTag();
 
     if (Settings::values.dump_textures || Settings::values.custom_textures)
         tex_hash = Common::ComputeHash64(gl_buffer.get(), gl_buffer_size);
@@ -969,18 +986,16 @@ void CachedSurface::UploadGLTexture(const Common::Rectangle<u32>& rect, GLuint r
     // If not 1x scale, create 1x texture that we will blit from to replace texture subrect in
     // surface
     OGLTexture unscaled_tex;
+    HostTextureTag unscaled_tag{};
     if (res_scale != 1) {
         x0 = 0;
         y0 = 0;
 
-        unscaled_tex.Create();
-        if (is_custom) {
-            AllocateSurfaceTexture(unscaled_tex.handle, GetFormatTuple(PixelFormat::RGBA8),
-                                   custom_tex_info.width, custom_tex_info.height);
-        } else {
-            AllocateSurfaceTexture(unscaled_tex.handle, tuple, custom_rect.GetWidth(),
-                                   custom_rect.GetHeight());
-        }
+        const FormatTuple& unscaled_tuple = is_custom ? GetFormatTuple(PixelFormat::RGBA8) : tuple;
+        const u32 unscaled_width = is_custom ? custom_tex_info.width : custom_rect.GetWidth();
+        const u32 unscaled_height = is_custom ? custom_tex_info.height : custom_rect.GetHeight();
+        unscaled_tex = owner.AllocateHostTexture(unscaled_tuple, unscaled_width, unscaled_height);
+        unscaled_tag = {unscaled_tuple.internal_format, unscaled_width, unscaled_height};
         target_tex = unscaled_tex.handle;
     }
 
@@ -994,8 +1009,10 @@ void CachedSurface::UploadGLTexture(const Common::Rectangle<u32>& rect, GLuint r
     ASSERT(stride * GetGLBytesPerPixel(pixel_format) % 4 == 0);
     if (is_custom) {
         if (res_scale == 1) {
-            AllocateSurfaceTexture(texture.handle, GetFormatTuple(PixelFormat::RGBA8),
-                                   custom_tex_info.width, custom_tex_info.height);
+            owner.RecycleHostTexture(std::move(texture), old_tag);
+            texture = owner.AllocateHostTexture(GetFormatTuple(PixelFormat::RGBA8),
+                                                custom_tex_info.width, custom_tex_info.height);
+            max_level = 0;
             cur_state.texture_units[0].texture_2d = texture.handle;
             cur_state.Apply();
         }
@@ -1030,6 +1047,7 @@ void CachedSurface::UploadGLTexture(const Common::Rectangle<u32>& rect, GLuint r
 
         BlitTextures(unscaled_tex.handle, {0, custom_rect.GetHeight(), custom_rect.GetWidth(), 0},
                      texture.handle, scaled_rect, type, read_fb_handle, draw_fb_handle);
+        owner.RecycleHostTexture(std::move(unscaled_tex), unscaled_tag);
     }
 
     InvalidateAllWatcher();
@@ -1068,11 +1086,14 @@ void CachedSurface::DownloadGLTexture(const Common::Rectangle<u32>& rect, GLuint
         scaled_rect.right *= res_scale;
         scaled_rect.bottom *= res_scale;
 
-        OGLTexture unscaled_tex;
-        unscaled_tex.Create();
+        OGLTexture unscaled_tex =
+            owner.AllocateHostTexture(tuple, rect.GetWidth(), rect.GetHeight());
+        SCOPE_EXIT({
+            owner.RecycleHostTexture(std::move(unscaled_tex),
+                                     {tuple.internal_format, rect.GetWidth(), rect.GetHeight()});
+        });
 
         Common::Rectangle<u32> unscaled_tex_rect{0, rect.GetHeight(), rect.GetWidth(), 0};
-        AllocateSurfaceTexture(unscaled_tex.handle, tuple, rect.GetWidth(), rect.GetHeight());
         BlitTextures(texture.handle, scaled_rect, unscaled_tex.handle, unscaled_tex_rect, type,
                      read_fb_handle, draw_fb_handle);
 
@@ -1543,9 +1564,18 @@ Surface RasterizerCacheOpenGL::GetTextureSurface(const Pica::Texture::TextureInf
                 width = surface->width * surface->res_scale;
                 height = surface->height * surface->res_scale;
             }
-            for (u32 level = surface->max_level + 1; level <= max_level; ++level) {
-                glTexImage2D(GL_TEXTURE_2D, level, format_tuple.internal_format, width >> level,
-                             height >> level, 0, format_tuple.format, format_tuple.type, nullptr);
+            // Textures with immutable storage already have every mipmap level allocated. Immutable
+            // storage is only used when it is supported, see AllocateHostTexture.
+            GLint immutable = GL_FALSE;
+            if (GLES || GLAD_GL_ARB_texture_storage) {
+                glGetTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_IMMUTABLE_FORMAT, &immutable);
+            }
+            if (immutable == GL_FALSE) {
+                for (u32 level = surface->max_level + 1; level <= max_level; ++level) {
+                    glTexImage2D(GL_TEXTURE_2D, level, format_tuple.internal_format,
+                                 width >> level, height >> level, 0, format_tuple.format,
+                                 format_tuple.type, nullptr);
+                }
             }
             if (surface->is_custom) {
                 // TODO: proper mipmap support for custom textures
@@ -1800,7 +1830,7 @@ SurfaceSurfaceRect_Tuple RasterizerCacheOpenGL::GetFramebufferSurfaces(
 }
 
 Surface RasterizerCacheOpenGL::GetFillSurface(const GPU::Regs::MemoryFillConfig& config) {
-    Surface new_surface = std::make_shared<CachedSurface>();
+    Surface new_surface = std::make_shared<CachedSurface>(*this);
 
     new_surface->addr = config.GetStartAddress();
     new_surface->end = config.GetEndAddress();
@@ -2027,20 +2057,108 @@ void RasterizerCacheOpenGL::InvalidateRegion(PAddr addr, u32 size, const Surface
     remove_surfaces.clear();
 }
 
+/// Upper bound of the video memory kept by the texture recycler
+constexpr std::size_t MaxRecycledTextureBytes = 256 * 1024 * 1024;
+
+/// Estimates the video memory of a recycled texture, assuming 4 bytes per pixel and a full mipmap
+/// chain, which is an upper bound for every format the cache allocates
+static std::size_t GetRecycledTextureSize(const HostTextureTag& tag) {
+    const std::size_t base_size = static_cast<std::size_t>(tag.width) * tag.height * 4;
+    return base_size + base_size / 3;
+}
+
 Surface RasterizerCacheOpenGL::CreateSurface(const SurfaceParams& params) {
-    Surface surface = std::make_shared<CachedSurface>();
+    Surface surface = std::make_shared<CachedSurface>(*this);
     static_cast<SurfaceParams&>(*surface) = params;
 
-    surface->texture.Create();
+    surface->texture = AllocateHostTexture(GetFormatTuple(surface->pixel_format),
+                                           surface->GetScaledWidth(), surface->GetScaledHeight());
 
     surface->gl_buffer_size = 0;
     surface->invalid_regions.insert(surface->GetInterval());
-    AllocateSurfaceTexture(surface->texture.handle, GetFormatTuple(surface->pixel_format),
-                           surface->GetScaledWidth(), surface->GetScaledHeight());
 
     return surface;
 }
 
+OGLTexture RasterizerCacheOpenGL::AllocateHostTexture(const FormatTuple& format_tuple, u32 width,
+                                                      u32 height) {
+    const HostTextureTag tag{format_tuple.internal_format, width, height};
+    const auto recycled_tex = recycled_texture_index.find(tag);
+    if (recycled_tex != recycled_texture_index.end()) {
+        OGLTexture texture = std::move(recycled_tex->second->texture);
+        host_texture_recycler.erase(recycled_tex->second);
+        recycled_texture_index.erase(recycled_tex);
+        recycled_texture_bytes -= GetRecycledTextureSize(tag);
+
+        // The previous owner may have attached mipmap levels, the new one starts without any
+        OpenGLState cur_state = OpenGLState::GetCurState();
+        GLuint old_tex = cur_state.texture_units[0].texture_2d;
+        cur_state.texture_units[0].texture_2d = texture.handle;
+        cur_state.Apply();
+        glActiveTexture(GL_TEXTURE0);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+        cur_state.texture_units[0].texture_2d = old_tex;
+        cur_state.Apply();
+
+        return texture;
+    }
+
+    OGLTexture texture;
+    texture.Create();
+
+    if (!GLES && !GLAD_GL_ARB_texture_storage) {
+        AllocateSurfaceTexture(texture.handle, format_tuple, width, height);
+        return texture;
+    }
+
+    OpenGLState cur_state = OpenGLState::GetCurState();
+
+    // Keep track of previous texture bindings
+    GLuint old_tex = cur_state.texture_units[0].texture_2d;
+    cur_state.texture_units[0].texture_2d = texture.handle;
+    cur_state.Apply();
+    glActiveTexture(GL_TEXTURE0);
+
+    // Immutable storage can't be resized later, so reserve the whole mipmap chain up front
+    GLsizei levels = 1;
+    while ((std::max(width, height) >> levels) != 0) {
+        ++levels;
+    }
+    glTexStorage2D(GL_TEXTURE_2D, levels, format_tuple.internal_format, width, height);
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+    // Restore previous texture bindings
+    cur_state.texture_units[0].texture_2d = old_tex;
+    cur_state.Apply();
+
+    return texture;
+}
+
+void RasterizerCacheOpenGL::RecycleHostTexture(OGLTexture&& texture, const HostTextureTag& tag) {
+    if (texture.handle == 0) {
+        return;
+    }
+    host_texture_recycler.push_front({tag, std::move(texture)});
+    recycled_texture_index.emplace(tag, host_texture_recycler.begin());
+    recycled_texture_bytes += GetRecycledTextureSize(tag);
+
+    // Evict the least recently recycled textures once the pool grows too large
+    while (recycled_texture_bytes > MaxRecycledTextureBytes) {
+        const auto oldest = std::prev(host_texture_recycler.end());
+        const auto [begin, end] = recycled_texture_index.equal_range(oldest->tag);
+        const auto index_entry = std::find_if(
+            begin, end, [oldest](const auto& entry) { return entry.second == oldest; });
+        ASSERT(index_entry != end);
+        recycled_texture_index.erase(index_entry);
+        recycled_texture_bytes -= GetRecycledTextureSize(oldest->tag);
+        host_texture_recycler.pop_back();
+    }
+}
+
 void RasterizerCacheOpenGL::RegisterSurface(const Surface& surface) {
     if (surface->registered) {
         return;
@@ -54,6 +54,24 @@ struct TextureCubeConfig {
     }
 };
 
+struct FormatTuple {
+    GLint internal_format;
+    GLenum format;
+    GLenum type;
+};
+
+/// Describes the host texture storage that a recycled texture can be reused for
+struct HostTextureTag {
+    GLint internal_format;
+    u32 width;
+    u32 height;
+
+    bool operator==(const HostTextureTag& rhs) const {
+        return std::tie(internal_format, width, height) ==
+               std::tie(rhs.internal_format, rhs.width, rhs.height);
+    }
+};
+
 } // namespace OpenGL
 
 namespace std {
@@ -72,10 +90,22 @@ struct hash<OpenGL::TextureCubeConfig> {
         return hash;
     }
 };
+
+template <>
+struct hash<OpenGL::HostTextureTag> {
+    std::size_t operator()(const OpenGL::HostTextureTag& tag) const {
+        std::size_t hash = 0;
+        boost::hash_combine(hash, tag.internal_format);
+        boost::hash_combine(hash, tag.width);
+        boost::hash_combine(hash, tag.height);
+        return hash;
+    }
+};
 } // namespace std
 
 namespace OpenGL {
 
+class RasterizerCacheOpenGL;
 struct CachedSurface;
 using Surface = std::shared_ptr<CachedSurface>;
 using SurfaceSet = std::set<Surface>;
@@ -345,6 +375,9 @@ private:
 };
 
 struct CachedSurface : SurfaceParams, std::enable_shared_from_this<CachedSurface> {
+    explicit CachedSurface(RasterizerCacheOpenGL& owner) : owner(owner) {}
+    ~CachedSurface();
+
     bool CanFill(const SurfaceParams& dest_surface, SurfaceInterval fill_interval) const;
     bool CanCopy(const SurfaceParams& dest_surface, SurfaceInterval copy_interval) const;
 
@@ -374,6 +407,9 @@ struct CachedSurface : SurfaceParams, std::enable_shared_from_this<CachedSurface
     bool is_filtered = false;
     Core::CustomTexInfo custom_tex_info;
 
+    /// Returns the tag describing the storage currently backing this surface's texture
+    HostTextureTag GetHostTextureTag() const;
+
     static constexpr unsigned int GetGLBytesPerPixel(PixelFormat format) {
         // OpenGL needs 4 bpp alignment for D24 since using GL_UNSIGNED_INT as type
         return format == PixelFormat::Invalid
@@ -426,6 +462,7 @@ struct CachedSurface : SurfaceParams, std::enable_shared_from_this<CachedSurface
     }
 
 private:
+    RasterizerCacheOpenGL& owner;
     std::list<std::weak_ptr<SurfaceWatcher>> watchers;
 };
 
@@ -491,6 +528,12 @@ public:
     /// Flush all cached resources tracked by this cache manager
     void FlushAll();
 
+    /// Get a texture with the given format and size, reusing a recycled one when possible
+    OGLTexture AllocateHostTexture(const FormatTuple& format_tuple, u32 width, u32 height);
+
+    /// Return a texture to the recycler so that a later allocation of the same kind can reuse it
+    void RecycleHostTexture(OGLTexture&& texture, const HostTextureTag& tag);
+
 private:
     void DuplicateSurface(const Surface& src_surface, const Surface& dest_surface);
 
@@ -509,6 +552,21 @@ private:
     /// Increase/decrease the number of surface in pages touching the specified region
     void UpdatePagesCachedCount(PAddr addr, u32 size, int delta);
 
+    struct RecycledTexture {
+        HostTextureTag tag;
+        OGLTexture texture;
+    };
+    using RecycledTextureList = std::list<RecycledTexture>;
+
+    /// Textures of destroyed surfaces, kept alive to avoid reallocating storage for new surfaces.
+    /// Ordered from the most to the least recently recycled, so that the oldest are evicted first.
+    /// Declared first so that it outlives every member that may still hold surfaces.
+    RecycledTextureList host_texture_recycler;
+    /// Index of host_texture_recycler by format and size
+    std::unordered_multimap<HostTextureTag, RecycledTextureList::iterator> recycled_texture_index;
+    /// Estimated video memory held by host_texture_recycler
+    std::size_t recycled_texture_bytes = 0;
+
     SurfaceCache surface_cache;
     PageMap cached_pages;
     SurfaceMap dirty_regions;
@@ -527,12 +585,6 @@ private:
     std::unordered_map<TextureCubeConfig, CachedTextureCube> texture_cube_cache;
 };
 
-struct FormatTuple {
-    GLint internal_format;
-    GLenum format;
-    GLenum type;
-};
-
 constexpr FormatTuple tex_tuple = {GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE};
 
 const FormatTuple& GetFormatTuple(SurfaceParams::PixelFormat pixel_format);
@@ -225,6 +225,10 @@ public:
         if (new_shader) {
             result = CodeGenerator(config, separable);
             cached_shader.Create(result->code.c_str(), ShaderType);
+            ++VideoCore::g_shader_cache_misses;
+            ++VideoCore::g_shaders_compiled;
+        } else {
+            ++VideoCore::g_shader_cache_hits;
         }
         return {cached_shader.GetHandle(), result};
     }
@@ -257,6 +261,7 @@ public:
         std::optional<ShaderDecompiler::ProgramResult> result{};
         auto map_it = shader_map.find(key);
         if (map_it == shader_map.end()) {
+            ++VideoCore::g_shader_cache_misses;
             auto program_opt = CodeGenerator(setup, key, separable);
             if (!program_opt) {
                 shader_map[key] = nullptr;
@@ -269,11 +274,13 @@ public:
             if (new_shader) {
                 result->code = program;
                 cached_shader.Create(program.c_str(), ShaderType);
+                ++VideoCore::g_shaders_compiled;
             }
             shader_map[key] = &cached_shader;
             return {cached_shader.GetHandle(), result};
         }
 
+        ++VideoCore::g_shader_cache_hits;
         if (map_it->second == nullptr) {
             return {0, {}};
         }
@@ -365,12 +365,23 @@ void RendererOpenGL::SwapBuffers() {
     OpenGLState prev_state = OpenGLState::GetCurState();
     state.Apply();
 
-    PrepareRendertarget();
+    // In turbo mode only every Nth frame is presented, unless the frame is needed otherwise
+    const u16 present_interval = std::max<u16>(Settings::values.turbo_present_interval, 1);
+    const bool present_frame =
+        !Settings::values.use_turbo_mode || m_current_frame % present_interval == 0;
+    const bool frame_needed = present_frame || VideoCore::g_renderer_screenshot_requested ||
+                              frame_dumper.IsDumping();
+
+    if (frame_needed) {
+        PrepareRendertarget();
+    }
 
     RenderScreenshot();
 
-    const auto& layout = render_window.GetFramebufferLayout();
-    RenderToMailbox(layout, render_window.mailbox, false);
+    if (present_frame) {
+        const auto& layout = render_window.GetFramebufferLayout();
+        RenderToMailbox(layout, render_window.mailbox, false);
+    }
 
     if (frame_dumper.IsDumping()) {
         RenderToMailbox(frame_dumper.GetLayout(), frame_dumper.mailbox, true);
@@ -26,6 +26,9 @@ std::atomic<bool> g_use_disk_shader_cache;
 std::atomic<bool> g_renderer_bg_color_update_requested;
 std::atomic<bool> g_renderer_sampler_update_requested;
 std::atomic<bool> g_renderer_shader_update_requested;
+std::atomic<u32> g_shader_cache_hits;
+std::atomic<u32> g_shader_cache_misses;
+std::atomic<u32> g_shaders_compiled;
 // Screenshot
 std::atomic<bool> g_renderer_screenshot_requested;
 void* g_screenshot_bits;
@@ -35,6 +35,10 @@ extern std::atomic<bool> g_use_disk_shader_cache;
 extern std::atomic<bool> g_renderer_bg_color_update_requested;
 extern std::atomic<bool> g_renderer_sampler_update_requested;
 extern std::atomic<bool> g_renderer_shader_update_requested;
+// Shader cache statistics, counted since the emulator started
+extern std::atomic<u32> g_shader_cache_hits;
+extern std::atomic<u32> g_shader_cache_misses;
+extern std::atomic<u32> g_shaders_compiled;
 // Screenshot
 extern std::atomic<bool> g_renderer_screenshot_requested;
 extern void* g_screenshot_bits;
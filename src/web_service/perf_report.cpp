@@ -0,0 +1,17 @@
+// Copyright 2020 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include "common/web_result.h"
+#include "web_service/perf_report.h"
+#include "web_service/web_backend.h"
+
+namespace WebService {
+
+bool SubmitPerfReport(const std::string& host, const std::string& report) {
+    Client client(host, "", "");
+    const auto result = client.PostBinary("/telemetry/performance", report, true);
+    return result.result_code == Common::WebResult::Code::Success;
+}
+
+} // namespace WebService
@@ -0,0 +1,19 @@
+// Copyright 2020 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <string>
+
+namespace WebService {
+
+/**
+ * Uploads a compressed performance report.
+ * @param host the URL of the performance report server
+ * @param report the compressed report, as written by Core::PerfReporter
+ * @returns a bool indicating whether the server accepted the report
+ */
+bool SubmitPerfReport(const std::string& host, const std::string& report);
+
+} // namespace WebService
@@ -38,7 +38,8 @@ struct Client::Impl {
     /// A generic function handles POST, GET and DELETE request together
     Common::WebResult GenericRequest(const std::string& method, const std::string& path,
                                      const std::string& data, bool allow_anonymous,
-                                     const std::string& accept) {
+                                     const std::string& accept,
+                                     const std::string& request_content_type = "application/json") {
         if (jwt.empty()) {
             UpdateJWT();
         }
@@ -49,11 +50,11 @@ struct Client::Impl {
                                      "Credentials needed"};
         }
 
-        auto result = GenericRequest(method, path, data, accept, jwt);
+        auto result = GenericRequest(method, path, data, accept, jwt, "", "", request_content_type);
         if (result.result_string == "401") {
             // Try again with new JWT
             UpdateJWT();
-            result = GenericRequest(method, path, data, accept, jwt);
+            result = GenericRequest(method, path, data, accept, jwt, "", "", request_content_type);
         }
 
         return result;
@@ -68,7 +69,8 @@ struct Client::Impl {
     Common::WebResult GenericRequest(const std::string& method, const std::string& path,
                                      const std::string& data, const std::string& accept,
                                      const std::string& jwt = "", const std::string& username = "",
-                                     const std::string& token = "") {
+                                     const std::string& token = "",
+                                     const std::string& request_content_type = "application/json") {
         if (cli == nullptr) {
             auto parsedUrl = LUrlParser::clParseURL::ParseURL(host);
             int port;
@@ -109,7 +111,7 @@ struct Client::Impl {
         params.emplace(std::string("api-version"),
                        std::string(API_VERSION.begin(), API_VERSION.end()));
         if (method != "GET") {
-            params.emplace(std::string("Content-Type"), std::string("application/json"));
+            params.emplace(std::string("Content-Type"), request_content_type);
         };
 
         httplib::Request request;
@@ -189,6 +191,12 @@ Common::WebResult Client::PostJson(const std::string& path, const std::string& d
     return impl->GenericRequest("POST", path, data, allow_anonymous, "application/json");
 }
 
+Common::WebResult Client::PostBinary(const std::string& path, const std::string& data,
+                                     bool allow_anonymous) {
+    return impl->GenericRequest("POST", path, data, allow_anonymous, "application/json",
+                                "application/octet-stream");
+}
+
 Common::WebResult Client::GetJson(const std::string& path, bool allow_anonymous) {
     return impl->GenericRequest("GET", path, "", allow_anonymous, "application/json");
 }
@@ -28,6 +28,16 @@ public:
     Common::WebResult PostJson(const std::string& path, const std::string& data,
                                bool allow_anonymous);
 
+    /**
+     * Posts binary data to the specified path, expecting a JSON reply.
+     * @param path the URL segment after the host address.
+     * @param data Binary data to use for the body of the POST request.
+     * @param allow_anonymous If true, allow anonymous unauthenticated requests.
+     * @return the result of the request.
+     */
+    Common::WebResult PostBinary(const std::string& path, const std::string& data,
+                                 bool allow_anonymous);
+
     /**
      * Gets JSON from the specified path.
      * @param path the URL segment after the host address.